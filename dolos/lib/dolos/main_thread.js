@@ -0,0 +1,16 @@
+'use strict';
+
+const binding = internalBinding('dolos_main_thread');
+
+/**
+ * Wait for the game's main thread without blocking this one.
+ * Resolves once the main thread has run its queue up to this call, at its next game lock window.
+ * @returns {Promise<void>} - Rejects if the main thread queue is full
+ */
+function yieldToMainThread() {
+  return binding.yieldToMainThread();
+}
+
+module.exports = {
+  yieldToMainThread,
+};
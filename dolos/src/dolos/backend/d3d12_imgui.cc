@@ -23,7 +23,8 @@ D3D12ImGui::D3D12ImGui() noexcept
       hFontSrvGpuDescHandle{},
       pFrameResources(nullptr),
       numFramesInFlight(0),
-      frameIndex(UINT_MAX) {}
+      frameIndex{},
+      uploadedFrameId{} {}
 
 D3D12ImGui::~D3D12ImGui() noexcept {}
 
@@ -46,14 +47,17 @@ bool D3D12ImGui::Initialize(ID3D12Device* device,
   RTVFormat = rtv_format;
   hFontSrvCpuDescHandle = font_srv_cpu_desc_handle;
   hFontSrvGpuDescHandle = font_srv_gpu_desc_handle;
-  pFrameResources = new RenderBuffers[num_frames_in_flight];
+  pFrameResources = new RenderBuffers[num_frames_in_flight * kMaxStreams];
   numFramesInFlight = num_frames_in_flight;
-  frameIndex = UINT_MAX;
+  for (int i = 0; i < kMaxStreams; i++) {
+    frameIndex[i] = UINT_MAX;
+    uploadedFrameId[i] = 0;
+  }
   IM_UNUSED(cbv_srv_heap);  // Unused in master branch (will be used by
                             // multi-viewports)
 
   // Create buffers with a default size (they will later be grown as needed)
-  for (int i = 0; i < num_frames_in_flight; i++) {
+  for (int i = 0; i < num_frames_in_flight * kMaxStreams; i++) {
     RenderBuffers* fr = &pFrameResources[i];
     fr->IndexBuffer = NULL;
     fr->VertexBuffer = NULL;
@@ -81,14 +85,31 @@ void D3D12ImGui::NewFrame() {
 }
 
 void D3D12ImGui::RenderDrawData(ImDrawData* draw_data,
-                                ID3D12GraphicsCommandList* graphics_command_list) {  // Avoid rendering when minimized
+                                ID3D12GraphicsCommandList* graphics_command_list,
+                                int stream,
+                                uint64_t frame_id) {
+  // Avoid rendering when minimized
   if (draw_data->DisplaySize.x <= 0.0f || draw_data->DisplaySize.y <= 0.0f) return;
+  if (stream < 0 || stream >= kMaxStreams) return;
+
+  RenderBuffers* frames = &pFrameResources[stream * numFramesInFlight];
+  if (frame_id != 0 && frame_id == uploadedFrameId[stream]) {
+    // Same content as the last upload, which is only ever read from now on; draw it again. The ring
+    // does not advance, so the next upload still lands in a buffer the GPU finished with.
+    RenderBuffers* fr = &frames[frameIndex[stream] % numFramesInFlight];
+    if (fr->VertexBuffer != NULL && fr->IndexBuffer != NULL) {
+      SetupRenderState(draw_data, graphics_command_list, fr);
+      RenderCommandLists(draw_data, graphics_command_list, fr);
+      return;
+    }
+  }
+  uploadedFrameId[stream] = 0;
 
-  // FIXME: I'm assuming that this only gets called once per frame!
+  // FIXME: I'm assuming that this only gets called once per frame and stream!
   // If not, we can't just re-allocate the IB or VB, we'll have to do a proper
   // allocator.
-  frameIndex = frameIndex + 1;
-  RenderBuffers* fr = &pFrameResources[frameIndex % numFramesInFlight];
+  frameIndex[stream] = frameIndex[stream] + 1;
+  RenderBuffers* fr = &frames[frameIndex[stream] % numFramesInFlight];
 
   // Create and grow vertex/index buffers if needed
   if (fr->VertexBuffer == NULL || fr->VertexBufferSize < draw_data->TotalVtxCount) {
@@ -163,10 +184,16 @@ void D3D12ImGui::RenderDrawData(ImDrawData* draw_data,
   }
   fr->VertexBuffer->Unmap(0, &range);
   fr->IndexBuffer->Unmap(0, &range);
+  uploadedFrameId[stream] = frame_id;
 
   // Setup desired DX state
   SetupRenderState(draw_data, graphics_command_list, fr);
+  RenderCommandLists(draw_data, graphics_command_list, fr);
+}
 
+void D3D12ImGui::RenderCommandLists(ImDrawData* draw_data,
+                                    ID3D12GraphicsCommandList* graphics_command_list,
+                                    RenderBuffers* fr) {
   // Render command lists
   // (Because we merged all buffers into a single one, we maintain our own
   // offset into them)
@@ -408,11 +435,14 @@ void D3D12ImGui::InvalidateDeviceObjects() {
   io.Fonts->SetTexID(NULL);  // We copied pFontTextureView to
                              // io.Fonts->TexID so let's clear that as well.
 
-  for (UINT i = 0; i < numFramesInFlight; i++) {
+  for (UINT i = 0; i < numFramesInFlight * kMaxStreams; i++) {
     RenderBuffers* fr = &pFrameResources[i];
     SafeRelease(fr->IndexBuffer);
     SafeRelease(fr->VertexBuffer);
   }
+  for (int i = 0; i < kMaxStreams; i++) {
+    uploadedFrameId[i] = 0;
+  }
 }
 
 void D3D12ImGui::SetupRenderState(ImDrawData* draw_data, ID3D12GraphicsCommandList* ctx, RenderBuffers* fr) {
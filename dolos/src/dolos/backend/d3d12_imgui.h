@@ -2,11 +2,15 @@
 
 #include <d3d12.h>
 #include <imgui.h>
+#include <cstdint>
 
 namespace dolos {
 
 class D3D12ImGui {
  public:
+  // Independent sources of draw data (background, foreground), each with its own upload buffers.
+  static constexpr int kMaxStreams = 2;
+
   D3D12ImGui() noexcept;
   ~D3D12ImGui() noexcept;
 
@@ -19,7 +23,12 @@ class D3D12ImGui {
   void Shutdown();
 
   void NewFrame();
-  void RenderDrawData(ImDrawData* draw_data, ID3D12GraphicsCommandList* graphics_command_list);
+  // frame_id identifies the content of draw_data (0 if unknown). When it matches what the stream uploaded
+  // last, that upload is drawn again instead of copying identical vertices and indices.
+  void RenderDrawData(ImDrawData* draw_data,
+                      ID3D12GraphicsCommandList* graphics_command_list,
+                      int stream = 0,
+                      uint64_t frame_id = 0);
 
   bool CreateDeviceObjects();
   void InvalidateDeviceObjects();
@@ -44,11 +53,13 @@ class D3D12ImGui {
   D3D12_CPU_DESCRIPTOR_HANDLE hFontSrvCpuDescHandle;
   D3D12_GPU_DESCRIPTOR_HANDLE hFontSrvGpuDescHandle;
 
-  RenderBuffers* pFrameResources;
+  RenderBuffers* pFrameResources;  // numFramesInFlight per stream
   UINT numFramesInFlight;
-  UINT frameIndex;
+  UINT frameIndex[kMaxStreams];
+  uint64_t uploadedFrameId[kMaxStreams];
 
   void SetupRenderState(ImDrawData* draw_data, ID3D12GraphicsCommandList* ctx, RenderBuffers* fr);
+  void RenderCommandLists(ImDrawData* draw_data, ID3D12GraphicsCommandList* ctx, RenderBuffers* fr);
   void CreateFontsTexture();
 };
 
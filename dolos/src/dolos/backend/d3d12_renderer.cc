@@ -73,6 +73,12 @@ enum IDXGISwapChainVTable : size_t {
   IDXGISwapChain_GetLastPresentCount,
 };
 
+// D3D12ImGui upload streams, one per draw data store.
+enum ImGuiStream : int {
+  kBackgroundStream,
+  kForegroundStream,
+};
+
 D3D12Renderer::D3D12Renderer(Win32Window* window, nyx::NyxImGui* nyx_imgui) noexcept
     : window_(window),
       nyx_imgui_(nyx_imgui),
@@ -245,10 +251,11 @@ HRESULT D3D12Renderer::Present(IDXGISwapChain* self, UINT SyncInterval, UINT Fla
       if (nyx_imgui_->visible()) {
         {
           auto* bg = nyx_imgui_->background();
-          ImDrawData* data = bg->Acquire();
+          uint64_t frame_id = 0;
+          ImDrawData* data = bg->Acquire(&frame_id);
           if (data) {
             if (data->Valid) {
-              imgui_.RenderDrawData(data, command_list_.Get());
+              imgui_.RenderDrawData(data, command_list_.Get(), kBackgroundStream, frame_id);
             }
             bg->Release();
           }
@@ -256,10 +263,11 @@ HRESULT D3D12Renderer::Present(IDXGISwapChain* self, UINT SyncInterval, UINT Fla
 
         {
           auto* fg = nyx_imgui_->foreground();
-          ImDrawData* data = fg->Acquire();
+          uint64_t frame_id = 0;
+          ImDrawData* data = fg->Acquire(&frame_id);
           if (data) {
             if (data->Valid) {
-              imgui_.RenderDrawData(data, command_list_.Get());
+              imgui_.RenderDrawData(data, command_list_.Get(), kForegroundStream, frame_id);
             }
             fg->Release();
           }
@@ -271,6 +279,7 @@ HRESULT D3D12Renderer::Present(IDXGISwapChain* self, UINT SyncInterval, UINT Fla
       command_list_->ResourceBarrier(1, &barrier);
       command_list_->Close();
       command_queue_->ExecuteCommandLists(1, reinterpret_cast<ID3D12CommandList* const*>(command_list_.GetAddressOf()));
+      nyx_imgui_->NotifyFrameConsumed();
     } break;
 
     case kShutdown:
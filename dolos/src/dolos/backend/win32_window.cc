@@ -499,8 +499,10 @@ void Win32Window::PushInputEventsForMessage(UINT Msg, WPARAM wParam, LPARAM lPar
           nyx_imgui_->PushInputEvent(ev);
         }
 
+        // Home reloads everything; Shift+Home keeps the isolate and only replaces the scripts' environment.
         if (key == ImGuiKey_Home && !is_key_down) {
-          nyx::Restart();
+          bool shift = (::GetKeyState(VK_SHIFT) & 0x8000) != 0;
+          nyx::Restart(shift ? nyx::RestartMode::kReuseIsolate : nyx::RestartMode::kFull);
         }
 
         if (key == ImGuiKey_End && !is_key_down) {
@@ -3,6 +3,7 @@
 #include "dolos/backend/d3d12_renderer.h"
 #include "dolos/backend/win32_window.h"
 #include "dolos/dolos_binding.h"
+#include "dolos/main_thread.h"
 #include "dolos/pipe_log.h"
 #include "dolos_builtins.h"
 
@@ -16,6 +17,8 @@
 #include <fcntl.h>
 #include <io.h>
 #include <atomic>
+#include <chrono>
+#include <string>
 #include <thread>
 
 namespace dolos {
@@ -175,10 +178,14 @@ DWORD CALLBACK ThreadEntry(LPVOID lpParameter) {
   }
 
   nyx::RegisterBinding("dolos", InitDolosBinding);
+  nyx::RegisterBinding("dolos_main_thread", InitMainThreadBinding);
   dolos_builtins::RegisterBuiltins();
 
   nyx::NyxImGui nyx_imgui;
   nyx::GameLock game_lock;
+  SetMainThreadWakeup([&game_lock]() { game_lock.RequestPump(); });
+  game_lock.SetReporter(std::chrono::seconds(60),
+                        [](const std::string& line) { PIPE_LOG("[dolos] game lock: {}", line); });
 
   PIPE_LOG("[dolos] Initializing hooks...");
   Win32Window window(game, &nyx_imgui, &game_lock);
@@ -236,6 +243,7 @@ DWORD CALLBACK ThreadEntry(LPVOID lpParameter) {
   PIPE_LOG("[dolos] Shutting down...");
   nyx::Teardown();
   window.Shutdown();
+  SetMainThreadWakeup(nullptr);
   renderer.Shutdown();
 
   if (ImGui::GetCurrentContext()) {
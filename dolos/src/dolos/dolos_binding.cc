@@ -1,17 +1,22 @@
 #include "dolos/dolos_binding.h"
 
+#include "dolos/main_thread.h"
 #include "dolos/offset_registry.h"
 
+#include <nyx/env.h>
 #include <nyx/extension.h>
 #include <nyx/isolate_data.h>
+#include <nyx/util.h>
 
 namespace dolos {
 
 using v8::BigInt;
+using v8::FunctionCallbackInfo;
 using v8::Isolate;
 using v8::Local;
 using v8::ObjectTemplate;
 using v8::PropertyAttribute;
+using v8::Value;
 
 void InitDolosBinding(nyx::IsolateData* isolate_data, Local<ObjectTemplate> target) {
   Isolate* isolate = isolate_data->isolate();
@@ -22,4 +27,18 @@ void InitDolosBinding(nyx::IsolateData* isolate_data, Local<ObjectTemplate> targ
   }
 }
 
+// yieldToMainThread() -> Promise<void>
+// Resolves on this thread's event loop once the game's main thread has run its queue up to this call, i.e. at
+// its next game lock window. Rejects if the queue is full.
+static void YieldToMainThread(const FunctionCallbackInfo<Value>& args) {
+  nyx::Environment* env = nyx::Environment::GetCurrent(args);
+  args.GetReturnValue().Set(RunOnMainThreadAsync(env, []() {}));
+}
+
+void InitMainThreadBinding(nyx::IsolateData* isolate_data, Local<ObjectTemplate> target) {
+  Isolate* isolate = isolate_data->isolate();
+
+  nyx::SetMethod(isolate, target, "yieldToMainThread", YieldToMainThread);
+}
+
 }  // namespace dolos
@@ -5,6 +5,7 @@
 namespace dolos {
 
 void InitDolosBinding(nyx::IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+void InitMainThreadBinding(nyx::IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
 void RegisterDolosBindingAndBuiltins();
 
 }  // namespace dolos
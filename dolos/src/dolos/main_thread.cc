@@ -1,46 +1,164 @@
 #include "dolos/main_thread.h"
 
-#include <future>
-#include <mutex>
-#include <queue>
+#include "nyx/env.h"
+#include "nyx/errors.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
 
 namespace dolos {
 
 namespace {
 
-struct Task {
+// Bounded multi-producer/single-consumer ring (Vyukov). Each slot's sequence tells
+// whose turn it is: equal to the ticket when free for that producer, ticket + 1 once
+// filled, ticket + capacity after the main thread has run it. finished is ticket + 1
+// once fn has run; RunOnMainThread waits on it rather than on its own stack, so the
+// main thread never touches a waiter that has already returned.
+constexpr size_t kQueueCapacity = 256;
+
+struct Slot {
+  std::atomic<size_t> sequence;
+  std::atomic<size_t> finished;
   std::function<void()> fn;
-  std::promise<void> promise;
+  std::function<void()> on_complete;
+  bool waited;
 };
 
-std::mutex g_mutex;
-std::queue<std::unique_ptr<Task>> g_queue;
+struct Ring {
+  Ring() {
+    for (size_t i = 0; i < kQueueCapacity; i++) {
+      slots[i].sequence.store(i, std::memory_order_relaxed);
+      slots[i].finished.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  Slot slots[kQueueCapacity];
+  alignas(64) std::atomic<size_t> enqueue_pos{0};
+  alignas(64) size_t dequeue_pos = 0;  // main thread only
+};
+
+Ring g_ring;
+std::function<void()> g_wakeup;
+
+// Moves fn and on_complete into a free slot and stores its ticket. Leaves them untouched and
+// returns false when full.
+bool TryPush(std::function<void()>& fn, std::function<void()>& on_complete, bool waited, size_t* ticket) {
+  size_t pos = g_ring.enqueue_pos.load(std::memory_order_relaxed);
+  Slot* slot;
+  for (;;) {
+    slot = &g_ring.slots[pos % kQueueCapacity];
+    size_t sequence = slot->sequence.load(std::memory_order_acquire);
+    intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+    if (diff == 0) {
+      if (g_ring.enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+    } else if (diff < 0) {
+      return false;
+    } else {
+      pos = g_ring.enqueue_pos.load(std::memory_order_relaxed);
+    }
+  }
+
+  slot->fn = std::move(fn);
+  slot->on_complete = std::move(on_complete);
+  slot->waited = waited;
+  slot->sequence.store(pos + 1, std::memory_order_release);
+  if (ticket) {
+    *ticket = pos;
+  }
+  return true;
+}
+
+void Wakeup() {
+  if (g_wakeup) {
+    g_wakeup();
+  }
+}
 
 }  // namespace
 
 void RunOnMainThread(std::function<void()> fn) {
-  auto task = std::make_unique<Task>();
-  task->fn = std::move(fn);
-  auto future = task->promise.get_future();
+  std::function<void()> on_complete;
+  size_t ticket;
+  while (!TryPush(fn, on_complete, true, &ticket)) {
+    // Full: make sure the main thread is draining and retry.
+    Wakeup();
+    std::this_thread::yield();
+  }
+  Wakeup();
 
-  {
-    std::lock_guard lock(g_mutex);
-    g_queue.push(std::move(task));
+  // The slot may be refilled and run again before this thread gets to look, so anything
+  // at or past this ticket means it is done.
+  std::atomic<size_t>& finished = g_ring.slots[ticket % kQueueCapacity].finished;
+  for (;;) {
+    size_t value = finished.load(std::memory_order_acquire);
+    if (static_cast<intptr_t>(value - (ticket + 1)) >= 0) break;
+    finished.wait(value, std::memory_order_acquire);
   }
+}
 
-  future.wait();
+bool PostToMainThread(std::function<void()> fn, std::function<void()> on_complete) {
+  if (!TryPush(fn, on_complete, false, nullptr)) {
+    return false;
+  }
+  Wakeup();
+  return true;
+}
+
+v8::Local<v8::Promise> RunOnMainThreadAsync(nyx::Environment* env, std::function<void()> fn) {
+  v8::Isolate* isolate = env->isolate();
+  v8::Local<v8::Context> context = env->context();
+  v8::Local<v8::Promise::Resolver> resolver = v8::Promise::Resolver::New(context).ToLocalChecked();
+  v8::Local<v8::Promise> promise = resolver->GetPromise();
+
+  auto pending = std::make_unique<v8::Global<v8::Promise::Resolver>>(isolate, resolver);
+  auto* raw = pending.get();
+  auto immediates = env->threadsafe_immediates();
+  bool queued = PostToMainThread(std::move(fn), [raw, immediates]() {
+    // The queue outlives its environment and drops what is posted once the environment has
+    // stopped; the isolate is gone by then too, and the handle is left as is.
+    immediates->Post([raw](nyx::Environment* env) {
+      std::unique_ptr<v8::Global<v8::Promise::Resolver>> pending(raw);
+      pending->Get(env->isolate())->Resolve(env->context(), v8::Undefined(env->isolate())).Check();
+    });
+  });
+  if (!queued) {
+    resolver->Reject(context, nyx::ERR_OPERATION_FAILED(isolate, "main thread queue is full")).Check();
+    return promise;
+  }
+
+  pending.release();
+  return promise;
+}
+
+void SetMainThreadWakeup(std::function<void()> wakeup) {
+  g_wakeup = std::move(wakeup);
 }
 
 void DrainMainThreadQueue() {
-  std::unique_lock lock(g_mutex);
-  while (!g_queue.empty()) {
-    auto task = std::move(g_queue.front());
-    g_queue.pop();
-    lock.unlock();
-    task->fn();
-    task->promise.set_value();
-    lock.lock();
+  // Bounded to one lap so producers refilling the ring cannot keep the main thread here.
+  size_t pos = g_ring.dequeue_pos;
+  for (size_t i = 0; i < kQueueCapacity; i++) {
+    Slot& slot = g_ring.slots[pos % kQueueCapacity];
+    if (slot.sequence.load(std::memory_order_acquire) != pos + 1) break;
+
+    slot.fn();
+    if (slot.waited) {
+      slot.finished.store(pos + 1, std::memory_order_release);
+      slot.finished.notify_all();
+    }
+    if (slot.on_complete) {
+      slot.on_complete();
+    }
+
+    slot.fn = nullptr;
+    slot.on_complete = nullptr;
+    slot.sequence.store(pos + kQueueCapacity, std::memory_order_release);
+    pos++;
   }
+  g_ring.dequeue_pos = pos;
 }
 
 }  // namespace dolos
@@ -1,7 +1,13 @@
 #pragma once
 
+#include <v8.h>
+
 #include <functional>
 
+namespace nyx {
+class Environment;
+}  // namespace nyx
+
 namespace dolos {
 
 // Queue a function to run on the main thread and block until it completes.
@@ -9,7 +15,21 @@ namespace dolos {
 // it during the open window and fulfill the result before releasing.
 void RunOnMainThread(std::function<void()> fn);
 
-// Execute all queued main-thread tasks. Called by the game lock pump on the
+// Queue a function to run on the main thread without waiting for it. on_complete,
+// if set, runs on the main thread right after fn. Returns false if the queue is
+// full; fn is not queued in that case.
+bool PostToMainThread(std::function<void()> fn, std::function<void()> on_complete = nullptr);
+
+// Non-blocking RunOnMainThread for script threads: the returned promise settles on
+// env's event loop once fn has run on the main thread, and rejects right away if
+// the queue is full. Must be called on env's thread inside its context.
+v8::Local<v8::Promise> RunOnMainThreadAsync(nyx::Environment* env, std::function<void()> fn);
+
+// Called after a task is queued, to wake the main thread if it is waiting inside
+// a game lock window. Set once during startup.
+void SetMainThreadWakeup(std::function<void()> wakeup);
+
+// Execute the queued main-thread tasks. Called by the game lock pump on the
 // main thread during each open window. Must only be called from the main thread.
 void DrainMainThreadQueue();
 
@@ -8,3 +8,10 @@
 declare function internalBinding(module: 'dolos'): {
   readonly [offsetName: string]: bigint;
 };
+
+/**
+ * Main-thread queue of the game process
+ */
+declare function internalBinding(module: 'dolos_main_thread'): {
+  yieldToMainThread(): Promise<void>;
+};
@@ -0,0 +1,12 @@
+declare module 'dolos/main_thread' {
+  /**
+   * Wait for the game's main thread without blocking this one.
+   * Resolves once the main thread has run its queue up to this call, at its next game lock window.
+   * Rejects if the main thread queue is full.
+   */
+  export function yieldToMainThread(): Promise<void>;
+}
+
+declare module 'nyx:dolos/main_thread' {
+  export * from 'dolos/main_thread';
+}
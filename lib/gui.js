@@ -488,6 +488,36 @@ class InputDouble extends binding.InputNumberWidget {
   }
 }
 
+/**
+ * Set how often UI frames are built. Event loop iterations between frames (timers, fs callbacks, game
+ * lock grants) run without updating or rendering widgets.
+ * @param {number} rate - Frames per second, 1..1000 (default 60)
+ * @param {boolean} [rendererPaced=true] - Build the next frame only once the renderer has presented the
+ *   previous one, at most rate times per second
+ */
+function setFrameRate(rate, rendererPaced = true) {
+  binding.setFrameRate(rate, rendererPaced === true);
+}
+
+/**
+ * Frame scheduler statistics since startup or the last reset. Times are in microseconds.
+ * @param {boolean} [reset=false] - Clear the statistics after reading them
+ */
+function getFrameStats(reset = false) {
+  return binding.getFrameStats(reset === true);
+}
+
+/**
+ * Control garbage collection between UI frames. While enabled, the time left before the next frame or
+ * timer is handed to V8 for pending GC work, and a heap that grew by more than heapGrowthThreshold bytes
+ * since the last full collection starts incremental marking there instead of during a frame.
+ * @param {boolean} [enabled=true]
+ * @param {number} [heapGrowthThreshold=33554432] - Bytes; 0 never signals memory pressure
+ */
+function setIdleGc(enabled = true, heapGrowthThreshold = 32 * 1024 * 1024) {
+  binding.setIdleGc(enabled === true, heapGrowthThreshold);
+}
+
 module.exports = {
   ColorEditFlags,
   ColorEdit3,
@@ -567,6 +597,7 @@ module.exports = {
 
   PlotLines: binding.PlotLines,
   PlotHistogram: binding.PlotHistogram,
+  FlameGraph: binding.FlameGraph,
 
   Indent: binding.Indent,
   Unindent: binding.Unindent,
@@ -589,6 +620,9 @@ module.exports = {
 
   io,
   fontSize: binding.fontSize,
+  setFrameRate,
+  getFrameStats,
+  setIdleGc,
 
   background: binding.background,
   foreground: binding.foreground,
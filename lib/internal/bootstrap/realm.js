@@ -219,5 +219,24 @@ function requireBuiltin(id) {
   return mod.compileForInternalLoader();
 }
 
+// Called instead of this file when the realm is deserialized from the startup snapshot, with the ids the loader
+// holds now. Builtins registered by extensions after the snapshot was built are missing from the map.
+function addBuiltinIds(ids) {
+  for (let i = 0; i < ids.length; ++i) {
+    const id = ids[i];
+    if (id === selfId || BuiltinModule.map.has(id)) {
+      continue;
+    }
+    BuiltinModule.map.set(id, new BuiltinModule(id));
+    if (id.startsWith('internal/')) {
+      internalBuiltinIds.push(id);
+    } else {
+      publicBuiltinIds.push(id);
+      canBeRequiredByUsersList.add(id);
+      canBeRequiredByUsersWithoutSchemeList.add(id);
+    }
+  }
+}
+
 // Store the internal loaders in C++.
-setInternalLoaders(internalBinding, requireBuiltin);
+setInternalLoaders(internalBinding, requireBuiltin, addBuiltinIds);
@@ -0,0 +1,22 @@
+'use strict';
+
+// Entry point of a worker thread: runs the module its Worker was created with. Relative filenames resolve
+// against the scripts root, bare specifiers against the packages found there. The worker keeps running until
+// it calls close() or the parent terminates it.
+
+const packages = require('internal/modules/package');
+
+packages.scanPackages();
+
+const { loader } = require('internal/modules/loader');
+
+const { filename, close } = internalBinding('worker');
+const process = internalBinding('process');
+
+try {
+  loader.getModuleNamespaceSync(loader.resolve(filename, process.scriptsRoot() + '/'));
+} catch (e) {
+  // Nothing would ever stop a worker whose module failed to load.
+  close();
+  throw e;
+}
@@ -19,6 +19,11 @@ const {
   kErrored,
 } = internalBinding('module_wrap');
 
+const {
+  registerPackage,
+  runInPackage,
+} = internalBinding('watchdog');
+
 const fs = require('fs');
 
 const packages = require('internal/modules/package');
@@ -226,7 +231,8 @@ setImportModuleDynamicallyCallback((specifier, referrer) => {
   return loader.importAsync(specifier, referrer);
 });
 
-// Execute all runtime packages
+// Execute all runtime packages. Each runs charged to its own package, so the timers and widgets it creates are
+// too; see PackageWatchdog.
 function runRuntimes() {
   const runtimes = packages.getRuntimePackages();
   debugLog('Found ' + runtimes.length + ' runtime package(s)');
@@ -235,7 +241,8 @@ function runRuntimes() {
     const pkg = runtimes[i];
     debugLog('Executing runtime: ' + pkg.name + ' (' + pkg.main + ')');
     try {
-      loader.getModuleNamespaceSync(pkg.main);
+      const id = registerPackage(pkg.name);
+      runInPackage(id, () => loader.getModuleNamespaceSync(pkg.main));
     } catch (e) {
       debugLog('Error executing runtime "' + pkg.name + '": ' + e.message);
       debugLog(e.stack);
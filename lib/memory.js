@@ -122,6 +122,15 @@ const typedArrayInfo = {
   float64: { prop: '_f64', ctor: 'Float64Array' },
 };
 
+// Column constructors used by decodeColumns, one per scalar field type
+const columnCtor = {
+  int8: Int8Array, uint8: Uint8Array, bool: Uint8Array,
+  int16: Int16Array, uint16: Uint16Array,
+  int32: Int32Array, uint32: Uint32Array, float32: Float32Array,
+  int64: BigInt64Array, uint64: BigUint64Array, pointer: BigUint64Array,
+  float64: Float64Array,
+};
+
 // Resolve a model field that may be a thunk (() => model) for self-referential types.
 function resolveModel(m) {
   return typeof m === 'function' ? m() : m;
@@ -569,7 +578,9 @@ class MemoryModel {
 
   // read a single object at address, guarding against circular pointer chains.
   // visited is a Set<BigInt> of addresses already seen on the current traversal path.
-  _readWithVisited(address, visited) {
+  // prefetched, when given, holds this object's bytes from an earlier readMemoryBatch, which checked them
+  // against the checksum cache under (address, prefetchedSize); unchanged tells whether they matched.
+  _readWithVisited(address, visited, prefetched, prefetchedSize, unchanged) {
     const bigAddr = BigInt(address);
 
     // Return cached object if it's from the current generation (same tick).
@@ -578,16 +589,24 @@ class MemoryModel {
       return cached.obj;
     }
 
-    const raw = binding.readMemoryIfChanged(bigAddr, this.size >>> 0);
-    if (raw === undefined && cached !== undefined) {
+    // The checksum entry the object's bytes were last checked under; the cached object is only current
+    // for an unchanged read under the same entry
+    let buffer = prefetched;
+    let checksumSize = prefetchedSize;
+    if (buffer === undefined) {
+      checksumSize = this.size;
+      const raw = binding.readMemoryIfChanged(bigAddr, this.size >>> 0);
+      unchanged = raw === undefined;
+      buffer = raw ?? binding.readMemoryFast(bigAddr, this.size >>> 0);
+    }
+    if (unchanged && cached !== undefined && cached.checksumSize === checksumSize) {
       cached.gen = MemoryModel._generation;
       return cached.obj;
     }
-    const buffer = raw ?? binding.readMemoryFast(bigAddr, this.size >>> 0);
 
     const obj = new this.CursorClass(bigAddr, buffer, 1, this.size, MemoryModel._registry);
 
-    this._cache.set(bigAddr, { obj, gen: MemoryModel._generation });
+    this._cache.set(bigAddr, { obj, gen: MemoryModel._generation, checksumSize });
 
     const pointerModelFields = this._resolvedPointerFields;
     if (pointerModelFields.length > 0) {
@@ -608,6 +627,88 @@ class MemoryModel {
     return obj;
   }
 
+  // Resolve the eager pointer-model fields of count consecutive elements in buffer and
+  // return one { fieldName: object | null } entry per element. All first-hop targets are
+  // fetched with a single readMemoryBatch call; targets already read this generation are
+  // served from the cache, and entries that fault fall back to the per-object path.
+  _resolvePointerCaches(buffer, count) {
+    const pointerModelFields = this._resolvedPointerFields;
+    const fieldCount = pointerModelFields.length;
+    const view = new DataView(buffer.buffer, buffer.byteOffset, buffer.byteLength);
+    const ptrs = new Array(count * fieldCount);
+
+    // address -> index into the batch, so shared targets are only read once
+    const batchIndex = new Map();
+    const addresses = [];
+    const layout = [];
+    for (let i = 0; i < count; i++) {
+      for (let j = 0; j < fieldCount; j++) {
+        const field = pointerModelFields[j];
+        const ptr = view.getBigUint64(i * this.size + field.offset, IS_LITTLE_ENDIAN);
+        ptrs[i * fieldCount + j] = ptr;
+        if (ptr === 0n) continue;
+        const model = field.resolvedModel;
+        const cached = model._cache.get(ptr);
+        if (cached !== undefined && cached.gen === MemoryModel._generation) continue;
+        const entry = batchIndex.get(ptr);
+        if (entry === undefined) {
+          batchIndex.set(ptr, addresses.length);
+          addresses.push(ptr);
+          layout.push(model.size, 0);
+        } else if (layout[entry * 2] < model.size) {
+          // different models alias the same address; read enough for the largest
+          layout[entry * 2] = model.size;
+        }
+      }
+    }
+
+    let dest = null;
+    let status = null;
+    let unchanged = null;
+    if (addresses.length > 0) {
+      // keep slices 8-byte aligned so cursors can map typed array views onto them
+      let destSize = 0;
+      for (let k = 0; k < addresses.length; k++) {
+        layout[k * 2 + 1] = destSize;
+        destSize += (layout[k * 2] + 7) & ~7;
+      }
+      dest = new Uint8Array(destSize);
+      // Checked against the checksum cache, so single reads that follow see what the batch saw
+      unchanged = new Uint8Array((addresses.length + 7) >> 3);
+      status = binding.readMemoryBatch(
+        BigUint64Array.from(addresses), Uint32Array.from(layout), dest, undefined, unchanged);
+    }
+
+    const caches = new Array(count);
+    const visited = new Set();
+    for (let i = 0; i < count; i++) {
+      const elemCache = {};
+      for (let j = 0; j < fieldCount; j++) {
+        const field = pointerModelFields[j];
+        const ptr = ptrs[i * fieldCount + j];
+        if (ptr === 0n) {
+          elemCache[field.name] = null;
+          continue;
+        }
+        let prefetched;
+        let prefetchedSize;
+        let same = false;
+        const entry = batchIndex.get(ptr);
+        if (entry !== undefined && (status[entry >> 3] & (1 << (entry & 7))) !== 0) {
+          const offset = layout[entry * 2 + 1];
+          prefetched = dest.subarray(offset, offset + field.resolvedModel.size);
+          prefetchedSize = layout[entry * 2];
+          same = (unchanged[entry >> 3] & (1 << (entry & 7))) !== 0;
+        }
+        visited.clear();
+        visited.add(ptr);
+        elemCache[field.name] = field.resolvedModel._readWithVisited(ptr, visited, prefetched, prefetchedSize, same);
+      }
+      caches[i] = elemCache;
+    }
+    return caches;
+  }
+
   // Read a single object at address
   read(address) {
     const bigAddr = BigInt(address);
@@ -625,26 +726,8 @@ class MemoryModel {
     const buffer = binding.readMemoryFast(BigInt(address), totalSize >>> 0);
     const cursor = new this.CursorClass(BigInt(address), buffer, count, this.size, MemoryModel._registry);
 
-    const pointerModelFields = this._resolvedPointerFields;
-    if (pointerModelFields.length > 0) {
-      const view = new DataView(buffer.buffer, buffer.byteOffset, buffer.byteLength);
-      const cache = new Array(count);
-      const visited = new Set();
-      for (let i = 0; i < count; i++) {
-        const elemCache = {};
-        for (const field of pointerModelFields) {
-          const ptr = view.getBigUint64(i * this.size + field.offset, IS_LITTLE_ENDIAN);
-          if (ptr === 0n) {
-            elemCache[field.name] = null;
-          } else {
-            visited.clear();
-            visited.add(ptr);
-            elemCache[field.name] = field.resolvedModel._readWithVisited(ptr, visited);
-          }
-        }
-        cache[i] = elemCache;
-      }
-      cursor._pointerModelCache = cache;
+    if (this._resolvedPointerFields.length > 0) {
+      cursor._pointerModelCache = this._resolvePointerCaches(buffer, count);
     }
 
     return cursor;
@@ -658,6 +741,42 @@ class MemoryModel {
 
     // Find pointer model fields that need eager loading (thunks resolved once, lazily)
     const pointerModelFields = this._resolvedPointerFields;
+    // Per-element flags for the last $load: 1 when any byte of the element changed
+    const dirty = new Uint8Array(maxCount);
+    let dirtyCount = 0;
+    // Range the buffer holds, for telling readMemoryDiff results apart from a fresh read
+    let lastAddress;
+    let lastCount = 0;
+
+    const markDirty = (ranges, count) => {
+      dirty.fill(0, 0, count);
+      dirtyCount = 0;
+      for (let i = 0; i < ranges.length; i += 2) {
+        const last = Math.min(count - 1, Math.floor((ranges[i + 1] - 1) / this.size));
+        for (let e = Math.floor(ranges[i] / this.size); e <= last; e++) {
+          if (dirty[e] === 0) {
+            dirty[e] = 1;
+            dirtyCount++;
+          }
+        }
+      }
+    };
+
+    const markAll = (value, count) => {
+      dirty.fill(value, 0, count);
+      dirtyCount = value ? count : 0;
+    };
+
+    // Whether element index changed in the last $load
+    cursor.$isChanged = (index) => dirty[index] === 1;
+    // Indices of the elements that changed in the last $load
+    cursor.$changedIndices = () => {
+      const out = new Array(dirtyCount);
+      for (let i = 0, n = 0; n < dirtyCount; i++) {
+        if (dirty[i] === 1) out[n++] = i;
+      }
+      return out;
+    };
 
     cursor.$load = (address, count) => {
       if (count > maxCount) {
@@ -669,45 +788,47 @@ class MemoryModel {
         cursor._idx = 0;
         cursor._off = 0;
         cursor._pointerModelCache = undefined;
+        dirty.fill(0);
+        dirtyCount = 0;
+        lastAddress = cursor._baseAddr;
+        lastCount = 0;
         return;
       }
       const bigAddr = BigInt(address);
       const slice = buffer.subarray(0, this.size * count);
       let changed;
-      if (binding.readMemoryIntoIfChanged) {
+      if (binding.readMemoryDiff) {
+        // The buffer holds the previous load; only the chunks that differ are copied in
+        const ranges = binding.readMemoryDiff(bigAddr, slice);
+        if (bigAddr !== lastAddress || count > lastCount) {
+          // Compared against another range or bytes never loaded, so every element is new
+          markAll(1, count);
+        } else {
+          markDirty(ranges, count);
+        }
+        changed = dirtyCount > 0;
+      } else if (binding.readMemoryIntoIfChanged) {
         changed = binding.readMemoryIntoIfChanged(bigAddr, slice);
+        markAll(changed ? 1 : 0, count);
       } else if (binding.readMemoryInto) {
         binding.readMemoryInto(bigAddr, slice);
         changed = true;
+        markAll(1, count);
       } else {
         const tmp = binding.readMemoryFast(bigAddr, (this.size * count) >>> 0);
         buffer.set(tmp.subarray(0, this.size * count));
         changed = true;
+        markAll(1, count);
       }
       cursor._baseAddr = bigAddr;
       cursor._count = count;
       cursor._idx = 0;
       cursor._off = 0;
+      lastAddress = bigAddr;
+      lastCount = count;
 
       if (pointerModelFields.length > 0) {
-        const view = new DataView(buffer.buffer, buffer.byteOffset, buffer.byteLength);
-        const cache = new Array(count);
-        const visited = new Set();
-        for (let i = 0; i < count; i++) {
-          const elemCache = {};
-          for (const field of pointerModelFields) {
-            const ptr = view.getBigUint64(i * this.size + field.offset, IS_LITTLE_ENDIAN);
-            if (ptr === 0n) {
-              elemCache[field.name] = null;
-            } else {
-              visited.clear();
-              visited.add(ptr);
-              elemCache[field.name] = field.resolvedModel._readWithVisited(ptr, visited);
-            }
-          }
-          cache[i] = elemCache;
-        }
-        cursor._pointerModelCache = cache;
+        cursor._pointerModelCache = this._resolvePointerCaches(slice, count);
       }
 
       return changed;
@@ -721,30 +842,15 @@ class MemoryModel {
     const totalSize = this.size * count;
     const buffer = binding.readMemoryFast(BigInt(address), totalSize >>> 0);
     const result = new Array(count);
-    const pointerModelFields = this._resolvedPointerFields;
-    // Hoist DataView and visited Set outside the element loop
-    const view = pointerModelFields.length > 0
-      ? new DataView(buffer.buffer, buffer.byteOffset, buffer.byteLength)
-      : null;
-    const visited = pointerModelFields.length > 0 ? new Set() : null;
+    // Resolve every element's pointer fields up front so their targets share one batched read
+    const caches = this._resolvedPointerFields.length > 0 ? this._resolvePointerCaches(buffer, count) : null;
 
     for (let i = 0; i < count; i++) {
       const slice = buffer.subarray(i * this.size, (i + 1) * this.size);
       const cursor = new this.CursorClass(BigInt(address) + BigInt(i * this.size), slice, 1, this.size, MemoryModel._registry);
 
-      if (view !== null) {
-        const elemCache = {};
-        for (const field of pointerModelFields) {
-          const ptr = view.getBigUint64(i * this.size + field.offset, IS_LITTLE_ENDIAN);
-          if (ptr === 0n) {
-            elemCache[field.name] = null;
-          } else {
-            visited.clear();
-            visited.add(ptr);
-            elemCache[field.name] = field.resolvedModel._readWithVisited(ptr, visited);
-          }
-        }
-        cursor._pointerModelCache = [elemCache];
+      if (caches !== null) {
+        cursor._pointerModelCache = [caches[i]];
       }
 
       result[i] = cursor;
@@ -753,6 +859,98 @@ class MemoryModel {
     return result;
   }
 
+  // Read objects at arbitrary addresses (e.g. from walkList) with one batched read.
+  // Returns one cursor per address, or null where the read faulted.
+  readNodes(addresses) {
+    const count = addresses.length;
+    const addrs = addresses instanceof BigUint64Array ? addresses : BigUint64Array.from(addresses, BigInt);
+    const buffer = new Uint8Array(this.size * count);
+    const layout = new Uint32Array(count * 2);
+    for (let i = 0; i < count; i++) {
+      layout[i * 2] = this.size;
+      layout[i * 2 + 1] = i * this.size;
+    }
+    const status = binding.readMemoryBatch(addrs, layout, buffer);
+    const caches = this._resolvedPointerFields.length > 0 ? this._resolvePointerCaches(buffer, count) : null;
+
+    const result = new Array(count);
+    for (let i = 0; i < count; i++) {
+      if ((status[i >> 3] & (1 << (i & 7))) === 0) {
+        result[i] = null;
+        continue;
+      }
+      const slice = buffer.subarray(i * this.size, (i + 1) * this.size);
+      const cursor = new this.CursorClass(addrs[i], slice, 1, this.size, MemoryModel._registry);
+      if (caches !== null) cursor._pointerModelCache = [caches[i]];
+      result[i] = cursor;
+    }
+    return result;
+  }
+
+  // Walk a linked list of this model starting at head and read every node.
+  // next/prev are field names or byte offsets; prev makes the walk verify back links.
+  readList(head, { next, prev, max = 4096 } = {}) {
+    const nextOffset = this._fieldOffset(next);
+    const prevOffset = prev === undefined ? undefined : this._fieldOffset(prev);
+    return this.readNodes(walkList(head, { next: nextOffset, prev: prevOffset, max }));
+  }
+
+  // Compile the named scalar fields into the native (offset, elementSize) layout descriptor.
+  // Descriptors are cached per field list so each is built only once.
+  _columnLayout(fieldNames) {
+    const key = fieldNames.join(',');
+    let compiled = this._columnLayouts?.get(key);
+    if (compiled !== undefined) return compiled;
+
+    const layout = new Uint32Array(fieldNames.length * 2);
+    const fields = fieldNames.map((name, i) => {
+      const info = this.fieldInfos.find(f => f.name === name);
+      if (!info || !columnCtor[info.type]) {
+        throw new Error(`MemoryModel '${this.name}': '${name}' is not a scalar field`);
+      }
+      layout[i * 2] = info.offset;
+      layout[i * 2 + 1] = info.size;
+      return { name, ctor: columnCtor[info.type] };
+    });
+    compiled = { layout, fields };
+    (this._columnLayouts ??= new Map()).set(key, compiled);
+    return compiled;
+  }
+
+  // Decode fieldNames of many objects into one typed array per field (structure of arrays).
+  // source is either an address list (BigUint64Array or array) or { address, count } for a
+  // contiguous array. Pass a previous result as out to reuse its columns when large enough.
+  // The result also carries $count and a $status bitmap (bit i clear = object i faulted).
+  decodeColumns(source, fieldNames, out) {
+    const { layout, fields } = this._columnLayout(fieldNames);
+    let addresses;
+    let count;
+    if (source instanceof BigUint64Array || Array.isArray(source)) {
+      addresses = source instanceof BigUint64Array ? source : BigUint64Array.from(source, BigInt);
+      count = addresses.length;
+    } else {
+      addresses = BigInt(source.address);
+      count = source.count;
+    }
+
+    const result = out ?? {};
+    const columns = fields.map(({ name, ctor }) => {
+      const existing = result[name];
+      if (existing instanceof ctor && existing.length >= count) return existing;
+      return (result[name] = new ctor(count));
+    });
+    result.$count = count;
+    result.$status = binding.decodeColumns(addresses, count >>> 0, this.size >>> 0, layout, columns);
+    return result;
+  }
+
+  _fieldOffset(field) {
+    if (typeof field === 'number') return field;
+    const info = this.fieldInfos.find(f => f.name === field);
+    if (!info) throw new Error(`MemoryModel '${this.name}' has no field '${field}'`);
+    return info.offset;
+  }
+
   // Initialize all fields on a target object with zero values based on fieldInfos.
   // Sets 0 for numbers, 0n for bigints/pointers, null for model fields.
   initSnapshot(target) {
@@ -896,6 +1094,152 @@ const snapshotRegistry = {
   },
 };
 
+/**
+ * Follow a multi-level pointer chain: [base + o0], [[base + o0] + o1], ...
+ * @param {bigint|number} base - Start address
+ * @param {Array<number|bigint>|BigInt64Array} offsets - Offset added before each dereference
+ * @returns {BigUint64Array} - Pointer read at every hop; shorter than offsets if the chain breaks
+ */
+function resolvePointerChain(base, offsets) {
+  const hops = offsets instanceof BigInt64Array ? offsets : BigInt64Array.from(offsets, BigInt);
+  return binding.resolvePointerChain(BigInt(base), hops);
+}
+
+/**
+ * Walk a singly (or, with prev, doubly) linked list natively.
+ * Stops at null, on a cycle, on an unreadable node or on a broken back link.
+ * @param {bigint|number} head - Address of the first node
+ * @param {{next: number, prev?: number, max?: number}} options - Link offsets and node limit
+ * @returns {BigUint64Array} - Node addresses in list order
+ */
+function walkList(head, { next, prev, max = 4096 } = {}) {
+  if (prev === undefined) return binding.walkList(BigInt(head), next >>> 0, max >>> 0);
+  return binding.walkList(BigInt(head), next >>> 0, max >>> 0, prev >>> 0);
+}
+
+/**
+ * Walk every chain of an open-hash bucket array natively.
+ * @param {bigint|number} buckets - Address of the bucket array
+ * @param {number} bucketCount - Number of buckets
+ * @param {{next: number, max?: number, stride?: number}} options - Chain link offset, node limit and
+ *   distance between bucket heads in bytes (8..4096, default 8)
+ * @returns {BigUint64Array} - Unique node addresses, bucket by bucket
+ */
+function walkHashBuckets(buckets, bucketCount, { next, max = 4096, stride = 8 } = {}) {
+  return binding.walkHashBuckets(BigInt(buckets), bucketCount >>> 0, next >>> 0, max >>> 0, stride >>> 0);
+}
+
+/**
+ * Decode fields of many objects of a model into per-field typed arrays.
+ * @param {MemoryModel} model - Layout of each object
+ * @param {BigUint64Array|Array<bigint>|{address: bigint|number, count: number}} addresses - Objects to read
+ * @param {string[]} fieldNames - Scalar fields to decode
+ * @returns {Object} - { [fieldName]: TypedArray, $count, $status }
+ */
+function decodeColumns(model, addresses, fieldNames) {
+  return model.decodeColumns(addresses, fieldNames);
+}
+
+/**
+ * Resize the native checksum cache used by readMemoryIfChanged / readMemoryIntoIfChanged.
+ * Existing entries are dropped.
+ * @param {{capacity?: number, maxAge?: number}} options - Slot count (rounded up to a power of two) and
+ *   number of frames an entry may go untouched before it is dropped
+ */
+function configureChecksumCache({ capacity = 32768, maxAge = 300 } = {}) {
+  binding.configureChecksumCache(capacity >>> 0, maxAge >>> 0);
+}
+
+// Ordinals match ScanValueType / ScanCompare in memory_scan.h
+const scanTypes = { int32: 0, float: 1, pointer: 2, pattern: 3 };
+const scanCompares = { equal: 0, changed: 1, unchanged: 2, increased: 3, decreased: 4 };
+const scanDefaultAlignment = [4, 4, 8, 1];
+// hits -> { values, truncated } for every result handed out, so a next scan can compare against it
+const scanResults = new WeakMap();
+
+// Accepts 'AA BB ?? CC' (also '?' for wildcards) or an array of bytes with null for wildcards
+function parseScanPattern(pattern) {
+  const tokens = typeof pattern === 'string' ? pattern.trim().split(/\s+/) : Array.from(pattern);
+  const bytes = new Uint8Array(tokens.length);
+  const mask = new Uint8Array(tokens.length);
+  for (let i = 0; i < tokens.length; i++) {
+    const token = tokens[i];
+    if (token === null || token === '?' || token === '??') continue;
+    const byte = typeof token === 'string' ? parseInt(token, 16) : token;
+    if (!Number.isInteger(byte) || byte < 0 || byte > 0xff) {
+      throw new TypeError(`Invalid pattern byte: ${token}`);
+    }
+    bytes[i] = byte;
+    mask[i] = 1;
+  }
+  return { bytes, mask };
+}
+
+/**
+ * Search committed, readable memory for a value or byte pattern on the libuv threadpool.
+ * Pass a previous result as spec.previous to narrow it instead ("next scan").
+ * @param {Object} spec
+ * @param {'int32'|'float'|'pointer'|'pattern'} spec.type - What to look for
+ * @param {number|bigint} [spec.value] - Value for int32/float/pointer scans
+ * @param {string|Array<number|null>} [spec.pattern] - 'AA ?? BB' or bytes with null wildcards
+ * @param {'equal'|'changed'|'unchanged'|'increased'|'decreased'} [spec.compare] - Next-scan filter
+ *   (default 'equal')
+ * @param {number} [spec.epsilon] - Tolerance for float compares (default 0.0001)
+ * @param {number} [spec.alignment] - Hit alignment in bytes (default: value size, 1 for patterns)
+ * @param {bigint|number} [spec.start] - Lowest address to search
+ * @param {bigint|number} [spec.end] - Address to stop at
+ * @param {boolean} [spec.writableOnly] - Skip read-only and code pages
+ * @param {number} [spec.maxResults] - Stop after this many hits
+ * @param {BigUint64Array} [spec.previous] - Result of an earlier scan to narrow
+ * @returns {Promise<BigUint64Array>} - Hit addresses in ascending order
+ */
+function scan(spec) {
+  const type = scanTypes[spec.type];
+  if (type === undefined) {
+    throw new TypeError(`Unknown scan type: ${spec.type}`);
+  }
+  const compare = scanCompares[spec.compare ?? 'equal'];
+  if (compare === undefined) {
+    throw new TypeError(`Unknown scan compare: ${spec.compare}`);
+  }
+
+  const native = {
+    type,
+    compare,
+    value: type === scanTypes.pointer && spec.value !== undefined ? BigInt(spec.value) : spec.value,
+    epsilon: spec.epsilon ?? 0.0001,
+    alignment: spec.alignment ?? scanDefaultAlignment[type],
+    writableOnly: spec.writableOnly === true,
+    maxResults: spec.maxResults,
+  };
+  if (spec.start !== undefined) native.start = BigInt(spec.start);
+  if (spec.end !== undefined) native.end = BigInt(spec.end);
+  if (type === scanTypes.pattern) {
+    const { bytes, mask } = parseScanPattern(spec.pattern);
+    native.pattern = bytes;
+    native.mask = mask;
+  }
+  if (spec.previous !== undefined) {
+    native.previous = spec.previous;
+    native.previousValues = scanResults.get(spec.previous)?.values;
+  }
+
+  return binding.scan(native).then(({ hits, values, truncated }) => {
+    scanResults.set(hits, { values, truncated });
+    return hits;
+  });
+}
+
+/**
+ * Details kept for a scan() result.
+ * @param {BigUint64Array} hits - Array returned by scan()
+ * @returns {{values: Uint8Array, truncated: boolean}|undefined} - Bytes matched at each hit, and whether
+ *   maxResults cut the result short
+ */
+function getScanInfo(hits) {
+  return scanResults.get(hits);
+}
+
 // TODO: move game lock to game-lock.js
 
 /**
@@ -930,6 +1274,25 @@ function isGameLockOpen() {
   return binding.isGameLockOpen();
 }
 
+/**
+ * Cap how long one game lock window may stay open. Windows follow recent demand up to this budget and
+ * are skipped entirely on frames where nobody waits for the lock.
+ * @param {number} microseconds - Budget per game frame (default 2000)
+ */
+function setGameLockFrameBudget(microseconds) {
+  binding.setGameLockFrameBudget(microseconds >>> 0);
+}
+
+/**
+ * Game lock contention metrics since startup or the last reset. Wait, timeout and hold times are in
+ * microseconds; utilisation is the fraction of each opened window spent with the lock held.
+ * @param {boolean} [reset=false] - Clear the metrics after reading them
+ * @returns {object|undefined} undefined when running without a game lock
+ */
+function getGameLockStats(reset = false) {
+  return binding.getGameLockStats(reset === true);
+}
+
 /**
  * Execute a function while holding the game lock.
  * Ensures the lock is released even if an error occurs.
@@ -984,6 +1347,131 @@ function tryWithGameLock(fn, timeout = 100) {
   }
 }
 
+/**
+ * Acquire the game lock without blocking the event loop. Timers, fs callbacks and UI frames keep running
+ * while the request waits for the next game lock window. Release with releaseGameLock().
+ *
+ * @param {number} timeout - Give up after this many milliseconds (default: 100)
+ * @returns {Promise<boolean>} - True once the lock is held by this thread, false on timeout
+ *
+ * @example
+ * if (await gameLock()) {
+ *   try {
+ *     data = memory.readMemoryFast(addr, size);
+ *   } finally {
+ *     releaseGameLock();
+ *   }
+ * }
+ */
+function gameLock(timeout = 100) {
+  return new Promise((resolve) => {
+    let timer;
+    const id = binding.requestGameLock((acquired) => {
+      clearTimeout(timer);
+      resolve(acquired);
+    });
+    // A request granted before the timer fires cannot be cancelled and still resolves true.
+    timer = setTimeout(() => binding.cancelGameLockRequest(id), timeout);
+  });
+}
+
+/**
+ * Execute an async function while holding the game lock, acquired without blocking the event loop.
+ * The game thread cannot resume while the lock is held, so the lock is kept across awaits only for
+ * budget milliseconds. After that it is released even if fn is still running; fn can check
+ * lease.held before touching game memory.
+ *
+ * @param {Function} fn - Async function receiving a lease ({ held: boolean })
+ * @param {number} timeout - Timeout in milliseconds to acquire lock (default: 100)
+ * @param {number} budget - Longest time the lock is held, in milliseconds (default: 5)
+ * @returns {Promise<*>} - Resolves to the return value of fn
+ * @throws {Error} - If lock cannot be acquired, or if fn throws
+ *
+ * @example
+ * const player = await withGameLockAsync(async (lease) => {
+ *   const header = memory.readMemoryFast(playerAddr, 16);
+ *   await somethingElse();
+ *   return lease.held ? memory.readMemoryFast(playerAddr + 16n, playerSize) : null;
+ * });
+ */
+async function withGameLockAsync(fn, timeout = 100, budget = 5) {
+  if (!(await gameLock(timeout))) {
+    throw new Error('Failed to acquire game lock');
+  }
+
+  const lease = { held: true };
+  const release = () => {
+    if (lease.held) {
+      lease.held = false;
+      binding.releaseGameLock();
+    }
+  };
+  const timer = setTimeout(release, budget);
+  try {
+    return await fn(lease);
+  } finally {
+    clearTimeout(timer);
+    release();
+  }
+}
+
+/**
+ * A region the game thread copies into the snapshot arena at the start of every game lock window.
+ * Reads come from the last capture and never take the game lock.
+ */
+class SnapshotRegion {
+  constructor(address, size, chain) {
+    const offsets = chain && chain.length > 0 ? BigInt64Array.from(chain, (o) => BigInt(o)) : undefined;
+    this.id = binding.registerSnapshotRegion(BigInt(address), size >>> 0, offsets);
+    this.size = size;
+    this.buffer = new Uint8Array(size);
+  }
+
+  // Copy the captured bytes into dest (default: this.buffer). Returns dest, or null if the region was not
+  // captured (not registered yet at capture time, broken pointer chain or unreadable memory).
+  read(dest = this.buffer) {
+    return binding.readSnapshotRegion(this.id, dest) ? dest : null;
+  }
+
+  dispose() {
+    binding.unregisterSnapshotRegion(this.id);
+  }
+}
+
+/**
+ * Register a region for game-thread snapshot capture.
+ * @param {bigint|number} address - Region address, or base of the pointer chain
+ * @param {number} size - Bytes to capture
+ * @param {{chain?: Array<number|bigint>}} options - With a chain the address is re-resolved on every
+ *   capture as [[address] + chain[0]] + chain[1] ...
+ * @returns {SnapshotRegion}
+ */
+function registerSnapshotRegion(address, size, { chain } = {}) {
+  return new SnapshotRegion(address, size, chain);
+}
+
+let snapshotDepth = 0;
+let pinnedSequence = 0;
+
+/**
+ * Run fn with the newest snapshot pinned, so every SnapshotRegion.read() inside sees the same frame.
+ * @param {Function} fn - Called with the snapshot sequence number (0 if nothing was captured yet)
+ * @returns {*} - Return value of fn
+ */
+function withSnapshot(fn) {
+  if (snapshotDepth > 0) {
+    return fn(pinnedSequence);
+  }
+  pinnedSequence = binding.pinSnapshot();
+  snapshotDepth++;
+  try {
+    return fn(pinnedSequence);
+  } finally {
+    snapshotDepth--;
+    binding.unpinSnapshot();
+  }
+}
+
 module.exports = {
   MemoryModel,
   DataTypes,
@@ -993,8 +1481,29 @@ module.exports = {
   readMemory: binding.readMemory,
   readMemoryFast: binding.readMemoryFast,
   readMemoryInto: binding.readMemoryInto,
+  readMemoryBatch: binding.readMemoryBatch,
+  readMemoryDiff: (address, buffer, granularity) => binding.readMemoryDiff(BigInt(address), buffer, granularity),
   writeMemory: binding.writeMemory,
 
+  resolvePointerChain,
+  walkList,
+  walkHashBuckets,
+  decodeColumns,
+
+  clearChecksumCache: binding.clearChecksumCache,
+  configureChecksumCache,
+  getChecksumCacheStats: binding.getChecksumCacheStats,
+
+  scan,
+  getScanInfo,
+
+  SnapshotRegion,
+  registerSnapshotRegion,
+  withSnapshot,
+  clearSnapshotRegions: binding.clearSnapshotRegions,
+  captureSnapshot: binding.captureSnapshot,
+  getSnapshotStats: binding.getSnapshotStats,
+
   allocateTestMemory: binding.allocateTestMemory,
   freeTestMemory: binding.freeTestMemory,
   freeAllTestMemory: binding.freeAllTestMemory,
@@ -1004,6 +1513,10 @@ module.exports = {
   releaseGameLock,
   isGameLockHeld,
   isGameLockOpen,
+  setGameLockFrameBudget,
+  getGameLockStats,
   withGameLock,
   tryWithGameLock,
+  gameLock,
+  withGameLockAsync,
 };
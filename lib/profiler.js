@@ -0,0 +1,43 @@
+'use strict';
+
+const { writeFile } = require('fs');
+
+const binding = internalBinding('profiler');
+
+// A CPU profile being recorded. Several can record at once, each at its own interval.
+class Profile {
+  #id;
+
+  constructor(id) {
+    this.#id = id;
+  }
+
+  // Stops recording and returns the profile as .cpuprofile JSON, which DevTools and most profile viewers open.
+  stop() {
+    return binding.stop(this.#id);
+  }
+
+  // Stops recording and writes the .cpuprofile to path.
+  save(path) {
+    return writeFile(path, this.stop());
+  }
+}
+
+function start(options = {}) {
+  return new Profile(binding.start(options.interval));
+}
+
+function setWindow(seconds, options = {}) {
+  binding.setWindow(seconds, options.interval);
+}
+
+function getWindow() {
+  return binding.getWindow();
+}
+
+module.exports = {
+  Profile,
+  start,
+  setWindow,
+  getWindow,
+};
@@ -0,0 +1,20 @@
+'use strict';
+
+const binding = internalBinding('trace');
+
+// The last count frames built (all that are kept by default), oldest first. Times in microseconds.
+function getFrames(count) {
+  return binding.getFrames(count);
+}
+
+// Writes the recorded loop phases, frames and game lock windows as Chrome Trace Event JSON, which
+// chrome://tracing and ui.perfetto.dev open. Returns the path written.
+function writeTrace(path = `trace-${Date.now()}.json`) {
+  binding.writeTrace(path);
+  return path;
+}
+
+module.exports = {
+  getFrames,
+  writeTrace,
+};
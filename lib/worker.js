@@ -0,0 +1,65 @@
+'use strict';
+
+const { EventEmitter } = require('events');
+
+const binding = internalBinding('worker');
+
+const {
+  isMainThread,
+  threadId,
+  postMessageToParent,
+  setMessageHandler,
+  close,
+} = binding;
+
+// Runs filename on its own thread and isolate. Messages are structured clones; ArrayBuffers in transferList move
+// to the receiver and are detached here, SharedArrayBuffers are shared.
+//
+// Events: 'message' (value), 'exit' ()
+class Worker extends EventEmitter {
+  constructor(filename) {
+    super();
+    this._handle = new binding.Worker(filename);
+    this._handle.onmessage = (value) => this.emit('message', value);
+    this._handle.onexit = () => {
+      this._handle = null;
+      this.emit('exit');
+    };
+    this._handle.start();
+  }
+
+  postMessage(value, transferList) {
+    if (this._handle) this._handle.postMessage(value, transferList);
+  }
+
+  terminate() {
+    if (this._handle) this._handle.terminate();
+  }
+}
+
+// The worker's side of the channel, null on the main thread.
+//
+// Events: 'message' (value)
+class ParentPort extends EventEmitter {
+  postMessage(value, transferList) {
+    postMessageToParent(value, transferList);
+  }
+
+  // Stops this worker once the current callback returns.
+  close() {
+    close();
+  }
+}
+
+let parentPort = null;
+if (!isMainThread) {
+  parentPort = new ParentPort();
+  setMessageHandler((value) => parentPort.emit('message', value));
+}
+
+module.exports = {
+  Worker,
+  isMainThread,
+  threadId,
+  parentPort,
+};
@@ -3,6 +3,7 @@
 #include "nyx/env.h"
 #include "nyx/errors.h"
 #include "nyx/extension.h"
+#include "nyx/external_references.h"
 #include "nyx/isolate_data.h"
 #include "nyx/realm.h"
 #include "nyx/util.h"
@@ -24,6 +25,7 @@ using v8::LocalVector;
 using v8::MaybeLocal;
 using v8::Name;
 using v8::None;
+using v8::Number;
 using v8::Object;
 using v8::ObjectTemplate;
 using v8::PropertyCallbackInfo;
@@ -35,6 +37,7 @@ using v8::Value;
 
 BuiltinLoader::BuiltinLoader() {
   LoadJavaScriptSource();
+  LoadCodeCache();
   RegisterExternalBuiltins();
 #ifdef NYX_DEBUG
   prefer_disk_ = true;
@@ -45,8 +48,10 @@ static void SetInternalLoaders(const FunctionCallbackInfo<Value>& args) {
   Realm* realm = Realm::GetCurrent(args);
   CHECK(args[0]->IsFunction());
   CHECK(args[1]->IsFunction());
+  CHECK(args[2]->IsFunction());
   realm->set_internal_binding_loader(args[0].As<Function>());
   realm->set_builtin_module_require(args[1].As<Function>());
+  realm->set_add_builtin_ids(args[2].As<Function>());
 }
 
 void BuiltinLoader::CreatePerIsolateProperties(IsolateData* isolate_data, Local<ObjectTemplate> target) {
@@ -60,12 +65,21 @@ void BuiltinLoader::CreatePerIsolateProperties(IsolateData* isolate_data, Local<
                                 SideEffectType::kHasNoSideEffect);
   SetMethod(isolate, target, "compileFunction", CompileFunction);
   SetMethod(isolate, target, "setInternalLoaders", SetInternalLoaders);
+  SetMethod(isolate, target, "getCodeCacheStats", GetCodeCacheStats);
 }
 
 void BuiltinLoader::CreatePerContextProperties(Local<Object> target, Local<Context> context) {
   target->SetIntegrityLevel(context, IntegrityLevel::kFrozen).FromJust();
 }
 
+void BuiltinLoader::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(BuiltinIdsGetter);
+  registry->Register(CompileFunction);
+  registry->Register(SetInternalLoaders);
+  registry->Register(GetCodeCacheStats);
+  registry->Register(GetInternalBinding);
+}
+
 MaybeLocal<Function> BuiltinLoader::LookupAndCompile(Local<Context> context, const char* id, Realm* optional_realm) {
   Isolate* isolate = context->GetIsolate();
   LocalVector<String> parameters(isolate);
@@ -161,9 +175,27 @@ MaybeLocal<Function> BuiltinLoader::LookupAndCompileInternal(Local<Context> cont
   Local<String> filename = OneByteString(isolate, filename_s);
   ScriptOrigin origin(filename, 0, 0, true);
 
-  ScriptCompiler::Source script_source(source, origin);
-  MaybeLocal<Function> maybe_fun =
-      ScriptCompiler::CompileFunction(context, &script_source, parameters->size(), parameters->data());
+  ScriptCompiler::CachedData* cached_data = nullptr;
+  ScriptCompiler::CompileOptions options = ScriptCompiler::kNoCompileOptions;
+  if (eager_compile_) {
+    options = ScriptCompiler::kEagerCompile;
+  } else if (auto cache_it = code_cache_.find(id); cache_it != code_cache_.end()) {
+    cached_data = new ScriptCompiler::CachedData(cache_it->second.data, static_cast<int>(cache_it->second.length));
+    options = ScriptCompiler::kConsumeCodeCache;
+  }
+
+  // Source takes ownership of cached_data. A rejected cache makes V8 compile from source instead.
+  ScriptCompiler::Source script_source(source, origin, cached_data);
+  MaybeLocal<Function> maybe_fun = ScriptCompiler::CompileFunction(
+      context, &script_source, parameters->size(), parameters->data(), 0, nullptr, options);
+
+  if (!cached_data) {
+    code_cache_stats_.missing++;
+  } else if (script_source.GetCachedData()->rejected) {
+    code_cache_stats_.rejected++;
+  } else {
+    code_cache_stats_.hits++;
+  }
 
   Local<Function> fun;
   if (!maybe_fun.ToLocal(&fun)) {
@@ -173,6 +205,20 @@ MaybeLocal<Function> BuiltinLoader::LookupAndCompileInternal(Local<Context> cont
   return scope.Escape(fun);
 }
 
+std::unique_ptr<ScriptCompiler::CachedData> BuiltinLoader::CreateCodeCache(Local<Context> context, const char* id) {
+  HandleScope scope(context->GetIsolate());
+  // Eager compilation puts every inner function in the cache, not just the ones run during compilation.
+  eager_compile_ = true;
+  MaybeLocal<Function> maybe_fun = LookupAndCompile(context, id, nullptr);
+  eager_compile_ = false;
+
+  Local<Function> fun;
+  if (!maybe_fun.ToLocal(&fun)) {
+    return nullptr;
+  }
+  return std::unique_ptr<ScriptCompiler::CachedData>(ScriptCompiler::CreateCodeCacheForFunction(fun));
+}
+
 void BuiltinLoader::BuiltinIdsGetter(Local<Name> property, const PropertyCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
   Isolate* isolate = env->isolate();
@@ -196,6 +242,22 @@ void BuiltinLoader::CompileFunction(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+void BuiltinLoader::GetCodeCacheStats(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  Local<Context> context = isolate->GetCurrentContext();
+  const CodeCacheStats& stats = env->builtin_loader()->code_cache_stats();
+
+  Local<Object> result = Object::New(isolate);
+  auto set = [&](const char* name, uint64_t value) {
+    result->Set(context, OneByteString(isolate, name), Number::New(isolate, static_cast<double>(value))).Check();
+  };
+  set("hits", stats.hits);
+  set("rejected", stats.rejected);
+  set("missing", stats.missing);
+  args.GetReturnValue().Set(result);
+}
+
 void BuiltinLoader::SetLibPath(const std::string& path) {
   lib_path_ = path;
   if (!lib_path_.empty() && lib_path_.back() != '/' && lib_path_.back() != '\\') {
@@ -214,6 +276,7 @@ void BuiltinLoader::RegisterExternalBuiltins() {
   for (const BuiltinSourceMap* map : source_maps) {
     for (const auto& [id, bytes] : *map) {
       source_[id] = bytes;
+      code_cache_.erase(id);
     }
   }
 
@@ -221,10 +284,12 @@ void BuiltinLoader::RegisterExternalBuiltins() {
   const auto& external_builtins = GetExternalBuiltins();
   for (const auto& builtin : external_builtins) {
     source_[builtin.id] = UnionBytes(builtin.source);
+    code_cache_.erase(builtin.id);
   }
 }
 
 NYX_BINDING_PER_ISOLATE_INIT(builtins, BuiltinLoader::CreatePerIsolateProperties)
 NYX_BINDING_CONTEXT_AWARE(builtins, BuiltinLoader::CreatePerContextProperties)
+NYX_BINDING_EXTERNAL_REFERENCE(builtins, BuiltinLoader::RegisterExternalReferences)
 
 }  // namespace nyx
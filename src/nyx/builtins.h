@@ -2,7 +2,9 @@
 
 #include "nyx/union_bytes.h"
 
+#include <cstdint>
 #include <map>
+#include <memory>
 #include <ranges>
 #include <string>
 #include <string_view>
@@ -10,11 +12,20 @@
 
 namespace nyx {
 
-class Realm;
+class ExternalReferenceRegistry;
 class IsolateData;
+class Realm;
 
 using BuiltinSourceMap = std::map<std::string, UnionBytes>;
 
+// V8 code cache for one embedded builtin, generated at build time by nyx_mkcodecache.
+struct BuiltinCodeCache {
+  const uint8_t* data;
+  size_t length;
+};
+
+using BuiltinCodeCacheMap = std::map<std::string, BuiltinCodeCache>;
+
 // Builtin source registry
 // In release builds, sources are embedded via js2c
 // In debug builds, sources can be loaded from disk for hot-reload
@@ -28,6 +39,7 @@ class BuiltinLoader {
 
   static void CreatePerIsolateProperties(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
   static void CreatePerContextProperties(v8::Local<v8::Object> target, v8::Local<v8::Context> context);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   v8::MaybeLocal<v8::Function> LookupAndCompile(v8::Local<v8::Context> context, const char* id, Realm* optional_realm);
   v8::MaybeLocal<v8::Function> LookupAndCompile(v8::Local<v8::Context> context,
@@ -51,9 +63,21 @@ class BuiltinLoader {
   // Register external builtins (called during initialization)
   void RegisterExternalBuiltins();
 
+  struct CodeCacheStats {
+    uint64_t hits;      // compiled from the embedded code cache
+    uint64_t rejected;  // had a code cache that V8 rejected, compiled from source
+    uint64_t missing;   // had no code cache, compiled from source
+  };
+  const CodeCacheStats& code_cache_stats() const { return code_cache_stats_; }
+
+  // Compiles id eagerly and serializes the result, for nyx_mkcodecache.
+  std::unique_ptr<v8::ScriptCompiler::CachedData> CreateCodeCache(v8::Local<v8::Context> context, const char* id);
+
  private:
   // Generated by js2c.cc in compiled_builtins.cc
   void LoadJavaScriptSource();
+  // Generated by nyx_mkcodecache in compiled_code_cache.cc, or empty in code_cache_stub.cc
+  void LoadCodeCache();
 
   v8::MaybeLocal<v8::String> LoadBuiltinSource(v8::Isolate* isolate, const char* id) const;
   v8::MaybeLocal<v8::Function> LookupAndCompileInternal(v8::Local<v8::Context> context,
@@ -63,10 +87,16 @@ class BuiltinLoader {
 
   static void BuiltinIdsGetter(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value>& args);
   static void CompileFunction(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void GetCodeCacheStats(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   // Embedded sources (generated by js2c and loaded by LoadJavaScriptSource)
   BuiltinSourceMap source_;
 
+  // Code cache of the embedded sources, dropped for ids an extension overrides
+  BuiltinCodeCacheMap code_cache_;
+  CodeCacheStats code_cache_stats_ = {};
+  bool eager_compile_ = false;
+
   // Disk-loaded sources cache (for development)
   std::unordered_map<std::string, std::string> disk_sources_;
 
@@ -0,0 +1,85 @@
+#include "nyx/checksum_cache.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace nyx {
+
+static size_t Hash(uint64_t address, uint32_t size) {
+  uint64_t h = address ^ (static_cast<uint64_t>(size) << 48);
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  return static_cast<size_t>(h);
+}
+
+ChecksumCache::ChecksumCache(size_t capacity, uint32_t max_age) : max_age_(max_age) {
+  Reconfigure(capacity, max_age);
+}
+
+bool ChecksumCache::Update(uint64_t address, uint32_t size, uint32_t checksum) {
+  size_t home = Hash(address, size);
+  Entry* victim = nullptr;
+
+  for (size_t i = 0; i < kProbeWindow; i++) {
+    Entry& entry = entries_[(home + i) & mask_];
+
+    if (entry.size == 0) {
+      // Slots are only emptied all at once, so nothing past a hole belongs to this key.
+      misses_++;
+      entry = {address, size, checksum, frame_};
+      return false;
+    }
+
+    if (entry.address == address && entry.size == size) {
+      bool unchanged = false;
+      if (Age(entry) > max_age_) {
+        misses_++;
+        evictions_++;
+      } else {
+        hits_++;
+        unchanged = entry.checksum == checksum;
+      }
+      entry.checksum = checksum;
+      entry.frame = frame_;
+      return unchanged;
+    }
+
+    if (victim == nullptr || Age(entry) > Age(*victim)) {
+      victim = &entry;
+    }
+  }
+
+  misses_++;
+  evictions_++;
+  *victim = {address, size, checksum, frame_};
+  return false;
+}
+
+void ChecksumCache::Clear() {
+  std::fill(entries_.begin(), entries_.end(), Entry{});
+}
+
+void ChecksumCache::Reconfigure(size_t capacity, uint32_t max_age) {
+  capacity = std::bit_ceil(std::clamp(capacity, kMinCapacity, kMaxCapacity));
+  entries_.assign(capacity, Entry{});
+  entries_.shrink_to_fit();
+  mask_ = capacity - 1;
+  max_age_ = max_age;
+}
+
+ChecksumCache::Stats ChecksumCache::stats() const {
+  // Expired entries keep their slot until reused, so count the live ones.
+  size_t size = static_cast<size_t>(std::count_if(entries_.begin(), entries_.end(), [this](const Entry& entry) {
+    return entry.size != 0 && Age(entry) <= max_age_;
+  }));
+  return {hits_, misses_, evictions_, size, entries_.size(), max_age_, frame_};
+}
+
+void ChecksumCache::ResetStats() {
+  hits_ = 0;
+  misses_ = 0;
+  evictions_ = 0;
+}
+
+}  // namespace nyx
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nyx {
+
+// Fixed-capacity open-addressing table mapping (address, size) to the checksum of the last read.
+// Lookups probe a small window of slots; when the window is full the least recently touched entry is replaced.
+// Entries not touched for max_age frames count as missing and are dropped on their next lookup.
+class ChecksumCache {
+ public:
+  static constexpr size_t kDefaultCapacity = 1 << 15;
+  static constexpr size_t kMinCapacity = 64;
+  static constexpr size_t kMaxCapacity = 1 << 24;
+  static constexpr uint32_t kDefaultMaxAge = 300;
+
+  struct Stats {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t evictions;
+    size_t size;  // live entries
+    size_t capacity;
+    uint32_t max_age;
+    uint32_t frame;
+  };
+
+  explicit ChecksumCache(size_t capacity = kDefaultCapacity, uint32_t max_age = kDefaultMaxAge);
+
+  ChecksumCache(const ChecksumCache&) = delete;
+  ChecksumCache& operator=(const ChecksumCache&) = delete;
+
+  // Stores checksum for (address, size). Returns true if a live entry already held the same checksum.
+  bool Update(uint64_t address, uint32_t size, uint32_t checksum);
+
+  void AdvanceFrame() { frame_++; }
+
+  // Drops every entry. Counters are kept.
+  void Clear();
+
+  // Resizes the table (rounded up to a power of two) and drops every entry.
+  void Reconfigure(size_t capacity, uint32_t max_age);
+
+  Stats stats() const;
+  void ResetStats();
+
+ private:
+  static constexpr size_t kProbeWindow = 8;
+
+  // size == 0 marks an empty slot; cached regions are always larger than 8 bytes.
+  struct Entry {
+    uint64_t address;
+    uint32_t size;
+    uint32_t checksum;
+    uint32_t frame;
+  };
+
+  uint32_t Age(const Entry& entry) const { return frame_ - entry.frame; }
+
+  std::vector<Entry> entries_;
+  size_t mask_ = 0;
+  uint32_t max_age_;
+  uint32_t frame_ = 0;
+
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+  uint64_t evictions_ = 0;
+};
+
+}  // namespace nyx
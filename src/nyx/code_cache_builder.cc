@@ -0,0 +1,99 @@
+#include "nyx/code_cache_builder.h"
+
+#include "nyx/builtins.h"
+
+#include <v8.h>
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nyx {
+
+using v8::ArrayBuffer;
+using v8::Context;
+using v8::HandleScope;
+using v8::Isolate;
+using v8::Local;
+using v8::ScriptCompiler;
+
+namespace {
+
+struct CompiledCache {
+  std::string id;
+  std::unique_ptr<ScriptCompiler::CachedData> data;
+};
+
+bool WriteCodeCacheSource(const std::string& out_path, const std::vector<CompiledCache>& caches) {
+  FILE* out = fopen(out_path.c_str(), "wb");
+  if (!out) {
+    fprintf(stderr, "Cannot open %s for writing\n", out_path.c_str());
+    return false;
+  }
+
+  fprintf(out, "// Generated by nyx_mkcodecache, do not edit.\n\n");
+  fprintf(out, "#include \"nyx/builtins.h\"\n\n");
+  fprintf(out, "namespace nyx {\n");
+  for (size_t i = 0; i < caches.size(); i++) {
+    const ScriptCompiler::CachedData* data = caches[i].data.get();
+    fprintf(out, "\n// %s\n", caches[i].id.c_str());
+    fprintf(out, "static const uint8_t code_cache_%zu[] = {", i);
+    for (int j = 0; j < data->length; j++) {
+      fprintf(out, "%s%u,", j % 32 == 0 ? "\n  " : "", data->data[j]);
+    }
+    fprintf(out, "\n};\n");
+  }
+  fprintf(out, "\nvoid BuiltinLoader::LoadCodeCache() {\n");
+  fprintf(out, "  code_cache_ = {\n");
+  for (size_t i = 0; i < caches.size(); i++) {
+    fprintf(out, "    {\"%s\", {code_cache_%zu, sizeof(code_cache_%zu)}},\n", caches[i].id.c_str(), i, i);
+  }
+  fprintf(out, "  };\n");
+  fprintf(out, "}\n\n");
+  fprintf(out, "}  // namespace nyx\n");
+
+  bool ok = ferror(out) == 0;
+  ok = fclose(out) == 0 && ok;
+  if (!ok) {
+    fprintf(stderr, "Failed to write %s\n", out_path.c_str());
+  }
+  return ok;
+}
+
+}  // namespace
+
+int CodeCacheBuilder::Generate(const std::string& out_path) {
+  std::unique_ptr<ArrayBuffer::Allocator> allocator(ArrayBuffer::Allocator::NewDefaultAllocator());
+  Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = allocator.get();
+  Isolate* isolate = Isolate::New(create_params);
+
+  std::vector<CompiledCache> caches;
+  bool ok = true;
+  {
+    Isolate::Scope isolate_scope(isolate);
+    HandleScope handle_scope(isolate);
+    Local<Context> context = Context::New(isolate);
+    Context::Scope context_scope(context);
+
+    BuiltinLoader loader;
+    for (const std::string& id : loader.GetBuiltinIds()) {
+      std::unique_ptr<ScriptCompiler::CachedData> data = loader.CreateCodeCache(context, id.c_str());
+      if (!data) {
+        fprintf(stderr, "Failed to compile %s\n", id.c_str());
+        ok = false;
+        break;
+      }
+      caches.push_back({id, std::move(data)});
+    }
+  }
+  isolate->Dispose();
+
+  if (!ok || !WriteCodeCacheSource(out_path, caches)) {
+    return 1;
+  }
+  return 0;
+}
+
+}  // namespace nyx
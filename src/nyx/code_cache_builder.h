@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string>
+
+namespace nyx {
+
+// Compiles every embedded builtin and writes their V8 code caches to a C++ source defining
+// BuiltinLoader::LoadCodeCache. BuiltinLoader consumes them instead of parsing and compiling the sources.
+//
+// A cache only applies to the V8 version and flags it was generated with; V8 rejects it otherwise and the
+// builtin is compiled from source, counted in BuiltinLoader::CodeCacheStats.
+class CodeCacheBuilder {
+ public:
+  // Requires Initialize(). Returns a process exit code.
+  static int Generate(const std::string& out_path);
+};
+
+}  // namespace nyx
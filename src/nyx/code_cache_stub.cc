@@ -0,0 +1,7 @@
+#include "nyx/builtins.h"
+
+namespace nyx {
+
+void BuiltinLoader::LoadCodeCache() {}
+
+}  // namespace nyx
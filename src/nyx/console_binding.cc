@@ -1,3 +1,4 @@
+#include "nyx/external_references.h"
 #include "nyx/isolate_data.h"
 #include "nyx/nyx.h"
 #include "nyx/nyx_binding.h"
@@ -88,7 +89,13 @@ static void CreatePerIsolateProperties(IsolateData* isolate_data, Local<ObjectTe
 
 static void CreatePerContextProperties(Local<Object> target, Local<v8::Context> context) {}
 
+static void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(Write);
+  registry->Register(GetStackTrace);
+}
+
 NYX_BINDING_PER_ISOLATE_INIT(console, CreatePerIsolateProperties)
 NYX_BINDING_CONTEXT_AWARE(console, CreatePerContextProperties)
+NYX_BINDING_EXTERNAL_REFERENCE(console, RegisterExternalReferences)
 
 }  // namespace nyx
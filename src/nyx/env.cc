@@ -1,9 +1,19 @@
 #include "nyx/env.h"
 
+#include "nyx/checksum_cache.h"
+#include "nyx/frame_scheduler.h"
+#include "nyx/frame_timeline.h"
+#include "nyx/game_lock.h"
+#include "nyx/gc_scheduler.h"
 #include "nyx/gui/widget_manager.h"
+#include "nyx/module_code_cache.h"
 #include "nyx/module_wrap.h"
 #include "nyx/nyx_imgui.h"
+#include "nyx/package_watchdog.h"
+#include "nyx/profiler.h"
+#include "nyx/snapshot_arena.h"
 #include "nyx/timers.h"
+#include "nyx/worker.h"
 
 namespace nyx {
 
@@ -14,20 +24,60 @@ using v8::Local;
 using v8::MaybeLocal;
 using v8::Value;
 
+static void CloseWalkCallback(uv_handle_t* handle, void* arg) {
+  if (!uv_is_closing(handle)) {
+    uv_close(handle, nullptr);
+  }
+}
+
+void CloseAllHandles(uv_loop_t* loop) {
+  uv_walk(loop, CloseWalkCallback, nullptr);
+}
+
+void CloseEventLoop(uv_loop_t* loop) {
+  CloseAllHandles(loop);
+  while (uv_loop_alive(loop)) {
+    uv_run(loop, UV_RUN_ONCE);
+  }
+}
+
 Environment::Environment(IsolateData* isolate_data,
                          v8::Isolate* isolate,
                          const std::string_view script_path,
                          NyxImGui* nyx_imgui,
-                         GameLock* game_lock)
+                         GameLock* game_lock,
+                         Worker* worker)
     : isolate_data_(isolate_data),
       isolate_(isolate),
       nyx_imgui_(nyx_imgui),
       game_lock_(game_lock),
+      worker_(worker),
       scripts_root_(script_path) {
   Isolate::Scope isolate_scope(isolate_);
 
   // Must exist before bootstrapping so timer binding callbacks can access it.
   timer_registry_ = std::make_unique<TimerRegistry>(this);
+  package_watchdog_ = std::make_unique<PackageWatchdog>(this);
+  checksum_cache_ = std::make_unique<ChecksumCache>();
+  snapshot_arena_ = std::make_unique<SnapshotArena>();
+  if (game_lock_) {
+    game_lock_->SetSnapshotArena(snapshot_arena_.get());
+  }
+
+  threadsafe_immediates_ = std::make_shared<ThreadsafeImmediateQueue>();
+  uv_async_t* async = new uv_async_t;
+  uv_async_init(event_loop(), async, [](uv_async_t* handle) {
+    static_cast<Environment*>(handle->data)->RunThreadsafeImmediates();
+  });
+  async->data = this;
+  threadsafe_immediates_->async_ = async;
+  threadsafe_async_ = async;
+
+  frame_scheduler_ = std::make_unique<FrameScheduler>(event_loop(), nyx_imgui_);
+  frame_timeline_ = std::make_unique<FrameTimeline>(event_loop());
+  gc_scheduler_ = std::make_unique<GcScheduler>(isolate_);
+  module_code_cache_ = std::make_unique<ModuleCodeCache>(event_loop(), isolate_, scripts_root_);
+  profiler_ = std::make_unique<Profiler>(this);
 
   if (nyx_imgui_) {
     draw_context_ = std::make_unique<ImGuiDrawContext>(nyx_imgui_);
@@ -39,10 +89,55 @@ Environment::Environment(IsolateData* isolate_data,
 }
 
 Environment::~Environment() {
+  Stop();
+  frame_scheduler_.reset();
+
+  uv_async_t* async = threadsafe_async_;
+  if (uv_is_closing(reinterpret_cast<uv_handle_t*>(async))) {
+    // Already closed by CloseEventLoop, which has run the loop to completion by now.
+    delete async;
+  } else {
+    uv_close(reinterpret_cast<uv_handle_t*>(async),
+             [](uv_handle_t* handle) { delete reinterpret_cast<uv_async_t*>(handle); });
+  }
+
+  if (game_lock_) {
+    game_lock_->SetSnapshotArena(nullptr);
+    // Nobody is left to release what this thread holds or is about to be granted.
+    game_lock_->CancelAsync(this);
+    game_lock_->ReleaseIfOwned();
+  }
+
   timer_registry_->CloseAll();
   widget_manager_.reset();
   draw_context_.reset();
   principal_realm_.reset();
+  module_code_cache_.reset();
+  gc_scheduler_.reset();
+  package_watchdog_.reset();
+  profiler_.reset();
+  frame_timeline_.reset();
+}
+
+void Environment::Stop() {
+  stopped_ = true;
+
+  // The renderer and window threads signal the scheduler's wakeup handle.
+  if (frame_scheduler_) {
+    frame_scheduler_->Detach();
+  }
+
+  // Their exit notifications would arrive at a queue that is about to go away.
+  for (Worker* worker : workers_) {
+    worker->TerminateAndJoin();
+    delete worker;
+  }
+  workers_.clear();
+
+  // Post() checks async_ under the mutex, so nothing signals the handle after this.
+  std::lock_guard<std::mutex> lock(threadsafe_immediates_->mutex_);
+  threadsafe_immediates_->async_ = nullptr;
+  threadsafe_immediates_->pending_.clear();
 }
 
 Environment* Environment::GetCurrent(v8::Isolate* isolate) {
@@ -64,6 +159,38 @@ Local<Context> Environment::context() const {
   return principal_realm_->context();
 }
 
+bool ThreadsafeImmediateQueue::Post(Callback callback) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (async_ == nullptr) {
+    return false;
+  }
+  pending_.push_back(std::move(callback));
+  uv_async_send(async_);
+  return true;
+}
+
+void Environment::SetImmediateThreadsafe(ThreadsafeImmediateQueue::Callback callback) {
+  threadsafe_immediates_->Post(std::move(callback));
+}
+
+void Environment::RunThreadsafeImmediates() {
+  std::vector<ThreadsafeImmediateQueue::Callback> callbacks;
+  {
+    std::lock_guard<std::mutex> lock(threadsafe_immediates_->mutex_);
+    callbacks.swap(threadsafe_immediates_->pending_);
+  }
+
+  v8::HandleScope handle_scope(isolate_);
+  Context::Scope context_scope(context());
+  for (auto& callback : callbacks) {
+    // A callback that stopped the environment has deleted the workers the rest may refer to.
+    if (stopped_) {
+      break;
+    }
+    callback(this);
+  }
+}
+
 void Environment::RegisterModule(int identity_hash, ModuleWrap* wrap) {
   module_registry_[identity_hash] = wrap;
 }
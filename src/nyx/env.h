@@ -5,17 +5,53 @@
 #include "nyx/isolate_data.h"
 #include "nyx/realm.h"
 
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace nyx {
 
+class ChecksumCache;
+class FrameScheduler;
+class FrameTimeline;
 class GameLock;
+class GcScheduler;
+class ModuleCodeCache;
 class ModuleWrap;
 class NyxImGui;
+class PackageWatchdog;
+class Profiler;
+class SnapshotArena;
 class TimerRegistry;
 class WidgetManager;
+class Worker;
+
+class Environment;
+
+// Callbacks posted from other threads to run on the event loop thread. Producers may keep a reference
+// past the environment's lifetime; once the environment is gone Post() drops the callback and returns false.
+class ThreadsafeImmediateQueue {
+ public:
+  using Callback = std::function<void(Environment*)>;
+
+  bool Post(Callback callback);
+
+ private:
+  friend class Environment;
+
+  std::mutex mutex_;
+  std::vector<Callback> pending_;
+  uv_async_t* async_ = nullptr;  // null once the environment is torn down
+};
+
+// Starts closing every handle on loop. uv_run returns once their close callbacks have run.
+void CloseAllHandles(uv_loop_t* loop);
+// Closes every handle on loop and runs it until nothing is left.
+void CloseEventLoop(uv_loop_t* loop);
 
 enum ContextEmbedderIndex {
   kEnvironment = 1 << 0,
@@ -28,7 +64,8 @@ class Environment {
               v8::Isolate* isolate,
               const std::string_view script_path,
               NyxImGui* nyx_imgui,
-              GameLock* game_lock = nullptr);
+              GameLock* game_lock = nullptr,
+              Worker* worker = nullptr);
   ~Environment();
 
   Environment(const Environment&) = delete;
@@ -36,6 +73,11 @@ class Environment {
   Environment(Environment&&) = delete;
   Environment& operator=(Environment&&) = delete;
 
+  // Terminates and joins the workers and detaches the threadsafe immediates and the frame scheduler, so no other
+  // thread signals the loop's handles once they start closing. Call before anything closes them, i.e. before
+  // CloseEventLoop or CloseAllHandles; the destructor calls it otherwise. Idempotent.
+  void Stop();
+
   static Environment* GetCurrent(v8::Isolate* isolate);
   static Environment* GetCurrent(v8::Local<v8::Context> context);
   static Environment* GetCurrent(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -57,6 +99,25 @@ class Environment {
   GameLock* game_lock() const { return game_lock_; }
   WidgetManager* widget_manager() const { return widget_manager_.get(); }
   TimerRegistry& timer_registry() { return *timer_registry_; }
+  ChecksumCache& checksum_cache() { return *checksum_cache_; }
+  SnapshotArena& snapshot_arena() { return *snapshot_arena_; }
+  FrameScheduler& frame_scheduler() { return *frame_scheduler_; }
+  FrameTimeline& frame_timeline() { return *frame_timeline_; }
+  GcScheduler& gc_scheduler() { return *gc_scheduler_; }
+  ModuleCodeCache& module_code_cache() { return *module_code_cache_; }
+  PackageWatchdog& package_watchdog() { return *package_watchdog_; }
+  Profiler& profiler() { return *profiler_; }
+
+  // The Worker this environment runs for, null on the main thread.
+  Worker* worker() const { return worker_; }
+  // Workers started from this environment and still running. Terminated and joined on teardown.
+  void AddWorker(Worker* worker) { workers_.insert(worker); }
+  void RemoveWorker(Worker* worker) { workers_.erase(worker); }
+
+  // Runs callback on the event loop thread during its next iteration. Safe to call from any thread.
+  void SetImmediateThreadsafe(ThreadsafeImmediateQueue::Callback callback);
+  // For producers that may outlive this environment.
+  std::shared_ptr<ThreadsafeImmediateQueue> threadsafe_immediates() const { return threadsafe_immediates_; }
 
   void RegisterModule(int identity_hash, ModuleWrap* wrap);
   void UnregisterModule(int identity_hash);
@@ -89,16 +150,31 @@ class Environment {
   v8::Global<v8::Module> temporary_required_module_facade_original;
 
  private:
+  void RunThreadsafeImmediates();
+
   IsolateData* isolate_data_;
   v8::Isolate* isolate_;
   NyxImGui* nyx_imgui_;
   GameLock* game_lock_;
+  Worker* worker_;
   BuiltinLoader builtin_loader_;
   std::unique_ptr<TimerRegistry> timer_registry_;
+  std::unique_ptr<ChecksumCache> checksum_cache_;
+  std::unique_ptr<SnapshotArena> snapshot_arena_;
+  std::unique_ptr<FrameScheduler> frame_scheduler_;
+  std::unique_ptr<FrameTimeline> frame_timeline_;
+  std::unique_ptr<GcScheduler> gc_scheduler_;
+  std::unique_ptr<ModuleCodeCache> module_code_cache_;
+  std::unique_ptr<PackageWatchdog> package_watchdog_;
+  std::unique_ptr<Profiler> profiler_;
+  std::shared_ptr<ThreadsafeImmediateQueue> threadsafe_immediates_;
+  uv_async_t* threadsafe_async_ = nullptr;
+  bool stopped_ = false;
   std::unique_ptr<PrincipalRealm> principal_realm_;
   std::unique_ptr<ImGuiDrawContext> draw_context_;
   std::unique_ptr<WidgetManager> widget_manager_;
   std::unordered_map<int, ModuleWrap*> module_registry_;
+  std::unordered_set<Worker*> workers_;
   std::string scripts_root_;
 };
 
@@ -13,6 +13,7 @@ namespace nyx {
   V(ERR_FILE_NOT_FOUND, "Cannot find file: %s")                                                                        \
   V(ERR_FILE_READ_FAILED, "Failed to read file: %s")                                                                   \
   V(ERR_INVALID_ARG_TYPE, "Invalid argument type: expected %s")                                                        \
+  V(ERR_INVALID_ARG_VALUE, "Invalid argument value: %s")                                                               \
   V(ERR_INVALID_STATE, "Invalid state: %s")                                                                            \
   V(ERR_MISSING_ARGS, "Missing required argument: %s")                                                                 \
   V(ERR_OUT_OF_RANGE, "Value out of range: %s")                                                                        \
@@ -5,7 +5,6 @@
 
 #include <fstream>
 #include <sstream>
-#include <unordered_map>
 
 namespace nyx {
 
@@ -17,8 +16,6 @@ static std::vector<ExternalBinding> g_external_bindings;
 static std::vector<ExternalBuiltin> g_external_builtins;
 static std::vector<const BuiltinSourceMap*> g_external_source_maps;
 
-static std::unordered_map<std::string, v8::Global<ObjectTemplate>> g_external_templates;
-
 void RegisterBinding(const std::string& name, BindingInitCallback isolate_init, BindingContextCallback context_init) {
   g_external_bindings.push_back({name, isolate_init, context_init});
 }
@@ -61,15 +58,8 @@ void CreateExternalBindingTemplates(IsolateData* isolate_data) {
     Local<ObjectTemplate> templ = ObjectTemplate::New(isolate);
     templ->SetInternalFieldCount(BaseObject::kInternalFieldCount);
     binding.isolate_init(isolate_data, templ);
-    g_external_templates[binding.name].Reset(isolate, templ);
-  }
-}
-
-void CleanupExternalBindings() {
-  for (auto& pair : g_external_templates) {
-    pair.second.Reset();
+    isolate_data->set_external_binding_template(binding.name, templ);
   }
-  g_external_templates.clear();
 }
 
 const ExternalBinding* FindExternalBinding(const std::string& name) {
@@ -81,12 +71,4 @@ const ExternalBinding* FindExternalBinding(const std::string& name) {
   return nullptr;
 }
 
-Local<ObjectTemplate> GetExternalBindingTemplate(v8::Isolate* isolate, const std::string& name) {
-  auto it = g_external_templates.find(name);
-  if (it != g_external_templates.end()) {
-    return it->second.Get(isolate);
-  }
-  return Local<ObjectTemplate>();
-}
-
 }  // namespace nyx
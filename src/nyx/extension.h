@@ -88,9 +88,6 @@ const std::vector<const BuiltinSourceMap*>& GetExternalBuiltinSourceMaps();
 // Initialize external binding templates (called by CreateInternalBindingTemplates)
 void CreateExternalBindingTemplates(IsolateData* isolate_data);
 
-// Cleanup external binding templates (called by ~IsolateData)
-void CleanupExternalBindings();
-
 // Find an external binding by name
 const ExternalBinding* FindExternalBinding(const std::string& name);
 
@@ -0,0 +1,26 @@
+#include "nyx/external_references.h"
+
+#include "nyx/realm.h"
+
+namespace nyx {
+
+#define V(name) void _register_external_reference_##name(ExternalReferenceRegistry* registry);
+NYX_BINDINGS_WITH_PER_ISOLATE_INIT(V)
+#undef V
+
+ExternalReferenceRegistry::ExternalReferenceRegistry() {
+#define V(name) _register_external_reference_##name(this);
+  NYX_BINDINGS_WITH_PER_ISOLATE_INIT(V)
+#undef V
+
+  Realm::RegisterExternalReferences(this);
+
+  external_references_.push_back(0);
+}
+
+const ExternalReferenceRegistry& ExternalReferenceRegistry::Get() {
+  static const ExternalReferenceRegistry registry;
+  return registry;
+}
+
+}  // namespace nyx
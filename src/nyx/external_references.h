@@ -0,0 +1,55 @@
+#pragma once
+
+#include "nyx/nyx_binding.h"
+
+#include <v8.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace nyx {
+
+// Every native callback a template can reach. A startup snapshot stores callbacks as indices into this table, so
+// the snapshot builder and the isolate deserializing its blob must produce it identically; registration order is
+// fixed by NYX_BINDINGS_WITH_PER_ISOLATE_INIT. A callback missing from here makes SnapshotCreator::CreateBlob
+// abort with "Unknown external reference" while building the snapshot, never at runtime.
+class ExternalReferenceRegistry {
+ public:
+  ExternalReferenceRegistry();
+
+  ExternalReferenceRegistry(const ExternalReferenceRegistry&) = delete;
+  ExternalReferenceRegistry& operator=(const ExternalReferenceRegistry&) = delete;
+
+#define ALLOWED_EXTERNAL_REFERENCE_TYPES(V)                                                                            \
+  V(v8::FunctionCallback)                                                                                              \
+  V(v8::AccessorNameGetterCallback)                                                                                    \
+  V(v8::AccessorNameSetterCallback)
+
+#define V(ExternalReferenceType)                                                                                       \
+  void Register(ExternalReferenceType addr) {                                                                          \
+    RegisterT(addr);                                                                                                   \
+  }
+  ALLOWED_EXTERNAL_REFERENCE_TYPES(V)
+#undef V
+
+  // Null terminated, as Isolate::CreateParams::external_references expects.
+  const intptr_t* external_references() const { return external_references_.data(); }
+
+  // The table shared by every isolate this process creates.
+  static const ExternalReferenceRegistry& Get();
+
+ private:
+  template <typename T>
+  void RegisterT(T* address) {
+    external_references_.push_back(reinterpret_cast<intptr_t>(address));
+  }
+
+  std::vector<intptr_t> external_references_;
+};
+
+#define NYX_BINDING_EXTERNAL_REFERENCE(name, func)                                                                     \
+  void _register_external_reference_##name(ExternalReferenceRegistry* registry) {                                      \
+    func(registry);                                                                                                    \
+  }
+
+}  // namespace nyx
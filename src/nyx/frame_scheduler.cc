@@ -0,0 +1,141 @@
+#include "nyx/frame_scheduler.h"
+
+#include "nyx/nyx_imgui.h"
+
+namespace nyx {
+
+FrameScheduler::FrameScheduler(uv_loop_t* loop, NyxImGui* nyx_imgui) : nyx_imgui_(nyx_imgui) {
+  uv_timer_init(loop, &timer_);
+  timer_.data = this;
+  uv_async_init(loop, &wakeup_async_, OnWakeup);
+  wakeup_async_.data = this;
+
+  Configure(kDefaultRate, nyx_imgui_ != nullptr);
+
+  if (nyx_imgui_) {
+    nyx_imgui_->SetFrameConsumedCallback([this]() {
+      consumed_.store(true, std::memory_order_release);
+      uv_async_send(&wakeup_async_);
+    });
+    nyx_imgui_->SetInputCallback([this]() {
+      input_.store(true, std::memory_order_release);
+      uv_async_send(&wakeup_async_);
+    });
+  }
+}
+
+FrameScheduler::~FrameScheduler() {
+  Detach();
+}
+
+void FrameScheduler::Detach() {
+  if (nyx_imgui_) {
+    // Blocks until a callback running on the renderer or window thread has returned.
+    nyx_imgui_->SetFrameConsumedCallback(nullptr);
+    nyx_imgui_->SetInputCallback(nullptr);
+  }
+}
+
+void FrameScheduler::Configure(double rate, bool renderer_paced) {
+  rate_ = rate;
+  renderer_paced_ = renderer_paced && nyx_imgui_ != nullptr;
+  min_interval_ = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rate));
+  if (!building_ && !due_) {
+    ArmTimer(last_frame_start_ + min_interval_);
+  }
+}
+
+bool FrameScheduler::ShouldBuildFrame() {
+  if (!due_) {
+    stats_.idle_iterations++;
+    return false;
+  }
+
+  due_ = false;
+  building_ = true;
+  frame_start_ = Clock::now();
+  if (stats_.frames > 0) {
+    stats_.interval.Record(
+        static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(frame_start_ - last_frame_start_)
+                                  .count()));
+  }
+  last_frame_start_ = frame_start_;
+  // Only a consumption of the frame built now counts for the next one, and this frame takes all input.
+  consumed_.store(false, std::memory_order_relaxed);
+  input_.store(false, std::memory_order_relaxed);
+  return true;
+}
+
+void FrameScheduler::FrameBuilt() {
+  building_ = false;
+  stats_.frames++;
+  stats_.build.Record(static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - frame_start_).count()));
+  ArmTimer(frame_start_ + min_interval_);
+}
+
+void FrameScheduler::ResetStats() {
+  stats_.frames = 0;
+  stats_.idle_iterations = 0;
+  stats_.renderer_frames = 0;
+  stats_.input_frames = 0;
+  stats_.build.Reset();
+  stats_.interval.Reset();
+}
+
+void FrameScheduler::OnTimer(uv_timer_t* handle) {
+  static_cast<FrameScheduler*>(handle->data)->CheckDue();
+}
+
+void FrameScheduler::OnWakeup(uv_async_t* handle) {
+  static_cast<FrameScheduler*>(handle->data)->CheckDue();
+}
+
+void FrameScheduler::CheckDue() {
+  if (due_ || building_) {
+    return;
+  }
+
+  auto now = Clock::now();
+  auto earliest = last_frame_start_ + min_interval_;
+  if (now < earliest) {
+    // Early consumption, or the timer fired early off the loop's cached time.
+    ArmTimer(earliest);
+    return;
+  }
+
+  if (!renderer_paced_) {
+    due_ = true;
+    return;
+  }
+
+  if (input_.load(std::memory_order_acquire)) {
+    stats_.input_frames++;
+    due_ = true;
+    return;
+  }
+
+  if (consumed_.load(std::memory_order_acquire)) {
+    stats_.renderer_frames++;
+    due_ = true;
+    return;
+  }
+
+  auto latest = last_frame_start_ + kMaxFrameInterval;
+  if (now >= latest) {
+    due_ = true;
+    return;
+  }
+  ArmTimer(latest);
+}
+
+void FrameScheduler::ArmTimer(Clock::time_point when) {
+  if (uv_is_closing(reinterpret_cast<uv_handle_t*>(&timer_))) {
+    return;
+  }
+  // uv timers have millisecond resolution; round up rather than wake just before when.
+  auto delay = std::chrono::ceil<std::chrono::milliseconds>(when - Clock::now()).count();
+  uv_timer_start(&timer_, OnTimer, delay > 0 ? static_cast<uint64_t>(delay) : 0, 0);
+}
+
+}  // namespace nyx
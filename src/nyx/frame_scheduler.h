@@ -0,0 +1,90 @@
+#pragma once
+
+#include "nyx/latency_histogram.h"
+
+#include <uv.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace nyx {
+
+class NyxImGui;
+
+// Decides when SpinEventLoop builds a UI frame, independent of how often the event loop iterates.
+// Loop iterations in between only run I/O callbacks, timers and microtasks.
+//
+// With a fixed rate a frame is due every 1/rate seconds. When paced by the renderer a frame is due once
+// the renderer has consumed the previous one (NyxImGui::NotifyFrameConsumed), still no faster than the
+// rate, and at least every kMaxFrameInterval so widgets keep updating while nothing is presented.
+// Input arriving from the window thread makes a frame due as soon as the rate allows, in either mode.
+//
+// The timer and async handles live on the environment's loop and are closed by CloseEventLoop.
+class FrameScheduler {
+ public:
+  static constexpr double kDefaultRate = 60.0;
+  static constexpr std::chrono::milliseconds kMaxFrameInterval{250};
+
+  struct Stats {
+    uint64_t frames;
+    uint64_t idle_iterations;  // loop iterations that did not build a frame
+    uint64_t renderer_frames;  // frames started because the renderer consumed the previous one
+    uint64_t input_frames;     // frames started early for new input
+    LatencyHistogram build;    // ns spent updating and rendering widgets
+    LatencyHistogram interval;  // ns between frame starts
+  };
+
+  FrameScheduler(uv_loop_t* loop, NyxImGui* nyx_imgui);
+  ~FrameScheduler();
+
+  FrameScheduler(const FrameScheduler&) = delete;
+  FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+  // Stops the renderer and input callbacks from signalling the wakeup handle. Called before the loop's handles
+  // close; frames are no longer paced by the renderer afterwards.
+  void Detach();
+
+  // rate in frames per second, > 0.
+  void Configure(double rate, bool renderer_paced);
+  double rate() const { return rate_; }
+  bool renderer_paced() const { return renderer_paced_; }
+
+  // Called once per loop iteration. Returns true if a frame should be built now; the caller then calls
+  // FrameBuilt() when done.
+  bool ShouldBuildFrame();
+  void FrameBuilt();
+  // Earliest time the next frame can be due.
+  std::chrono::steady_clock::time_point next_frame_time() const { return last_frame_start_ + min_interval_; }
+
+  const Stats& stats() const { return stats_; }
+  void ResetStats();
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  static void OnTimer(uv_timer_t* handle);
+  static void OnWakeup(uv_async_t* handle);
+
+  void CheckDue();
+  void ArmTimer(Clock::time_point when);
+
+  NyxImGui* nyx_imgui_;  // shared, not owned; null when running headless
+  uv_timer_t timer_;
+  uv_async_t wakeup_async_;  // renderer consumed a frame or input arrived
+
+  double rate_ = kDefaultRate;
+  bool renderer_paced_ = false;
+  Clock::duration min_interval_;
+
+  bool due_ = true;
+  bool building_ = false;
+  Clock::time_point frame_start_;
+  Clock::time_point last_frame_start_;
+  std::atomic<bool> consumed_{false};
+  std::atomic<bool> input_{false};
+
+  Stats stats_{};
+};
+
+}  // namespace nyx
@@ -0,0 +1,244 @@
+#include "nyx/frame_timeline.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include "nyx/env.h"
+#include "nyx/errors.h"
+#include "nyx/external_references.h"
+#include "nyx/game_lock.h"
+#include "nyx/nyx_binding.h"
+
+namespace nyx {
+
+using v8::Array;
+using v8::Context;
+using v8::FunctionCallbackInfo;
+using v8::Isolate;
+using v8::Local;
+using v8::Number;
+using v8::Object;
+using v8::ObjectTemplate;
+using v8::Value;
+
+namespace {
+
+// Trace event thread ids
+constexpr int kLoopTrack = 1;
+constexpr int kFrameTrack = 2;
+constexpr int kGameLockTrack = 3;
+
+// Writes trace events, comma separated, through a fixed buffer.
+class TraceWriter {
+ public:
+  explicit TraceWriter(std::ostream& out) : out_(out) {}
+
+  template <typename... Args>
+  void Event(const char* format, Args... args) {
+    int length = snprintf(buffer_, sizeof(buffer_), format, args...);
+    if (length <= 0) {
+      return;
+    }
+    if (!first_) {
+      out_.put(',');
+    }
+    first_ = false;
+    out_.write(buffer_, std::min<int>(length, sizeof(buffer_) - 1));
+    out_.put('\n');
+  }
+
+  void Slice(const char* name, int tid, uint64_t start_ns, uint64_t end_ns) {
+    Event(R"({"name":"%s","ph":"X","pid":1,"tid":%d,"ts":%.3f,"dur":%.3f})",
+          name,
+          tid,
+          static_cast<double>(start_ns) / 1e3,
+          static_cast<double>(end_ns - start_ns) / 1e3);
+  }
+
+  void ThreadName(int tid, const char* name) {
+    Event(R"({"name":"thread_name","ph":"M","pid":1,"tid":%d,"args":{"name":"%s"}})", tid, name);
+  }
+
+ private:
+  std::ostream& out_;
+  char buffer_[256];
+  bool first_ = true;
+};
+
+}  // namespace
+
+FrameTimeline::FrameTimeline(uv_loop_t* loop) {
+  uv_prepare_init(loop, &poll_prepare_);
+  uv_unref(reinterpret_cast<uv_handle_t*>(&poll_prepare_));
+  poll_prepare_.data = this;
+  uv_prepare_start(&poll_prepare_, [](uv_prepare_t* handle) {
+    static_cast<FrameTimeline*>(handle->data)->poll_start_ns_ = Now();
+  });
+
+  uv_check_init(loop, &poll_check_);
+  uv_unref(reinterpret_cast<uv_handle_t*>(&poll_check_));
+  poll_check_.data = this;
+  uv_check_start(&poll_check_, [](uv_check_t* handle) {
+    FrameTimeline* timeline = static_cast<FrameTimeline*>(handle->data);
+    timeline->Record(Phase::kPoll, timeline->poll_start_ns_, Now());
+  });
+}
+
+FrameTimeline::~FrameTimeline() {}
+
+const char* FrameTimeline::PhaseName(Phase phase) {
+  switch (phase) {
+#define V(name, string)                                                                                                \
+  case Phase::name:                                                                                                    \
+    return string;
+    FRAME_PHASES(V)
+#undef V
+    default:
+      return "unknown";
+  }
+}
+
+void FrameTimeline::Record(Phase phase, uint64_t start_ns, uint64_t end_ns) {
+  spans_.Push(Span{start_ns, end_ns, static_cast<uint64_t>(phase)});
+  current_.phase_ns[static_cast<size_t>(phase)] += end_ns - start_ns;
+}
+
+void FrameTimeline::FrameStarted() {
+  current_.start_ns = Now();
+}
+
+void FrameTimeline::FrameBuilt() {
+  current_.end_ns = Now();
+  frames_.Push(current_);
+
+  uint64_t index = current_.index + 1;
+  current_ = FrameRecord{};
+  current_.index = index;
+}
+
+void FrameTimeline::WriteTrace(std::ostream& out, const GameLock* game_lock) const {
+  std::vector<Span> spans;
+  spans_.Read(&spans);
+  std::vector<FrameRecord> frames;
+  frames_.Read(&frames);
+
+  out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+  TraceWriter writer(out);
+  writer.Event(R"({"name":"process_name","ph":"M","pid":1,"args":{"name":"nyx"}})");
+  writer.ThreadName(kLoopTrack, "event loop");
+  writer.ThreadName(kFrameTrack, "frames");
+
+  for (const Span& span : spans) {
+    writer.Slice(PhaseName(static_cast<Phase>(span.phase)), kLoopTrack, span.start_ns, span.end_ns);
+  }
+  for (const FrameRecord& frame : frames) {
+    writer.Event(R"({"name":"frame","ph":"X","pid":1,"tid":%d,"ts":%.3f,"dur":%.3f,"args":{"index":%)" PRIu64 "}}",
+                 kFrameTrack,
+                 static_cast<double>(frame.start_ns) / 1e3,
+                 static_cast<double>(frame.end_ns - frame.start_ns) / 1e3,
+                 frame.index);
+  }
+
+  if (game_lock) {
+    std::vector<GameLock::WindowRecord> windows;
+    game_lock->window_trace().Read(&windows);
+    writer.ThreadName(kGameLockTrack, "game lock");
+    for (const GameLock::WindowRecord& window : windows) {
+      writer.Event(R"({"name":"window","ph":"X","pid":1,"tid":%d,"ts":%.3f,"dur":%.3f,"args":{"heldUs":%.3f}})",
+                   kGameLockTrack,
+                   static_cast<double>(window.open_ns) / 1e3,
+                   static_cast<double>(window.close_ns - window.open_ns) / 1e3,
+                   static_cast<double>(window.hold_ns) / 1e3);
+    }
+  }
+  out << "]}\n";
+}
+
+// getFrames(count?: number) -> object[]
+// The last frames built, oldest first. Times in microseconds; start is on the steady clock.
+static void GetFrames(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Local<Context> context = isolate->GetCurrentContext();
+  FrameTimeline& timeline = Environment::GetCurrent(args)->frame_timeline();
+
+  size_t max = FrameTimeline::FrameRing::kCapacity;
+  if (!args[0]->IsUndefined()) {
+    if (!args[0]->IsUint32()) {
+      THROW_ERR_INVALID_ARG_TYPE(isolate, "count must be a non-negative integer");
+      return;
+    }
+    max = args[0].As<v8::Uint32>()->Value();
+  }
+  std::vector<FrameTimeline::FrameRecord> frames;
+  timeline.frames().Read(&frames, max);
+
+  auto us = [&](uint64_t ns) { return Number::New(isolate, static_cast<double>(ns) / 1e3); };
+
+  Local<Array> result = Array::New(isolate, static_cast<int>(frames.size()));
+  for (uint32_t i = 0; i < frames.size(); i++) {
+    const FrameTimeline::FrameRecord& frame = frames[i];
+    Local<Object> phases = Object::New(isolate);
+    for (size_t phase = 0; phase < FrameTimeline::kPhaseCount; phase++) {
+      phases
+          ->Set(context,
+                OneByteString(isolate, FrameTimeline::PhaseName(static_cast<FrameTimeline::Phase>(phase))),
+                us(frame.phase_ns[phase]))
+          .Check();
+    }
+
+    Local<Object> entry = Object::New(isolate);
+    auto set = [&](const char* name, Local<Value> value) {
+      entry->Set(context, OneByteString(isolate, name), value).Check();
+    };
+    set("index", Number::New(isolate, static_cast<double>(frame.index)));
+    set("start", us(frame.start_ns));
+    set("duration", us(frame.end_ns - frame.start_ns));
+    set("phases", phases);
+    result->Set(context, i, entry).Check();
+  }
+  args.GetReturnValue().Set(result);
+}
+
+// writeTrace(path: string) -> void
+// Chrome Trace Event JSON of the recorded phases, frames and game lock windows.
+static void WriteTrace(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Environment* env = Environment::GetCurrent(args);
+  if (!args[0]->IsString()) {
+    THROW_ERR_INVALID_ARG_TYPE(isolate, "path must be a string");
+    return;
+  }
+  Utf8Value path(isolate, args[0]);
+
+  std::ofstream file(*path, std::ios::binary);
+  if (!file.good()) {
+    THROW_ERR_OPERATION_FAILED(isolate, "Failed to open file for writing");
+    return;
+  }
+  env->frame_timeline().WriteTrace(file, env->game_lock());
+  if (!file.good()) {
+    THROW_ERR_OPERATION_FAILED(isolate, "Failed to write to file");
+  }
+}
+
+static void CreatePerIsolateProperties(IsolateData* isolate_data, Local<ObjectTemplate> target) {
+  Isolate* isolate = isolate_data->isolate();
+
+  SetMethod(isolate, target, "getFrames", GetFrames);
+  SetMethod(isolate, target, "writeTrace", WriteTrace);
+}
+
+static void CreatePerContextProperties(Local<Object> target, Local<Context> context) {}
+
+static void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(GetFrames);
+  registry->Register(WriteTrace);
+}
+
+NYX_BINDING_PER_ISOLATE_INIT(trace, CreatePerIsolateProperties)
+NYX_BINDING_CONTEXT_AWARE(trace, CreatePerContextProperties)
+NYX_BINDING_EXTERNAL_REFERENCE(trace, RegisterExternalReferences)
+
+}  // namespace nyx
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "nyx/trace_ring.h"
+
+#include <uv.h>
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+namespace nyx {
+
+class GameLock;
+
+#define FRAME_PHASES(V)                                                                                                \
+  V(kMicrotasks, "microtasks")                                                                                         \
+  V(kUvRun, "uvRun")                                                                                                   \
+  V(kPoll, "poll")                                                                                                     \
+  V(kUpdate, "update")                                                                                                 \
+  V(kRender, "render")                                                                                                 \
+  V(kEndFrame, "endFrame")                                                                                             \
+  V(kSubmit, "submit")                                                                                                 \
+  V(kBeginFrame, "beginFrame")                                                                                         \
+  V(kIdleTasks, "idleTasks")
+
+// Times the phases of the event loop and the frames it builds, for frame breakdowns and Chrome traces.
+//
+// Every phase run is recorded as a span. Each frame also gets a record with the time spent in each phase since
+// the previous frame was built, so callbacks run between frames are charged to the next one. Poll is the time
+// uv_run waited for I/O and is part of uvRun. endFrame is ImGui::Render; submit hands the draw lists to the
+// renderer.
+//
+// Timestamps are steady clock nanoseconds, the same clock GameLock records its windows with. Recording costs
+// two clock reads per phase and never allocates; the rings keep the last few thousand spans and frames.
+class FrameTimeline {
+ public:
+  enum class Phase : uint32_t {
+#define V(name, string) name,
+    FRAME_PHASES(V)
+#undef V
+        kCount
+  };
+  static constexpr size_t kPhaseCount = static_cast<size_t>(Phase::kCount);
+
+  struct Span {
+    uint64_t start_ns;
+    uint64_t end_ns;
+    uint64_t phase;
+  };
+
+  struct FrameRecord {
+    uint64_t index;
+    uint64_t start_ns;  // frame build started
+    uint64_t end_ns;    // frame built
+    uint64_t phase_ns[kPhaseCount];
+  };
+
+  using SpanRing = TraceRing<Span, 8192>;
+  using FrameRing = TraceRing<FrameRecord, 1024>;
+
+  // Records a span for the scope's lifetime. A null timeline records nothing.
+  class Scope {
+   public:
+    Scope(FrameTimeline* timeline, Phase phase)
+        : timeline_(timeline), phase_(phase), start_ns_(timeline ? Now() : 0) {}
+    ~Scope() {
+      if (timeline_) {
+        timeline_->Record(phase_, start_ns_, Now());
+      }
+    }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    FrameTimeline* timeline_;
+    Phase phase_;
+    uint64_t start_ns_;
+  };
+
+  explicit FrameTimeline(uv_loop_t* loop);
+  ~FrameTimeline();
+
+  FrameTimeline(const FrameTimeline&) = delete;
+  FrameTimeline& operator=(const FrameTimeline&) = delete;
+
+  static uint64_t Now() {
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+  }
+  static const char* PhaseName(Phase phase);
+
+  void Record(Phase phase, uint64_t start_ns, uint64_t end_ns);
+  void FrameStarted();
+  void FrameBuilt();
+
+  const SpanRing& spans() const { return spans_; }
+  const FrameRing& frames() const { return frames_; }
+
+  // Chrome Trace Event JSON of the recorded spans, frames and, given a game lock, its windows. Opens in
+  // chrome://tracing and Perfetto.
+  void WriteTrace(std::ostream& out, const GameLock* game_lock) const;
+
+ private:
+  SpanRing spans_;
+  FrameRing frames_;
+  FrameRecord current_{};
+  uint64_t poll_start_ns_ = 0;
+
+  // Closed by CloseEventLoop with the rest of the loop's handles.
+  uv_prepare_t poll_prepare_;
+  uv_check_t poll_check_;
+};
+
+}  // namespace nyx
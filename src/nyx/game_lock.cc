@@ -1,62 +1,116 @@
 #include "nyx/game_lock.h"
 
+#include "nyx/snapshot_arena.h"
+
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
 #include <thread>
+#include <vector>
 
 namespace nyx {
 
-void GameLock::Open(std::chrono::milliseconds timeout) {
-  auto deadline = std::chrono::steady_clock::now() + timeout;
+namespace {
 
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
-    lock_open_ = true;
-  }
-  cv_lock_available_.notify_all();
+uint64_t ElapsedNs(std::chrono::steady_clock::duration duration) {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+}
 
-  // Keep window open for the full duration
-  // This allows multiple acquires/releases within the window
-  std::this_thread::sleep_until(deadline);
+}  // namespace
 
-  {
-    std::unique_lock<std::mutex> lock(mutex_);
-    lock_open_ = false;
+void GameLock::Open() {
+  RunWindow(nullptr);
+}
 
-    // If someone is still holding the lock, wait for them to release
-    if (lock_held_.load()) {
-      cv_lock_released_.wait(lock, [this]() { return !lock_held_.load(); });
-    }
-  }
+void GameLock::Open(std::function<void()> pump) {
+  RunWindow(&pump);
 }
 
-void GameLock::Open(std::function<void()> pump, std::chrono::milliseconds timeout) {
-  auto deadline = std::chrono::steady_clock::now() + timeout;
+void GameLock::RunWindow(const std::function<void()>* pump) {
+  MaybeReport();
+  CaptureSnapshot();
 
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
-    lock_open_ = true;
+  // Work queued outside a window (by threads not holding the lock) still runs on idle frames.
+  if (pump) (*pump)();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (waiters_ == 0) {
+    metrics_.skipped_windows.fetch_add(1, std::memory_order_relaxed);
+    return;
   }
+
+  auto start = Clock::now();
+  auto deadline = start + window_.load();
+  window_hold_ = Clock::duration::zero();
+  last_release_ = start;
+  lock_open_ = true;
   cv_lock_available_.notify_all();
 
-  // Pump the caller's work queue until the window expires.
-  while (std::chrono::steady_clock::now() < deadline) {
-    pump();
-    std::this_thread::sleep_for(std::chrono::microseconds(50));
-  }
+  for (;;) {
+    if (pump_requested_) {
+      pump_requested_ = false;
+      if (pump) {
+        lock.unlock();
+        (*pump)();
+        lock.lock();
+      }
+      continue;
+    }
 
-  {
-    std::unique_lock<std::mutex> lock(mutex_);
-    lock_open_ = false;
+    if (lock_held_) {
+      // Never close under a holder; it may be waiting on pump (RunOnMainThread).
+      cv_game_.wait(lock, [this]() { return pump_requested_ || !lock_held_; });
+      continue;
+    }
 
-    // If the lock holder called RunOnMainThread it will be blocked; keep
-    // pumping (outside the mutex) until it releases.
-    while (lock_held_.load()) {
+    auto now = Clock::now();
+    if (now >= deadline) break;
+
+    if (!async_waiters_.empty()) {
+      // Async waiters take the lock in queue order. Their thread learns about it through the callback
+      // and releases like any other holder, so the window stays open until then.
+      AsyncWaiter waiter = std::move(async_waiters_.front());
+      async_waiters_.pop_front();
+      waiters_--;
+      lock_held_ = true;
+      owner_id_ = waiter.thread;
+      recursive_count_ = 1;
+      hold_start_ = Clock::now();
+      metrics_.wait.Record(ElapsedNs(hold_start_ - waiter.queued));
       lock.unlock();
-      pump();
-      std::this_thread::sleep_for(std::chrono::microseconds(50));
+      waiter.callback(true);
       lock.lock();
+      continue;
+    }
+
+    if (waiters_ == 0) {
+      auto grace_end = std::min(deadline, last_release_ + kReacquireGrace);
+      if (now >= grace_end) break;
+      cv_game_.wait_until(lock, grace_end, [this]() { return pump_requested_ || lock_held_ || waiters_ > 0; });
+    } else {
+      // A waiter is about to take the lock; wake on grant, release or pump.
+      cv_game_.wait_until(lock, deadline, [this]() {
+        return pump_requested_ || lock_held_ || waiters_ == 0 || !async_waiters_.empty();
+      });
     }
   }
+
+  lock_open_ = false;
+
+  auto end = Clock::now();
+  uint64_t open_ns = ElapsedNs(end - start);
+  window_trace_.Push(WindowRecord{
+      ElapsedNs(start.time_since_epoch()), ElapsedNs(end.time_since_epoch()), ElapsedNs(window_hold_)});
+  metrics_.windows.fetch_add(1, std::memory_order_relaxed);
+  if (waiters_ > 0) metrics_.closed_with_waiters.fetch_add(1, std::memory_order_relaxed);
+  if (open_ns > 0) metrics_.utilisation.Record(std::min<uint64_t>(1000, ElapsedNs(window_hold_) * 1000 / open_ns));
+
+  // Size the next window from demand: twice the smoothed hold time, bounded by the frame budget.
+  constexpr double kAlpha = 0.125;
+  double hold_ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(window_hold_).count());
+  hold_ewma_ns_ += kAlpha * (hold_ns - hold_ewma_ns_);
+  auto target = std::chrono::microseconds(static_cast<int64_t>(2.0 * hold_ewma_ns_ / 1000.0));
+  window_ = std::clamp(target, kMinWindow, std::max(kMinWindow, frame_budget_.load()));
 }
 
 bool GameLock::Acquire(std::chrono::milliseconds timeout) {
@@ -68,26 +122,36 @@ bool GameLock::Acquire(std::chrono::milliseconds timeout) {
     return true;
   }
 
+  auto wait_start = Clock::now();
   std::unique_lock<std::mutex> lock(mutex_);
 
-  // Wait for lock to be available AND not currently held
-  bool predicate_satisfied =
-      cv_lock_available_.wait_for(lock, timeout, [this]() { return lock_open_.load() && !lock_held_.load(); });
+  // Announce demand so the next Open() does not skip its window, and so an open window stays open.
+  waiters_++;
+  cv_game_.notify_one();
+  // The lock may also be granted to this thread by one of its own async waiters while it waits here.
+  bool acquired = cv_lock_available_.wait_for(lock, timeout, [this, this_thread]() {
+    return (lock_open_.load() && !lock_held_.load()) || (lock_held_.load() && owner_id_.load() == this_thread);
+  });
+  waiters_--;
 
-  if (predicate_satisfied) {
-    // Double-check we can still acquire (window might have just closed)
-    if (lock_open_.load() && !lock_held_.load()) {
-      lock_held_ = true;
-      owner_id_ = this_thread;
-      recursive_count_ = 1;
-      return true;
-    }
+  if (acquired && lock_held_) {
+    recursive_count_++;
+  } else if (acquired) {
+    lock_held_ = true;
+    owner_id_ = this_thread;
+    recursive_count_ = 1;
+    hold_start_ = Clock::now();
   }
+  cv_game_.notify_one();
+  lock.unlock();
 
-  return false;
+  uint64_t waited_ns = ElapsedNs(Clock::now() - wait_start);
+  (acquired ? metrics_.wait : metrics_.timeout).Record(waited_ns);
+  return acquired;
 }
 
 void GameLock::Release() {
+  Clock::duration held;
   {
     std::lock_guard<std::mutex> lock(mutex_);
     if (recursive_count_ > 1) {
@@ -97,10 +161,97 @@ void GameLock::Release() {
     recursive_count_ = 0;
     owner_id_ = std::thread::id{};
     lock_held_ = false;
+    last_release_ = Clock::now();
+    held = last_release_ - hold_start_;
+    window_hold_ += held;
   }
-  // Notify both: game thread (in case window closed) and other waiters
-  cv_lock_released_.notify_all();
+  metrics_.hold.Record(ElapsedNs(held));
+  // Wake every waiter as RunWindow does: one woken alone may find the window closed and sleep again while the
+  // others wait out their timeouts. The game thread re-evaluates its window.
   cv_lock_available_.notify_all();
+  cv_game_.notify_one();
+}
+
+void GameLock::ReleaseIfOwned() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!lock_held_ || owner_id_.load() != std::this_thread::get_id()) {
+      return;
+    }
+    recursive_count_ = 1;
+  }
+  Release();
+}
+
+uint64_t GameLock::AcquireAsync(const void* owner, AsyncCallback callback, uint32_t tag) {
+  uint64_t id;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    id = next_async_id_++;
+    async_waiters_.push_back({id, owner, tag, std::this_thread::get_id(), std::move(callback), Clock::now()});
+    waiters_++;
+  }
+  cv_game_.notify_one();
+  return id;
+}
+
+bool GameLock::CancelAsync(uint64_t id) {
+  AsyncCallback callback;
+  Clock::time_point queued;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = std::find_if(
+        async_waiters_.begin(), async_waiters_.end(), [id](const AsyncWaiter& waiter) { return waiter.id == id; });
+    if (it == async_waiters_.end()) {
+      return false;
+    }
+    callback = std::move(it->callback);
+    queued = it->queued;
+    async_waiters_.erase(it);
+    waiters_--;
+  }
+  cv_game_.notify_one();
+
+  metrics_.timeout.Record(ElapsedNs(Clock::now() - queued));
+  callback(false);
+  return true;
+}
+
+void GameLock::CancelAsync(const void* owner) {
+  CancelAsyncWhere([owner](const AsyncWaiter& waiter) { return waiter.owner == owner; });
+}
+
+void GameLock::CancelAsync(const void* owner, uint32_t tag) {
+  CancelAsyncWhere([owner, tag](const AsyncWaiter& waiter) { return waiter.owner == owner && waiter.tag == tag; });
+}
+
+void GameLock::CancelAsyncWhere(const std::function<bool(const AsyncWaiter&)>& match) {
+  std::vector<AsyncCallback> callbacks;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = async_waiters_.begin(); it != async_waiters_.end();) {
+      if (match(*it)) {
+        callbacks.push_back(std::move(it->callback));
+        it = async_waiters_.erase(it);
+        waiters_--;
+      } else {
+        ++it;
+      }
+    }
+  }
+  cv_game_.notify_one();
+
+  for (auto& callback : callbacks) {
+    callback(false);
+  }
+}
+
+void GameLock::RequestPump() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pump_requested_ = true;
+  }
+  cv_game_.notify_one();
 }
 
 bool GameLock::IsHeld() const {
@@ -111,4 +262,75 @@ bool GameLock::IsOpen() const {
   return lock_open_.load();
 }
 
+void GameLock::SetFrameBudget(std::chrono::microseconds budget) {
+  frame_budget_ = budget;
+  window_ = std::clamp(window_.load(), kMinWindow, std::max(kMinWindow, budget));
+}
+
+void GameLock::SetSnapshotArena(SnapshotArena* arena) {
+  std::lock_guard<std::mutex> lock(arena_mutex_);
+  snapshot_arena_ = arena;
+}
+
+void GameLock::CaptureSnapshot() {
+  std::lock_guard<std::mutex> lock(arena_mutex_);
+  if (snapshot_arena_) {
+    snapshot_arena_->Capture();
+  }
+}
+
+void GameLock::ResetMetrics() {
+  metrics_.wait.Reset();
+  metrics_.timeout.Reset();
+  metrics_.hold.Reset();
+  metrics_.utilisation.Reset();
+  metrics_.windows = 0;
+  metrics_.skipped_windows = 0;
+  metrics_.closed_with_waiters = 0;
+}
+
+std::string GameLock::FormatMetrics() const {
+  auto wait = metrics_.wait.Summarize();
+  auto hold = metrics_.hold.Summarize();
+  auto utilisation = metrics_.utilisation.Summarize();
+  auto us = [](uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+
+  char line[512];
+  snprintf(line,
+           sizeof(line),
+           "windows %llu (skipped %llu, closed with waiters %llu) | acquires %llu, timeouts %llu | "
+           "wait p50 %.1fus p99 %.1fus max %.1fus | hold p50 %.1fus p99 %.1fus max %.1fus | "
+           "utilisation p50 %.1f%% p99 %.1f%% | window %lldus of %lldus",
+           static_cast<unsigned long long>(metrics_.windows.load()),
+           static_cast<unsigned long long>(metrics_.skipped_windows.load()),
+           static_cast<unsigned long long>(metrics_.closed_with_waiters.load()),
+           static_cast<unsigned long long>(wait.count),
+           static_cast<unsigned long long>(metrics_.timeout.count()),
+           us(wait.p50),
+           us(wait.p99),
+           us(wait.max),
+           us(hold.p50),
+           us(hold.p99),
+           us(hold.max),
+           static_cast<double>(utilisation.p50) / 10.0,
+           static_cast<double>(utilisation.p99) / 10.0,
+           static_cast<long long>(window().count()),
+           static_cast<long long>(frame_budget().count()));
+  return line;
+}
+
+void GameLock::SetReporter(std::chrono::seconds interval, std::function<void(const std::string&)> reporter) {
+  report_interval_ = interval;
+  reporter_ = std::move(reporter);
+  next_report_ = Clock::now() + interval;
+}
+
+void GameLock::MaybeReport() {
+  if (!reporter_ || report_interval_.count() <= 0) return;
+  auto now = Clock::now();
+  if (now < next_report_) return;
+  next_report_ = now + report_interval_;
+  reporter_(FormatMetrics());
+}
+
 }  // namespace nyx
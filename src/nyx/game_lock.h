@@ -1,34 +1,149 @@
 #pragma once
 
+#include "nyx/latency_histogram.h"
+#include "nyx/trace_ring.h"
+
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <mutex>
+#include <string>
 #include <thread>
 
 namespace nyx {
 
+class SnapshotArena;
+
 class GameLock {
  public:
-  void Open(std::chrono::milliseconds timeout = std::chrono::milliseconds(2));
-  void Open(std::function<void()> pump, std::chrono::milliseconds timeout = std::chrono::milliseconds(2));
+  static constexpr std::chrono::microseconds kDefaultFrameBudget{2000};
+  // Shortest window handed out once someone holds the lock, however little they used it before.
+  static constexpr std::chrono::microseconds kMinWindow{100};
+  // How long an open window waits for the next Acquire after a release before closing early.
+  static constexpr std::chrono::microseconds kReacquireGrace{50};
+
+  // Recorded without taking the lock. Times are in nanoseconds, utilisation in per mille of the window
+  // spent with the lock held.
+  struct Metrics {
+    LatencyHistogram wait;     // Acquire() calls that got the lock
+    LatencyHistogram timeout;  // Acquire() calls that gave up
+    LatencyHistogram hold;
+    LatencyHistogram utilisation;
+    std::atomic<uint64_t> windows{0};
+    std::atomic<uint64_t> skipped_windows{0};  // Open() with nobody waiting
+    std::atomic<uint64_t> closed_with_waiters{0};
+  };
+
+  // A window that opened, in steady clock nanoseconds. Skipped windows are not recorded.
+  struct WindowRecord {
+    uint64_t open_ns;
+    uint64_t close_ns;
+    uint64_t hold_ns;  // total the lock was held during the window
+  };
+  using WindowTrace = TraceRing<WindowRecord, 1024>;
+
+  // Runs one window on the game thread. The snapshot is captured first; if no thread is waiting in
+  // Acquire() the window is skipped entirely. Otherwise the lock stays available until nobody holds or
+  // waits for it, or the adaptive window length has passed, whichever comes first, and never closes
+  // while held.
+  void Open();
+  // As above, running pump once up front and again whenever RequestPump() is called during the window.
+  void Open(std::function<void()> pump);
 
   bool Acquire(std::chrono::milliseconds timeout = std::chrono::milliseconds(100));
   void Release();
+  // Drops every level of the lock held by the calling thread, e.g. when its environment goes away.
+  void ReleaseIfOwned();
+
+  // Called with true on the game thread once the lock has been granted to the waiter's thread, or with
+  // false on the cancelling thread. Either way it is called exactly once.
+  using AsyncCallback = std::function<void(bool acquired)>;
+
+  // Queues a waiter that does not block: the next window grants the lock to the calling thread, which
+  // must Release() it as if Acquire() had returned true. owner groups waiters for CancelAsync(owner), tag
+  // subdivides them. Returns an id for CancelAsync.
+  uint64_t AcquireAsync(const void* owner, AsyncCallback callback, uint32_t tag = 0);
+  // Cancels a waiter that has not been granted yet. Returns false if it was granted already.
+  bool CancelAsync(uint64_t id);
+  void CancelAsync(const void* owner);
+  void CancelAsync(const void* owner, uint32_t tag);
+
+  // Wakes the game thread inside Open(pump) to run pump. Safe from any thread.
+  void RequestPump();
 
   bool IsHeld() const;
   bool IsOpen() const;
 
+  // Upper bound for one window. The window itself follows an EWMA of how long the lock was held per
+  // window, so idle frames pay almost nothing and busy ones get up to the full budget.
+  void SetFrameBudget(std::chrono::microseconds budget);
+  std::chrono::microseconds frame_budget() const { return frame_budget_.load(); }
+  std::chrono::microseconds window() const { return window_.load(); }
+
+  // Arena captured by Open() before the window opens. Owned by the environment, which detaches it
+  // (nullptr) before destroying it.
+  void SetSnapshotArena(SnapshotArena* arena);
+
+  const Metrics& metrics() const { return metrics_; }
+  // The last windows, written by the game thread and readable from any, for frame traces.
+  const WindowTrace& window_trace() const { return window_trace_; }
+  void ResetMetrics();
+  // One-line summary of metrics(), as written by the reporter.
+  std::string FormatMetrics() const;
+  // Calls reporter with FormatMetrics() from the game thread every interval; zero disables it. Set it
+  // before the game thread starts opening windows.
+  void SetReporter(std::chrono::seconds interval, std::function<void(const std::string&)> reporter);
+
  private:
+  using Clock = std::chrono::steady_clock;
+
+  void RunWindow(const std::function<void()>* pump);
+  void CaptureSnapshot();
+  void MaybeReport();
+
+  struct AsyncWaiter {
+    uint64_t id;
+    const void* owner;
+    uint32_t tag;
+    std::thread::id thread;
+    AsyncCallback callback;
+    Clock::time_point queued;
+  };
+
+  void CancelAsyncWhere(const std::function<bool(const AsyncWaiter&)>& match);
+
+  std::mutex arena_mutex_;
+  SnapshotArena* snapshot_arena_{nullptr};
+
   std::mutex mutex_;
   std::condition_variable cv_lock_available_;
-  std::condition_variable cv_lock_released_;
+  // Signals the game thread: released, waiter count changed or pump requested.
+  std::condition_variable cv_game_;
 
   std::atomic<bool> lock_open_{false};
   std::atomic<bool> lock_held_{false};
   std::atomic<std::thread::id> owner_id_{};
   uint32_t recursive_count_{0};
+  uint32_t waiters_{0};
+  bool pump_requested_{false};
+  std::deque<AsyncWaiter> async_waiters_;  // also counted in waiters_
+  uint64_t next_async_id_{1};
+
+  Clock::time_point hold_start_;
+  Clock::time_point last_release_;
+  Clock::duration window_hold_{};
+  // EWMA of total hold time per window, in nanoseconds.
+  double hold_ewma_ns_{0.0};
+  std::atomic<std::chrono::microseconds> frame_budget_{kDefaultFrameBudget};
+  std::atomic<std::chrono::microseconds> window_{kDefaultFrameBudget};
+
+  Metrics metrics_;
+  WindowTrace window_trace_;
+  std::chrono::seconds report_interval_{0};
+  std::function<void(const std::string&)> reporter_;
+  Clock::time_point next_report_;
 };
 
 }  // namespace nyx
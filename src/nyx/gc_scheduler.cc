@@ -0,0 +1,126 @@
+#include "nyx/gc_scheduler.h"
+
+#include <libplatform/libplatform.h>
+
+namespace nyx {
+
+using v8::GCCallbackFlags;
+using v8::GCType;
+using v8::HeapStatistics;
+using v8::Isolate;
+
+namespace {
+
+uint64_t ElapsedNs(GcScheduler::Clock::duration duration) {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+}
+
+}  // namespace
+
+GcScheduler::GcScheduler(Isolate* isolate) : isolate_(isolate) {
+  isolate_->AddGCPrologueCallback(OnPrologue, this);
+  isolate_->AddGCEpilogueCallback(OnEpilogue, this);
+  used_after_full_gc_ = UsedHeapSize();
+}
+
+GcScheduler::~GcScheduler() {
+  isolate_->RemoveGCPrologueCallback(OnPrologue, this);
+  isolate_->RemoveGCEpilogueCallback(OnEpilogue, this);
+}
+
+void GcScheduler::Configure(bool enabled, size_t growth_threshold) {
+  enabled_ = enabled;
+  growth_threshold_ = growth_threshold;
+}
+
+void GcScheduler::FrameStarted() {
+  in_frame_ = true;
+  frame_pause_ns_ = 0;
+}
+
+void GcScheduler::FrameEnded() {
+  in_frame_ = false;
+  stats_.frame_pause.Record(frame_pause_ns_);
+}
+
+void GcScheduler::RunIdle(v8::Platform* platform, Clock::time_point deadline) {
+  if (!platform) {
+    return;
+  }
+
+  // Nothing else pumps the foreground queue; always let at least one task through so it cannot starve. Done
+  // even when idle GC is off: marking finalization, compile finalization and Atomics.waitAsync depend on it.
+  while (v8::platform::PumpMessageLoop(platform, isolate_)) {
+    if (Clock::now() >= deadline) {
+      return;
+    }
+  }
+  if (!enabled_) {
+    return;
+  }
+
+  auto now = Clock::now();
+  if (deadline - now < kMinIdleTime) {
+    return;
+  }
+  stats_.idle_periods++;
+
+  if (growth_threshold_ > 0 && !pressure_notified_ && UsedHeapSize() > used_after_full_gc_ + growth_threshold_) {
+    pressure_notified_ = true;
+    stats_.pressure_notifications++;
+    isolate_->MemoryPressureNotification(v8::MemoryPressureLevel::kModerate);
+    now = Clock::now();
+    if (now >= deadline) {
+      return;
+    }
+  }
+
+  v8::platform::RunIdleTasks(platform, isolate_, std::chrono::duration<double>(deadline - now).count());
+  stats_.idle_ns += ElapsedNs(Clock::now() - now);
+}
+
+void GcScheduler::ResetStats() {
+  stats_.collections = 0;
+  stats_.frame_collections = 0;
+  stats_.idle_periods = 0;
+  stats_.idle_ns = 0;
+  stats_.pressure_notifications = 0;
+  stats_.pause.Reset();
+  stats_.frame_pause.Reset();
+}
+
+size_t GcScheduler::UsedHeapSize() {
+  HeapStatistics heap_statistics;
+  isolate_->GetHeapStatistics(&heap_statistics);
+  return heap_statistics.used_heap_size();
+}
+
+void GcScheduler::OnPrologue(Isolate* isolate, GCType type, GCCallbackFlags flags, void* data) {
+  GcScheduler* self = static_cast<GcScheduler*>(data);
+  if (self->depth_++ > 0) {
+    return;
+  }
+  self->pause_start_ = Clock::now();
+  self->stats_.collections++;
+  if (self->in_frame_) {
+    self->stats_.frame_collections++;
+  }
+}
+
+void GcScheduler::OnEpilogue(Isolate* isolate, GCType type, GCCallbackFlags flags, void* data) {
+  GcScheduler* self = static_cast<GcScheduler*>(data);
+  if (self->depth_ == 0 || --self->depth_ > 0) {
+    return;
+  }
+  uint64_t pause_ns = ElapsedNs(Clock::now() - self->pause_start_);
+  self->stats_.pause.Record(pause_ns);
+  if (self->in_frame_) {
+    self->frame_pause_ns_ += pause_ns;
+  }
+  if (type & v8::kGCTypeMarkSweepCompact) {
+    self->used_after_full_gc_ = self->UsedHeapSize();
+    self->pressure_notified_ = false;
+  }
+}
+
+}  // namespace nyx
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "nyx/latency_histogram.h"
+
+#include <v8.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace v8 {
+class Platform;
+}
+
+namespace nyx {
+
+// Moves garbage collection work into the time between UI frames and measures how much of it still lands
+// inside one.
+//
+// After a frame is built SpinEventLoop hands over the time left until the next frame or timer is due.
+// That slack first runs the foreground tasks V8 has posted (incremental marking steps, the memory
+// reducer, finalizers), then V8's idle tasks. When the heap has grown by more than the configured
+// threshold since the last full collection, a moderate memory pressure notification starts incremental
+// marking there, rather than letting an allocation inside UpdateAll trigger it.
+//
+// Pauses are timed with GC prologue/epilogue callbacks, so only work done on the isolate's thread counts.
+class GcScheduler {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr size_t kDefaultGrowthThreshold = 32 * 1024 * 1024;
+  // Less idle time than this is not worth starting on.
+  static constexpr std::chrono::microseconds kMinIdleTime{1000};
+
+  struct Stats {
+    uint64_t collections;
+    uint64_t frame_collections;  // collections that started while a frame was being built
+    uint64_t idle_periods;
+    uint64_t idle_ns;  // idle time handed to V8
+    uint64_t pressure_notifications;
+    LatencyHistogram pause;        // ns per collection
+    LatencyHistogram frame_pause;  // ns of collection per frame, frames without any included
+  };
+
+  explicit GcScheduler(v8::Isolate* isolate);
+  ~GcScheduler();
+
+  GcScheduler(const GcScheduler&) = delete;
+  GcScheduler& operator=(const GcScheduler&) = delete;
+
+  // growth_threshold in bytes; 0 disables pressure notifications.
+  void Configure(bool enabled, size_t growth_threshold);
+  bool enabled() const { return enabled_; }
+  size_t growth_threshold() const { return growth_threshold_; }
+
+  void FrameStarted();
+  void FrameEnded();
+  // Does idle work until deadline at the latest. Disabled, only V8's foreground tasks run.
+  void RunIdle(v8::Platform* platform, Clock::time_point deadline);
+
+  const Stats& stats() const { return stats_; }
+  void ResetStats();
+
+ private:
+  static void OnPrologue(v8::Isolate* isolate, v8::GCType type, v8::GCCallbackFlags flags, void* data);
+  static void OnEpilogue(v8::Isolate* isolate, v8::GCType type, v8::GCCallbackFlags flags, void* data);
+
+  size_t UsedHeapSize();
+
+  v8::Isolate* isolate_;
+  bool enabled_ = true;
+  size_t growth_threshold_ = kDefaultGrowthThreshold;
+
+  bool in_frame_ = false;
+  int depth_ = 0;  // collections can nest through callbacks
+  Clock::time_point pause_start_;
+  uint64_t frame_pause_ns_ = 0;
+
+  size_t used_after_full_gc_ = 0;
+  bool pressure_notified_ = false;  // until the next full collection
+
+  Stats stats_{};
+};
+
+}  // namespace nyx
@@ -1,6 +1,7 @@
 #include "nyx/gui/canvas.h"
 
 #include "nyx/env.h"
+#include "nyx/external_references.h"
 #include "nyx/gui/widget_manager.h"
 #include "nyx/isolate_data.h"
 #include "nyx/realm.h"
@@ -40,6 +41,18 @@ void Canvas::Initialize(IsolateData* isolate_data) {
   isolate_data->set_canvas_constructor_template(tmpl);
 }
 
+void Canvas::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(AddLine);
+  registry->Register(AddRect);
+  registry->Register(AddRectFilled);
+  registry->Register(AddCircle);
+  registry->Register(AddCircleFilled);
+  registry->Register(AddText);
+  registry->Register(Remove);
+  registry->Register(Clear);
+}
+
 void Canvas::CreatePerContextProperties(Local<Object> target, Local<Context> context) {
   Environment* env = Environment::GetCurrent(context);
   if (!env || !env->widget_manager()) {
@@ -9,6 +9,7 @@
 
 namespace nyx {
 
+class ExternalReferenceRegistry;
 class IsolateData;
 
 class Canvas : public BaseObject {
@@ -33,6 +34,7 @@ class Canvas : public BaseObject {
 
   static void Initialize(IsolateData* isolate_data);
   static void CreatePerContextProperties(v8::Local<v8::Object> target, v8::Local<v8::Context> context);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -1,6 +1,7 @@
 #include "nyx/gui/colors.h"
 
 #include "nyx/env.h"
+#include "nyx/external_references.h"
 
 namespace nyx {
 
@@ -36,6 +37,12 @@ void ColorWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate> ta
   target->Set(FixedOneByteString(isolate, "ColorWidget"), tmpl);
 }
 
+void ColorWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(ColorGetter);
+  registry->Register(ColorSetter);
+}
+
 void ColorWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Environment* env = Environment::GetCurrent(isolate);
@@ -27,6 +27,7 @@ class ColorWidget : public Widget {
               ImVec2 size);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -1,6 +1,7 @@
 #include "nyx/gui/combo.h"
 
 #include "nyx/env.h"
+#include "nyx/external_references.h"
 
 namespace nyx {
 
@@ -38,6 +39,14 @@ void ComboWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate> ta
   target->Set(FixedOneByteString(isolate, "Combo"), tmpl);
 }
 
+void ComboWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(SelectedGetter);
+  registry->Register(SelectedSetter);
+  registry->Register(ItemsGetter);
+  registry->Register(ItemsSetter);
+}
+
 // fixme: could be an overload of FromV8Value(context, js_array, std::vector<T>& out)
 static std::vector<std::string> ArrayToStringVector(Isolate* isolate, Local<Context> context, Local<Value> val) {
   std::vector<std::string> result;
@@ -28,6 +28,7 @@ class ComboWidget : public Widget {
               ImGuiComboFlags flags = ImGuiComboFlags_None);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
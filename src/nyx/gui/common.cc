@@ -1,6 +1,7 @@
 #include "nyx/gui/common.h"
 
 #include "nyx/env.h"
+#include "nyx/external_references.h"
 
 namespace nyx {
 
@@ -31,6 +32,11 @@ void ButtonWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate> t
   target->Set(FixedOneByteString(isolate, "Button"), tmpl);
 }
 
+void ButtonWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetClicked);
+}
+
 void ButtonWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Local<Context> context = isolate->GetCurrentContext();
@@ -69,6 +75,11 @@ void InvisibleButtonWidget::Initialize(IsolateData* isolate_data, Local<ObjectTe
   target->Set(FixedOneByteString(isolate, "InvisibleButton"), tmpl);
 }
 
+void InvisibleButtonWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetClicked);
+}
+
 void InvisibleButtonWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Local<Context> context = isolate->GetCurrentContext();
@@ -106,6 +117,12 @@ void CheckboxWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate>
   target->Set(FixedOneByteString(isolate, "Checkbox"), tmpl);
 }
 
+void CheckboxWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetChecked);
+  registry->Register(SetChecked);
+}
+
 void CheckboxWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Environment* env = Environment::GetCurrent(isolate);
@@ -144,6 +161,10 @@ void BulletWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate> t
   target->Set(FixedOneByteString(isolate, "Bullet"), tmpl);
 }
 
+void BulletWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+}
+
 void BulletWidget::New(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args.GetIsolate());
   new BulletWidget(env->principal_realm(), args.This());
@@ -168,6 +189,11 @@ void SmallButtonWidget::Initialize(IsolateData* isolate_data, Local<ObjectTempla
   target->Set(FixedOneByteString(isolate, "SmallButton"), tmpl);
 }
 
+void SmallButtonWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetClicked);
+}
+
 void SmallButtonWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Environment* env = Environment::GetCurrent(isolate);
@@ -202,6 +228,11 @@ void ArrowButtonWidget::Initialize(IsolateData* isolate_data, Local<ObjectTempla
   target->Set(FixedOneByteString(isolate, "ArrowButton"), tmpl);
 }
 
+void ArrowButtonWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetClicked);
+}
+
 void ArrowButtonWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Local<Context> context = isolate->GetCurrentContext();
@@ -239,6 +270,13 @@ void RadioButtonWidget::Initialize(IsolateData* isolate_data, Local<ObjectTempla
   target->Set(FixedOneByteString(isolate, "RadioButton"), tmpl);
 }
 
+void RadioButtonWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetActive);
+  registry->Register(SetActive);
+  registry->Register(GetClicked);
+}
+
 void RadioButtonWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Environment* env = Environment::GetCurrent(isolate);
@@ -285,6 +323,14 @@ void ProgressBarWidget::Initialize(IsolateData* isolate_data, Local<ObjectTempla
   target->Set(FixedOneByteString(isolate, "ProgressBar"), tmpl);
 }
 
+void ProgressBarWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetFraction);
+  registry->Register(SetFraction);
+  registry->Register(GetOverlay);
+  registry->Register(SetOverlay);
+}
+
 void ProgressBarWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Local<Context> context = isolate->GetCurrentContext();
@@ -21,6 +21,7 @@ class ButtonWidget : public Widget {
   ButtonWidget(Realm* realm, v8::Local<v8::Object> object, const std::string& label, float width, float height);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -42,6 +43,7 @@ class InvisibleButtonWidget : public Widget {
       Realm* realm, v8::Local<v8::Object> object, const std::string& label, float width, float height);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -62,6 +64,7 @@ class CheckboxWidget : public Widget {
   CheckboxWidget(Realm* realm, v8::Local<v8::Object> object, const std::string& label, bool checked);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -82,6 +85,7 @@ class BulletWidget : public Widget {
   using Widget::Widget;
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -93,6 +97,7 @@ class SmallButtonWidget : public Widget {
   SmallButtonWidget(Realm* realm, v8::Local<v8::Object> object, const std::string& label);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -110,6 +115,7 @@ class ArrowButtonWidget : public Widget {
   ArrowButtonWidget(Realm* realm, v8::Local<v8::Object> object, const std::string& id, ImGuiDir dir);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -129,6 +135,7 @@ class RadioButtonWidget : public Widget {
   RadioButtonWidget(Realm* realm, v8::Local<v8::Object> object, const std::string& label, bool active);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -151,6 +158,7 @@ class ProgressBarWidget : public Widget {
   ProgressBarWidget(Realm* realm, v8::Local<v8::Object> object, float fraction, const std::string& overlay);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -0,0 +1,179 @@
+#include "nyx/gui/flame_graph.h"
+
+#include <algorithm>
+
+#include "nyx/env.h"
+#include "nyx/external_references.h"
+#include "nyx/profiler.h"
+
+namespace nyx {
+
+using v8::Context;
+using v8::FunctionCallbackInfo;
+using v8::FunctionTemplate;
+using v8::Isolate;
+using v8::Local;
+using v8::Object;
+using v8::ObjectTemplate;
+using v8::Value;
+
+FlameGraphWidget::FlameGraphWidget(
+    Realm* realm, Local<Object> object, const std::string& label, float width, float height)
+    : Widget(realm, object, label), width_(width), height_(height) {}
+
+void FlameGraphWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate> target) {
+  Isolate* isolate = isolate_data->isolate();
+  Local<FunctionTemplate> tmpl = FunctionTemplate::New(isolate, New);
+  tmpl->InstanceTemplate()->SetInternalFieldCount(BaseObject::kInternalFieldCount);
+  tmpl->Inherit(Widget::GetConstructorTemplate(isolate_data));
+
+  tmpl->SetClassName(FixedOneByteString(isolate, "FlameGraph"));
+  target->Set(FixedOneByteString(isolate, "FlameGraph"), tmpl);
+}
+
+void FlameGraphWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+}
+
+void FlameGraphWidget::New(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Local<Context> context = isolate->GetCurrentContext();
+  Environment* env = Environment::GetCurrent(context);
+  std::string label;
+  if (args.Length() > 0 && !args[0]->IsUndefined()) {
+    Utf8Value l(isolate, args[0]);
+    label = *l;
+  }
+  float width = args.Length() > 1 ? static_cast<float>(args[1]->NumberValue(context).FromMaybe(0.0)) : 0.0f;
+  float height = args.Length() > 2 ? static_cast<float>(args[2]->NumberValue(context).FromMaybe(0.0)) : 0.0f;
+
+  if (env->profiler().window() == 0) {
+    env->profiler().SetWindow(kDefaultWindowSeconds);
+  }
+  new FlameGraphWidget(env->principal_realm(), args.This(), label, width, height);
+}
+
+static ImU32 FrameColor(uint32_t frame) {
+  // Warm colours, stable per function.
+  uint32_t h = frame * 2654435761u;
+  return IM_COL32(205 + (h & 0x1f), 90 + ((h >> 8) & 0x7f), 40 + ((h >> 16) & 0x3f), 255);
+}
+
+void FlameGraphWidget::Render() {
+  Profiler& profiler = env()->profiler();
+  const Profiler::FlameTree& tree = profiler.flame_tree();
+  const std::vector<Profiler::FlameNode>& nodes = tree.nodes;
+  double ms_per_sample = static_cast<double>(tree.sampling_interval.count()) / 1e3;
+  uint64_t samples = nodes[0].total;
+
+  ImGui::PushID(this);
+  if (!label_.empty()) {
+    ImGui::TextUnformatted(label_.c_str());
+    ImGui::SameLine();
+  }
+  ImGui::TextDisabled("last %u s, %.0f ms of script time", tree.seconds, static_cast<double>(samples) * ms_per_sample);
+  if (samples == 0) {
+    ImGui::PopID();
+    return;
+  }
+
+  // Follow the zoom path as far as it still exists; children always come after their parent.
+  uint32_t zoom = 0;
+  size_t matched = 0;
+  for (uint32_t i = 1; i < nodes.size() && matched < zoom_path_.size(); i++) {
+    if (nodes[i].parent == zoom && nodes[i].frame == zoom_path_[matched]) {
+      zoom = i;
+      matched++;
+    }
+  }
+
+  // Lay out the zoomed subtree, x as a fraction of the zoomed node's width; -1 for nodes outside of it.
+  size_t count = nodes.size();
+  x_.assign(count, -1.0f);
+  next_x_.assign(count, 0.0f);
+  depth_.assign(count, 0);
+  x_[zoom] = 0.0f;
+  uint32_t max_depth = 0;
+  double scale = 1.0 / static_cast<double>(nodes[zoom].total);
+  for (uint32_t i = zoom + 1; i < count; i++) {
+    uint32_t parent = nodes[i].parent;
+    if (x_[parent] < 0.0f) {
+      continue;
+    }
+    x_[i] = x_[parent] + next_x_[parent];
+    next_x_[parent] += static_cast<float>(static_cast<double>(nodes[i].total) * scale);
+    depth_[i] = depth_[parent] + 1;
+    max_depth = std::max(max_depth, depth_[i]);
+  }
+
+  float row_height = ImGui::GetFrameHeight();
+  ImVec2 size(width_ > 0.0f ? width_ : ImGui::GetContentRegionAvail().x,
+              height_ > 0.0f ? height_ : static_cast<float>(max_depth + 1) * row_height);
+  size.x = std::max(size.x, 1.0f);
+  size.y = std::max(size.y, 1.0f);
+  ImVec2 origin = ImGui::GetCursorScreenPos();
+  ImGui::InvisibleButton("##flame", size);
+  bool hovered = ImGui::IsItemHovered();
+  ImVec2 mouse = ImGui::GetIO().MousePos;
+
+  ImDrawList* draw_list = ImGui::GetWindowDrawList();
+  draw_list->PushClipRect(origin, ImVec2(origin.x + size.x, origin.y + size.y), true);
+  int hovered_node = -1;
+  for (uint32_t i = zoom; i < count; i++) {
+    if (x_[i] < 0.0f) {
+      continue;
+    }
+    float width = static_cast<float>(static_cast<double>(nodes[i].total) * scale) * size.x;
+    float top = origin.y + static_cast<float>(depth_[i]) * row_height;
+    if (width < 1.0f || top > origin.y + size.y) {
+      continue;
+    }
+    ImVec2 min(origin.x + x_[i] * size.x, top);
+    ImVec2 max(min.x + width - 1.0f, top + row_height - 1.0f);
+    draw_list->AddRectFilled(min, max, FrameColor(nodes[i].frame));
+
+    const Profiler::Frame& frame = profiler.frame(nodes[i].frame);
+    if (width > ImGui::GetFontSize() * 2.0f) {
+      const char* name = frame.function.empty() ? "(anonymous)" : frame.function.c_str();
+      draw_list->PushClipRect(min, max, true);
+      draw_list->AddText(
+          ImVec2(min.x + ImGui::GetStyle().FramePadding.x, min.y + ImGui::GetStyle().FramePadding.y),
+          IM_COL32(0, 0, 0, 255),
+          name);
+      draw_list->PopClipRect();
+    }
+    if (hovered && mouse.x >= min.x && mouse.x < max.x + 1.0f && mouse.y >= min.y && mouse.y < max.y + 1.0f) {
+      hovered_node = static_cast<int>(i);
+    }
+  }
+  draw_list->PopClipRect();
+
+  if (hovered_node > 0) {
+    const Profiler::FlameNode& node = nodes[hovered_node];
+    const Profiler::Frame& frame = profiler.frame(node.frame);
+    ImGui::BeginTooltip();
+    ImGui::TextUnformatted(frame.function.empty() ? "(anonymous)" : frame.function.c_str());
+    if (!frame.url.empty()) {
+      ImGui::TextDisabled("%s:%d", frame.url.c_str(), frame.line);
+    }
+    ImGui::Text("self %.1f ms, total %.1f ms (%.1f%%)",
+                static_cast<double>(node.self) * ms_per_sample,
+                static_cast<double>(node.total) * ms_per_sample,
+                100.0 * static_cast<double>(node.total) / static_cast<double>(samples));
+    ImGui::EndTooltip();
+
+    if (ImGui::IsItemClicked(ImGuiMouseButton_Left)) {
+      zoom_path_.clear();
+      for (uint32_t i = static_cast<uint32_t>(hovered_node); i != 0; i = nodes[i].parent) {
+        zoom_path_.push_back(nodes[i].frame);
+      }
+      std::reverse(zoom_path_.begin(), zoom_path_.end());
+    }
+  }
+  if (hovered && ImGui::IsItemClicked(ImGuiMouseButton_Right)) {
+    zoom_path_.clear();
+  }
+  ImGui::PopID();
+}
+
+}  // namespace nyx
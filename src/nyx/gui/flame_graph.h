@@ -0,0 +1,37 @@
+#pragma once
+
+#include "nyx/gui/widget.h"
+
+/** Implements:
+ * + A flame graph of the profiler's rolling window
+ */
+
+namespace nyx {
+
+// Draws the call tree the profiler has merged over its window, roots at the top, each function as wide as its
+// share of the samples. Click a function to zoom into it, right-click to zoom back out. Turns the window on when
+// it is off; the window outlives the widget until someone turns it off again.
+class FlameGraphWidget : public Widget {
+ public:
+  static constexpr uint32_t kDefaultWindowSeconds = 10;
+
+  FlameGraphWidget(Realm* realm, v8::Local<v8::Object> object, const std::string& label, float width, float height);
+
+  static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
+
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  void Render() override;
+
+ private:
+  float width_, height_;
+  // Frames from the root down to the zoomed node; node indices change whenever the tree is rebuilt.
+  std::vector<uint32_t> zoom_path_;
+  // Layout scratch, kept to avoid allocating every frame.
+  std::vector<float> x_;
+  std::vector<float> next_x_;
+  std::vector<uint32_t> depth_;
+};
+
+}  // namespace nyx
@@ -1,6 +1,7 @@
 #include "nyx/gui/input.h"
 
 #include "nyx/env.h"
+#include "nyx/external_references.h"
 
 namespace nyx {
 
@@ -42,6 +43,20 @@ void InputTextWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate
   target->Set(FixedOneByteString(isolate, "InputTextWidget"), tmpl);
 }
 
+void InputTextWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(TextGetter);
+  registry->Register(TextSetter);
+  registry->Register(MaxLengthGetter);
+  registry->Register(MaxLengthSetter);
+  registry->Register(FlagsGetter);
+  registry->Register(FlagsSetter);
+  registry->Register(HintGetter);
+  registry->Register(HintSetter);
+  registry->Register(MultilineGetter);
+  registry->Register(MultilineSetter);
+}
+
 void InputTextWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Local<Context> context = isolate->GetCurrentContext();
@@ -193,6 +208,20 @@ void InputNumberWidget::Initialize(IsolateData* isolate_data, Local<ObjectTempla
   target->Set(FixedOneByteString(isolate, "InputNumberWidget"), tmpl);
 }
 
+void InputNumberWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(FormatGetter);
+  registry->Register(FormatSetter);
+  registry->Register(FlagsGetter);
+  registry->Register(FlagsSetter);
+  registry->Register(ValueGetter);
+  registry->Register(ValueSetter);
+  registry->Register(StepGetter);
+  registry->Register(StepSetter);
+  registry->Register(StepFastGetter);
+  registry->Register(StepFastSetter);
+}
+
 void InputNumberWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Local<Context> context = isolate->GetCurrentContext();
@@ -34,6 +34,7 @@ class InputTextWidget : public Widget {
                   ImGuiInputTextFlags flags = ImGuiInputTextFlags_None);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -84,6 +85,7 @@ class InputNumberWidget : public Widget {
                     ImGuiInputTextFlags flags = ImGuiInputTextFlags_None);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -1,4 +1,5 @@
 #include "nyx/env.h"
+#include "nyx/external_references.h"
 
 #include <imgui.h>
 
@@ -6,6 +7,7 @@ namespace nyx {
 
 using v8::Context;
 using v8::EscapableHandleScope;
+using v8::FunctionCallback;
 using v8::FunctionCallbackInfo;
 using v8::Isolate;
 using v8::Local;
@@ -14,419 +16,398 @@ using v8::Object;
 using v8::ObjectTemplate;
 using v8::Value;
 
+namespace {
+
+struct IOProperty {
+  const char* name;
+  FunctionCallback getter;
+  FunctionCallback setter;
+};
+
+struct IOMethod {
+  const char* name;
+  FunctionCallback callback;
+};
+
+// Tables rather than inline SetProperty calls so RegisterExternalReferencesIO sees the same callbacks.
+const IOProperty kIOProperties[] = {
+    {"deltaTime",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().DeltaTime);
+     },
+     nullptr},
+    {"displaySize",
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       Environment* env = Environment::GetCurrent(isolate);
+       Local<Context> context = env->context();
+       args.GetReturnValue().Set(ImGui::GetIO().DisplaySize.ToObject(context));
+     },
+     nullptr},
+    {"displayFramebufferScale",
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       Environment* env = Environment::GetCurrent(isolate);
+       Local<Context> context = env->context();
+       args.GetReturnValue().Set(ImGui::GetIO().DisplayFramebufferScale.ToObject(context));
+     },
+     nullptr},
+    {"mousePos",
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       Environment* env = Environment::GetCurrent(isolate);
+       Local<Context> context = env->context();
+       args.GetReturnValue().Set(ImGui::GetIO().MousePos.ToObject(context));
+     },
+     nullptr},
+    {"mouseWheel",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().MouseWheel);
+     },
+     nullptr},
+    {"mouseWheelH",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().MouseWheelH);
+     },
+     nullptr},
+    {"keyCtrl",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().KeyCtrl);
+     },
+     nullptr},
+    {"keyShift",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().KeyShift);
+     },
+     nullptr},
+    {"keyAlt",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().KeyAlt);
+     },
+     nullptr},
+    {"keySuper",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().KeySuper);
+     },
+     nullptr},
+    {"wantCaptureMouse",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().WantCaptureMouse);
+     },
+     nullptr},
+    {"wantCaptureKeyboard",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().WantCaptureKeyboard);
+     },
+     nullptr},
+    {"wantTextInput",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().WantTextInput);
+     },
+     nullptr},
+    {"wantSetMousePos",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().WantSetMousePos);
+     },
+     nullptr},
+    {"wantSaveIniSettings",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().WantSaveIniSettings);
+     },
+     nullptr},
+    {"navActive",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().NavActive);
+     },
+     nullptr},
+    {"navVisible",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().NavVisible);
+     },
+     nullptr},
+    {"framerate",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().Framerate);
+     },
+     nullptr},
+    {"metricsRenderVertices",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().MetricsRenderVertices);
+     },
+     nullptr},
+    {"metricsRenderIndices",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().MetricsRenderIndices);
+     },
+     nullptr},
+    {"metricsRenderWindows",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().MetricsRenderWindows);
+     },
+     nullptr},
+    {"metricsActiveWindows",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().MetricsActiveWindows);
+     },
+     nullptr},
+    {"fontGlobalScale",
+     [](const FunctionCallbackInfo<Value>& args) { args.GetReturnValue().Set(ImGui::GetIO().FontGlobalScale); },
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       Environment* env = Environment::GetCurrent(isolate);
+       Local<Context> context = env->context();
+       ImGui::GetIO().FontGlobalScale = args[0]->NumberValue(context).FromMaybe(1.0f);
+     }},
+    {"fontAllowUserScaling",
+     [](const FunctionCallbackInfo<Value>& args) { args.GetReturnValue().Set(ImGui::GetIO().FontAllowUserScaling); },
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       ImGui::GetIO().FontAllowUserScaling = args[0]->IsBoolean() ? args[0]->BooleanValue(isolate) : false;
+     }},
+    {"mouseDoubleClickTime",
+     [](const FunctionCallbackInfo<Value>& args) { args.GetReturnValue().Set(ImGui::GetIO().MouseDoubleClickTime); },
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       Environment* env = Environment::GetCurrent(isolate);
+       Local<Context> context = env->context();
+       ImGui::GetIO().MouseDoubleClickTime = args[0]->NumberValue(context).FromMaybe(0.3f);
+     }},
+    {"mouseDoubleClickMaxDist",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().MouseDoubleClickMaxDist);
+     },
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       Environment* env = Environment::GetCurrent(isolate);
+       Local<Context> context = env->context();
+       ImGui::GetIO().MouseDoubleClickMaxDist = args[0]->NumberValue(context).FromMaybe(6.0f);
+     }},
+    {"keyRepeatDelay",
+     [](const FunctionCallbackInfo<Value>& args) { args.GetReturnValue().Set(ImGui::GetIO().KeyRepeatDelay); },
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       Environment* env = Environment::GetCurrent(isolate);
+       Local<Context> context = env->context();
+       ImGui::GetIO().KeyRepeatDelay = args[0]->NumberValue(context).FromMaybe(0.275f);
+     }},
+    {"keyRepeatRate",
+     [](const FunctionCallbackInfo<Value>& args) { args.GetReturnValue().Set(ImGui::GetIO().KeyRepeatRate); },
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       Environment* env = Environment::GetCurrent(isolate);
+       Local<Context> context = env->context();
+       ImGui::GetIO().KeyRepeatRate = args[0]->NumberValue(context).FromMaybe(0.05f);
+     }},
+    {"configFlags",
+     [](const FunctionCallbackInfo<Value>& args) { args.GetReturnValue().Set(ImGui::GetIO().ConfigFlags); },
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       Environment* env = Environment::GetCurrent(isolate);
+       Local<Context> context = env->context();
+       ImGui::GetIO().ConfigFlags = args[0]->Uint32Value(context).FromMaybe(0);
+     }},
+    {"backendFlags",
+     [](const FunctionCallbackInfo<Value>& args) { args.GetReturnValue().Set(ImGui::GetIO().BackendFlags); },
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       Environment* env = Environment::GetCurrent(isolate);
+       Local<Context> context = env->context();
+       ImGui::GetIO().BackendFlags = args[0]->Uint32Value(context).FromMaybe(0);
+     }},
+    {"configInputTrickleEventQueue",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().ConfigInputTrickleEventQueue);
+     },
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       ImGui::GetIO().ConfigInputTrickleEventQueue = args[0]->BooleanValue(isolate);
+     }},
+    {"mouseDrawCursor",
+     [](const FunctionCallbackInfo<Value>& args) { args.GetReturnValue().Set(ImGui::GetIO().MouseDrawCursor); },
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       ImGui::GetIO().MouseDrawCursor = args[0]->BooleanValue(isolate);
+     }},
+    {"configInputTextCursorBlink",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().ConfigInputTextCursorBlink);
+     },
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       ImGui::GetIO().ConfigInputTextCursorBlink = args[0]->BooleanValue(isolate);
+     }},
+    {"configInputTextEnterKeepActive",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().ConfigInputTextEnterKeepActive);
+     },
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       ImGui::GetIO().ConfigInputTextEnterKeepActive = args[0]->BooleanValue(isolate);
+     }},
+    {"configDragClickToInputText",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().ConfigDragClickToInputText);
+     },
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       ImGui::GetIO().ConfigDragClickToInputText = args[0]->BooleanValue(isolate);
+     }},
+    {"configWindowsResizeFromEdges",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().ConfigWindowsResizeFromEdges);
+     },
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       ImGui::GetIO().ConfigWindowsResizeFromEdges = args[0]->BooleanValue(isolate);
+     }},
+    {"configWindowsMoveFromTitleBarOnly",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().ConfigWindowsMoveFromTitleBarOnly);
+     },
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       ImGui::GetIO().ConfigWindowsMoveFromTitleBarOnly = args[0]->BooleanValue(isolate);
+     }},
+    {"configMacOSXBehaviors",
+     [](const FunctionCallbackInfo<Value>& args) { args.GetReturnValue().Set(ImGui::GetIO().ConfigMacOSXBehaviors); },
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       ImGui::GetIO().ConfigMacOSXBehaviors = args[0]->BooleanValue(isolate);
+     }},
+    {"configDebugIsDebuggerPresent",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().ConfigDebugIsDebuggerPresent);
+     },
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       ImGui::GetIO().ConfigDebugIsDebuggerPresent = args[0]->BooleanValue(isolate);
+     }},
+    {"configDebugBeginReturnValueOnce",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().ConfigDebugBeginReturnValueOnce);
+     },
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       ImGui::GetIO().ConfigDebugBeginReturnValueOnce = args[0]->BooleanValue(isolate);
+     }},
+    {"configDebugBeginReturnValueLoop",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().ConfigDebugBeginReturnValueLoop);
+     },
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       ImGui::GetIO().ConfigDebugBeginReturnValueLoop = args[0]->BooleanValue(isolate);
+     }},
+    {"configDebugIgnoreFocusLoss",
+     [](const FunctionCallbackInfo<Value>& args) {
+       args.GetReturnValue().Set(ImGui::GetIO().ConfigDebugIgnoreFocusLoss);
+     },
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       ImGui::GetIO().ConfigDebugIgnoreFocusLoss = args[0]->BooleanValue(isolate);
+     }},
+    {"configDebugIniSettings",
+     [](const FunctionCallbackInfo<Value>& args) { args.GetReturnValue().Set(ImGui::GetIO().ConfigDebugIniSettings); },
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       ImGui::GetIO().ConfigDebugIniSettings = args[0]->BooleanValue(isolate);
+     }},
+};
+
+const IOMethod kIOMethods[] = {
+    {"isKeyDown",
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       Environment* env = Environment::GetCurrent(isolate);
+       Local<Context> context = env->context();
+       if (args.Length() < 1) { args.GetReturnValue().Set(false); return; }
+       int key = args[0]->Int32Value(context).FromMaybe(0);
+       args.GetReturnValue().Set(ImGui::IsKeyDown(static_cast<ImGuiKey>(key)));
+     }},
+    {"isKeyPressed",
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       Environment* env = Environment::GetCurrent(isolate);
+       Local<Context> context = env->context();
+       if (args.Length() < 1) { args.GetReturnValue().Set(false); return; }
+       int key = args[0]->Int32Value(context).FromMaybe(0);
+       bool repeat = args.Length() < 2 ? true : args[1]->BooleanValue(isolate);
+       args.GetReturnValue().Set(ImGui::IsKeyPressed(static_cast<ImGuiKey>(key), repeat));
+     }},
+    {"isKeyReleased",
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       Environment* env = Environment::GetCurrent(isolate);
+       Local<Context> context = env->context();
+       if (args.Length() < 1) { args.GetReturnValue().Set(false); return; }
+       int key = args[0]->Int32Value(context).FromMaybe(0);
+       args.GetReturnValue().Set(ImGui::IsKeyReleased(static_cast<ImGuiKey>(key)));
+     }},
+    {"isMouseDown",
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       Environment* env = Environment::GetCurrent(isolate);
+       Local<Context> context = env->context();
+       if (args.Length() < 1) { args.GetReturnValue().Set(false); return; }
+       int btn = args[0]->Int32Value(context).FromMaybe(0);
+       args.GetReturnValue().Set(ImGui::IsMouseDown(static_cast<ImGuiMouseButton>(btn)));
+     }},
+    {"isMouseClicked",
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       Environment* env = Environment::GetCurrent(isolate);
+       Local<Context> context = env->context();
+       if (args.Length() < 1) { args.GetReturnValue().Set(false); return; }
+       int btn = args[0]->Int32Value(context).FromMaybe(0);
+       bool repeat = args.Length() < 2 ? false : args[1]->BooleanValue(isolate);
+       args.GetReturnValue().Set(ImGui::IsMouseClicked(static_cast<ImGuiMouseButton>(btn), repeat));
+     }},
+    {"isMouseReleased",
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       Environment* env = Environment::GetCurrent(isolate);
+       Local<Context> context = env->context();
+       if (args.Length() < 1) { args.GetReturnValue().Set(false); return; }
+       int btn = args[0]->Int32Value(context).FromMaybe(0);
+       args.GetReturnValue().Set(ImGui::IsMouseReleased(static_cast<ImGuiMouseButton>(btn)));
+     }},
+    {"isMouseDoubleClicked",
+     [](const FunctionCallbackInfo<Value>& args) {
+       Isolate* isolate = args.GetIsolate();
+       Environment* env = Environment::GetCurrent(isolate);
+       Local<Context> context = env->context();
+       if (args.Length() < 1) { args.GetReturnValue().Set(false); return; }
+       int btn = args[0]->Int32Value(context).FromMaybe(0);
+       args.GetReturnValue().Set(ImGui::IsMouseDoubleClicked(static_cast<ImGuiMouseButton>(btn)));
+     }},
+};
+
+}  // namespace
+
 void CreatePerIsolatePropertiesIO(IsolateData* isolate_data, Local<ObjectTemplate> target) {
   Isolate* isolate = isolate_data->isolate();
   Local<ObjectTemplate> tmpl = ObjectTemplate::New(isolate);
 
-  SetProperty(isolate, tmpl, "deltaTime", [](const FunctionCallbackInfo<Value>& args) {
-    args.GetReturnValue().Set(ImGui::GetIO().DeltaTime);
-  });
-
-  SetProperty(isolate, tmpl, "displaySize", [](const FunctionCallbackInfo<Value>& args) {
-    Isolate* isolate = args.GetIsolate();
-    Environment* env = Environment::GetCurrent(isolate);
-    Local<Context> context = env->context();
-    args.GetReturnValue().Set(ImGui::GetIO().DisplaySize.ToObject(context));
-  });
-
-  SetProperty(isolate, tmpl, "displayFramebufferScale", [](const FunctionCallbackInfo<Value>& args) {
-    Isolate* isolate = args.GetIsolate();
-    Environment* env = Environment::GetCurrent(isolate);
-    Local<Context> context = env->context();
-    args.GetReturnValue().Set(ImGui::GetIO().DisplayFramebufferScale.ToObject(context));
-  });
-
-  SetProperty(isolate, tmpl, "mousePos", [](const FunctionCallbackInfo<Value>& args) {
-    Isolate* isolate = args.GetIsolate();
-    Environment* env = Environment::GetCurrent(isolate);
-    Local<Context> context = env->context();
-    args.GetReturnValue().Set(ImGui::GetIO().MousePos.ToObject(context));
-  });
-
-  SetProperty(isolate, tmpl, "mouseWheel", [](const FunctionCallbackInfo<Value>& args) {
-    args.GetReturnValue().Set(ImGui::GetIO().MouseWheel);
-  });
-
-  SetProperty(isolate, tmpl, "mouseWheelH", [](const FunctionCallbackInfo<Value>& args) {
-    args.GetReturnValue().Set(ImGui::GetIO().MouseWheelH);
-  });
-
-  SetProperty(isolate, tmpl, "keyCtrl", [](const FunctionCallbackInfo<Value>& args) {
-    args.GetReturnValue().Set(ImGui::GetIO().KeyCtrl);
-  });
-
-  SetProperty(isolate, tmpl, "keyShift", [](const FunctionCallbackInfo<Value>& args) {
-    args.GetReturnValue().Set(ImGui::GetIO().KeyShift);
-  });
-
-  SetProperty(isolate, tmpl, "keyAlt", [](const FunctionCallbackInfo<Value>& args) {
-    args.GetReturnValue().Set(ImGui::GetIO().KeyAlt);
-  });
-
-  SetProperty(isolate, tmpl, "keySuper", [](const FunctionCallbackInfo<Value>& args) {
-    args.GetReturnValue().Set(ImGui::GetIO().KeySuper);
-  });
-
-  SetProperty(isolate, tmpl, "wantCaptureMouse", [](const FunctionCallbackInfo<Value>& args) {
-    args.GetReturnValue().Set(ImGui::GetIO().WantCaptureMouse);
-  });
-
-  SetProperty(isolate, tmpl, "wantCaptureKeyboard", [](const FunctionCallbackInfo<Value>& args) {
-    args.GetReturnValue().Set(ImGui::GetIO().WantCaptureKeyboard);
-  });
-
-  SetProperty(isolate, tmpl, "wantTextInput", [](const FunctionCallbackInfo<Value>& args) {
-    args.GetReturnValue().Set(ImGui::GetIO().WantTextInput);
-  });
-
-  SetProperty(isolate, tmpl, "wantSetMousePos", [](const FunctionCallbackInfo<Value>& args) {
-    args.GetReturnValue().Set(ImGui::GetIO().WantSetMousePos);
-  });
-
-  SetProperty(isolate, tmpl, "wantSaveIniSettings", [](const FunctionCallbackInfo<Value>& args) {
-    args.GetReturnValue().Set(ImGui::GetIO().WantSaveIniSettings);
-  });
-
-  SetProperty(isolate, tmpl, "navActive", [](const FunctionCallbackInfo<Value>& args) {
-    args.GetReturnValue().Set(ImGui::GetIO().NavActive);
-  });
-
-  SetProperty(isolate, tmpl, "navVisible", [](const FunctionCallbackInfo<Value>& args) {
-    args.GetReturnValue().Set(ImGui::GetIO().NavVisible);
-  });
-
-  SetProperty(isolate, tmpl, "framerate", [](const FunctionCallbackInfo<Value>& args) {
-    args.GetReturnValue().Set(ImGui::GetIO().Framerate);
-  });
-
-  SetProperty(isolate, tmpl, "metricsRenderVertices", [](const FunctionCallbackInfo<Value>& args) {
-    args.GetReturnValue().Set(ImGui::GetIO().MetricsRenderVertices);
-  });
-
-  SetProperty(isolate, tmpl, "metricsRenderIndices", [](const FunctionCallbackInfo<Value>& args) {
-    args.GetReturnValue().Set(ImGui::GetIO().MetricsRenderIndices);
-  });
-
-  SetProperty(isolate, tmpl, "metricsRenderWindows", [](const FunctionCallbackInfo<Value>& args) {
-    args.GetReturnValue().Set(ImGui::GetIO().MetricsRenderWindows);
-  });
-
-  SetProperty(isolate, tmpl, "metricsActiveWindows", [](const FunctionCallbackInfo<Value>& args) {
-    args.GetReturnValue().Set(ImGui::GetIO().MetricsActiveWindows);
-  });
-
-  SetProperty(
-      isolate,
-      tmpl,
-      "fontGlobalScale",
-      [](const FunctionCallbackInfo<Value>& args) { args.GetReturnValue().Set(ImGui::GetIO().FontGlobalScale); },
-      [](const FunctionCallbackInfo<Value>& args) {
-        Isolate* isolate = args.GetIsolate();
-        Environment* env = Environment::GetCurrent(isolate);
-        Local<Context> context = env->context();
-        ImGui::GetIO().FontGlobalScale = args[0]->NumberValue(context).FromMaybe(1.0f);
-      });
-
-  SetProperty(
-      isolate,
-      tmpl,
-      "fontAllowUserScaling",
-      [](const FunctionCallbackInfo<Value>& args) { args.GetReturnValue().Set(ImGui::GetIO().FontAllowUserScaling); },
-      [](const FunctionCallbackInfo<Value>& args) {
-        Isolate* isolate = args.GetIsolate();
-        ImGui::GetIO().FontAllowUserScaling = args[0]->IsBoolean() ? args[0]->BooleanValue(isolate) : false;
-      });
-
-  SetProperty(
-      isolate,
-      tmpl,
-      "mouseDoubleClickTime",
-      [](const FunctionCallbackInfo<Value>& args) { args.GetReturnValue().Set(ImGui::GetIO().MouseDoubleClickTime); },
-      [](const FunctionCallbackInfo<Value>& args) {
-        Isolate* isolate = args.GetIsolate();
-        Environment* env = Environment::GetCurrent(isolate);
-        Local<Context> context = env->context();
-        ImGui::GetIO().MouseDoubleClickTime = args[0]->NumberValue(context).FromMaybe(0.3f);
-      });
-
-  SetProperty(
-      isolate,
-      tmpl,
-      "mouseDoubleClickMaxDist",
-      [](const FunctionCallbackInfo<Value>& args) {
-        args.GetReturnValue().Set(ImGui::GetIO().MouseDoubleClickMaxDist);
-      },
-      [](const FunctionCallbackInfo<Value>& args) {
-        Isolate* isolate = args.GetIsolate();
-        Environment* env = Environment::GetCurrent(isolate);
-        Local<Context> context = env->context();
-        ImGui::GetIO().MouseDoubleClickMaxDist = args[0]->NumberValue(context).FromMaybe(6.0f);
-      });
-
-  SetProperty(
-      isolate,
-      tmpl,
-      "keyRepeatDelay",
-      [](const FunctionCallbackInfo<Value>& args) { args.GetReturnValue().Set(ImGui::GetIO().KeyRepeatDelay); },
-      [](const FunctionCallbackInfo<Value>& args) {
-        Isolate* isolate = args.GetIsolate();
-        Environment* env = Environment::GetCurrent(isolate);
-        Local<Context> context = env->context();
-        ImGui::GetIO().KeyRepeatDelay = args[0]->NumberValue(context).FromMaybe(0.275f);
-      });
-
-  SetProperty(
-      isolate,
-      tmpl,
-      "keyRepeatRate",
-      [](const FunctionCallbackInfo<Value>& args) { args.GetReturnValue().Set(ImGui::GetIO().KeyRepeatRate); },
-      [](const FunctionCallbackInfo<Value>& args) {
-        Isolate* isolate = args.GetIsolate();
-        Environment* env = Environment::GetCurrent(isolate);
-        Local<Context> context = env->context();
-        ImGui::GetIO().KeyRepeatRate = args[0]->NumberValue(context).FromMaybe(0.05f);
-      });
-
-  SetProperty(
-      isolate,
-      tmpl,
-      "configFlags",
-      [](const FunctionCallbackInfo<Value>& args) { args.GetReturnValue().Set(ImGui::GetIO().ConfigFlags); },
-      [](const FunctionCallbackInfo<Value>& args) {
-        Isolate* isolate = args.GetIsolate();
-        Environment* env = Environment::GetCurrent(isolate);
-        Local<Context> context = env->context();
-        ImGui::GetIO().ConfigFlags = args[0]->Uint32Value(context).FromMaybe(0);
-      });
-
-  SetProperty(
-      isolate,
-      tmpl,
-      "backendFlags",
-      [](const FunctionCallbackInfo<Value>& args) { args.GetReturnValue().Set(ImGui::GetIO().BackendFlags); },
-      [](const FunctionCallbackInfo<Value>& args) {
-        Isolate* isolate = args.GetIsolate();
-        Environment* env = Environment::GetCurrent(isolate);
-        Local<Context> context = env->context();
-        ImGui::GetIO().BackendFlags = args[0]->Uint32Value(context).FromMaybe(0);
-      });
-
-  SetProperty(
-      isolate,
-      tmpl,
-      "configInputTrickleEventQueue",
-      [](const FunctionCallbackInfo<Value>& args) {
-        args.GetReturnValue().Set(ImGui::GetIO().ConfigInputTrickleEventQueue);
-      },
-      [](const FunctionCallbackInfo<Value>& args) {
-        Isolate* isolate = args.GetIsolate();
-        ImGui::GetIO().ConfigInputTrickleEventQueue = args[0]->BooleanValue(isolate);
-      });
-
-  SetProperty(
-      isolate,
-      tmpl,
-      "mouseDrawCursor",
-      [](const FunctionCallbackInfo<Value>& args) { args.GetReturnValue().Set(ImGui::GetIO().MouseDrawCursor); },
-      [](const FunctionCallbackInfo<Value>& args) {
-        Isolate* isolate = args.GetIsolate();
-        ImGui::GetIO().MouseDrawCursor = args[0]->BooleanValue(isolate);
-      });
-
-  SetProperty(
-      isolate,
-      tmpl,
-      "configInputTextCursorBlink",
-      [](const FunctionCallbackInfo<Value>& args) {
-        args.GetReturnValue().Set(ImGui::GetIO().ConfigInputTextCursorBlink);
-      },
-      [](const FunctionCallbackInfo<Value>& args) {
-        Isolate* isolate = args.GetIsolate();
-        ImGui::GetIO().ConfigInputTextCursorBlink = args[0]->BooleanValue(isolate);
-      });
-
-  SetProperty(
-      isolate,
-      tmpl,
-      "configInputTextEnterKeepActive",
-      [](const FunctionCallbackInfo<Value>& args) {
-        args.GetReturnValue().Set(ImGui::GetIO().ConfigInputTextEnterKeepActive);
-      },
-      [](const FunctionCallbackInfo<Value>& args) {
-        Isolate* isolate = args.GetIsolate();
-        ImGui::GetIO().ConfigInputTextEnterKeepActive = args[0]->BooleanValue(isolate);
-      });
-
-  SetProperty(
-      isolate,
-      tmpl,
-      "configDragClickToInputText",
-      [](const FunctionCallbackInfo<Value>& args) {
-        args.GetReturnValue().Set(ImGui::GetIO().ConfigDragClickToInputText);
-      },
-      [](const FunctionCallbackInfo<Value>& args) {
-        Isolate* isolate = args.GetIsolate();
-        ImGui::GetIO().ConfigDragClickToInputText = args[0]->BooleanValue(isolate);
-      });
-
-  SetProperty(
-      isolate,
-      tmpl,
-      "configWindowsResizeFromEdges",
-      [](const FunctionCallbackInfo<Value>& args) {
-        args.GetReturnValue().Set(ImGui::GetIO().ConfigWindowsResizeFromEdges);
-      },
-      [](const FunctionCallbackInfo<Value>& args) {
-        Isolate* isolate = args.GetIsolate();
-        ImGui::GetIO().ConfigWindowsResizeFromEdges = args[0]->BooleanValue(isolate);
-      });
-
-  SetProperty(
-      isolate,
-      tmpl,
-      "configWindowsMoveFromTitleBarOnly",
-      [](const FunctionCallbackInfo<Value>& args) {
-        args.GetReturnValue().Set(ImGui::GetIO().ConfigWindowsMoveFromTitleBarOnly);
-      },
-      [](const FunctionCallbackInfo<Value>& args) {
-        Isolate* isolate = args.GetIsolate();
-        ImGui::GetIO().ConfigWindowsMoveFromTitleBarOnly = args[0]->BooleanValue(isolate);
-      });
-
-  SetProperty(
-      isolate,
-      tmpl,
-      "configMacOSXBehaviors",
-      [](const FunctionCallbackInfo<Value>& args) { args.GetReturnValue().Set(ImGui::GetIO().ConfigMacOSXBehaviors); },
-      [](const FunctionCallbackInfo<Value>& args) {
-        Isolate* isolate = args.GetIsolate();
-        ImGui::GetIO().ConfigMacOSXBehaviors = args[0]->BooleanValue(isolate);
-      });
-
-  SetProperty(
-      isolate,
-      tmpl,
-      "configDebugIsDebuggerPresent",
-      [](const FunctionCallbackInfo<Value>& args) {
-        args.GetReturnValue().Set(ImGui::GetIO().ConfigDebugIsDebuggerPresent);
-      },
-      [](const FunctionCallbackInfo<Value>& args) {
-        Isolate* isolate = args.GetIsolate();
-        ImGui::GetIO().ConfigDebugIsDebuggerPresent = args[0]->BooleanValue(isolate);
-      });
-
-  SetProperty(
-      isolate,
-      tmpl,
-      "configDebugBeginReturnValueOnce",
-      [](const FunctionCallbackInfo<Value>& args) {
-        args.GetReturnValue().Set(ImGui::GetIO().ConfigDebugBeginReturnValueOnce);
-      },
-      [](const FunctionCallbackInfo<Value>& args) {
-        Isolate* isolate = args.GetIsolate();
-        ImGui::GetIO().ConfigDebugBeginReturnValueOnce = args[0]->BooleanValue(isolate);
-      });
-
-  SetProperty(
-      isolate,
-      tmpl,
-      "configDebugBeginReturnValueLoop",
-      [](const FunctionCallbackInfo<Value>& args) {
-        args.GetReturnValue().Set(ImGui::GetIO().ConfigDebugBeginReturnValueLoop);
-      },
-      [](const FunctionCallbackInfo<Value>& args) {
-        Isolate* isolate = args.GetIsolate();
-        ImGui::GetIO().ConfigDebugBeginReturnValueLoop = args[0]->BooleanValue(isolate);
-      });
-
-  SetProperty(
-      isolate,
-      tmpl,
-      "configDebugIgnoreFocusLoss",
-      [](const FunctionCallbackInfo<Value>& args) {
-        args.GetReturnValue().Set(ImGui::GetIO().ConfigDebugIgnoreFocusLoss);
-      },
-      [](const FunctionCallbackInfo<Value>& args) {
-        Isolate* isolate = args.GetIsolate();
-        ImGui::GetIO().ConfigDebugIgnoreFocusLoss = args[0]->BooleanValue(isolate);
-      });
-
-  SetProperty(
-      isolate,
-      tmpl,
-      "configDebugIniSettings",
-      [](const FunctionCallbackInfo<Value>& args) { args.GetReturnValue().Set(ImGui::GetIO().ConfigDebugIniSettings); },
-      [](const FunctionCallbackInfo<Value>& args) {
-        Isolate* isolate = args.GetIsolate();
-        ImGui::GetIO().ConfigDebugIniSettings = args[0]->BooleanValue(isolate);
-      });
-
-  SetMethod(isolate, tmpl, "isKeyDown", [](const FunctionCallbackInfo<Value>& args) {
-    Isolate* isolate = args.GetIsolate();
-    Environment* env = Environment::GetCurrent(isolate);
-    Local<Context> context = env->context();
-    if (args.Length() < 1) { args.GetReturnValue().Set(false); return; }
-    int key = args[0]->Int32Value(context).FromMaybe(0);
-    args.GetReturnValue().Set(ImGui::IsKeyDown(static_cast<ImGuiKey>(key)));
-  });
-
-  SetMethod(isolate, tmpl, "isKeyPressed", [](const FunctionCallbackInfo<Value>& args) {
-    Isolate* isolate = args.GetIsolate();
-    Environment* env = Environment::GetCurrent(isolate);
-    Local<Context> context = env->context();
-    if (args.Length() < 1) { args.GetReturnValue().Set(false); return; }
-    int key = args[0]->Int32Value(context).FromMaybe(0);
-    bool repeat = args.Length() < 2 ? true : args[1]->BooleanValue(isolate);
-    args.GetReturnValue().Set(ImGui::IsKeyPressed(static_cast<ImGuiKey>(key), repeat));
-  });
-
-  SetMethod(isolate, tmpl, "isKeyReleased", [](const FunctionCallbackInfo<Value>& args) {
-    Isolate* isolate = args.GetIsolate();
-    Environment* env = Environment::GetCurrent(isolate);
-    Local<Context> context = env->context();
-    if (args.Length() < 1) { args.GetReturnValue().Set(false); return; }
-    int key = args[0]->Int32Value(context).FromMaybe(0);
-    args.GetReturnValue().Set(ImGui::IsKeyReleased(static_cast<ImGuiKey>(key)));
-  });
-
-  SetMethod(isolate, tmpl, "isMouseDown", [](const FunctionCallbackInfo<Value>& args) {
-    Isolate* isolate = args.GetIsolate();
-    Environment* env = Environment::GetCurrent(isolate);
-    Local<Context> context = env->context();
-    if (args.Length() < 1) { args.GetReturnValue().Set(false); return; }
-    int btn = args[0]->Int32Value(context).FromMaybe(0);
-    args.GetReturnValue().Set(ImGui::IsMouseDown(static_cast<ImGuiMouseButton>(btn)));
-  });
-
-  SetMethod(isolate, tmpl, "isMouseClicked", [](const FunctionCallbackInfo<Value>& args) {
-    Isolate* isolate = args.GetIsolate();
-    Environment* env = Environment::GetCurrent(isolate);
-    Local<Context> context = env->context();
-    if (args.Length() < 1) { args.GetReturnValue().Set(false); return; }
-    int btn = args[0]->Int32Value(context).FromMaybe(0);
-    bool repeat = args.Length() < 2 ? false : args[1]->BooleanValue(isolate);
-    args.GetReturnValue().Set(ImGui::IsMouseClicked(static_cast<ImGuiMouseButton>(btn), repeat));
-  });
-
-  SetMethod(isolate, tmpl, "isMouseReleased", [](const FunctionCallbackInfo<Value>& args) {
-    Isolate* isolate = args.GetIsolate();
-    Environment* env = Environment::GetCurrent(isolate);
-    Local<Context> context = env->context();
-    if (args.Length() < 1) { args.GetReturnValue().Set(false); return; }
-    int btn = args[0]->Int32Value(context).FromMaybe(0);
-    args.GetReturnValue().Set(ImGui::IsMouseReleased(static_cast<ImGuiMouseButton>(btn)));
-  });
-
-  SetMethod(isolate, tmpl, "isMouseDoubleClicked", [](const FunctionCallbackInfo<Value>& args) {
-    Isolate* isolate = args.GetIsolate();
-    Environment* env = Environment::GetCurrent(isolate);
-    Local<Context> context = env->context();
-    if (args.Length() < 1) { args.GetReturnValue().Set(false); return; }
-    int btn = args[0]->Int32Value(context).FromMaybe(0);
-    args.GetReturnValue().Set(ImGui::IsMouseDoubleClicked(static_cast<ImGuiMouseButton>(btn)));
-  });
+  for (const IOProperty& property : kIOProperties) {
+    SetProperty(isolate, tmpl, property.name, property.getter, property.setter);
+  }
+  for (const IOMethod& method : kIOMethods) {
+    SetMethod(isolate, tmpl, method.name, method.callback);
+  }
 
   target->Set(isolate, "io", tmpl);
 }
 
+void RegisterExternalReferencesIO(ExternalReferenceRegistry* registry) {
+  for (const IOProperty& property : kIOProperties) {
+    registry->Register(property.getter);
+    if (property.setter) {
+      registry->Register(property.setter);
+    }
+  }
+  for (const IOMethod& method : kIOMethods) {
+    registry->Register(method.callback);
+  }
+}
+
 }  // namespace nyx
@@ -1,6 +1,7 @@
 #include "nyx/gui/layout.h"
 
 #include "nyx/env.h"
+#include "nyx/external_references.h"
 
 namespace nyx {
   
@@ -24,6 +25,10 @@ void SeparatorWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate
   target->Set(FixedOneByteString(isolate, "Separator"), tmpl);
 }
 
+void SeparatorWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+}
+
 void SeparatorWidget::New(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args.GetIsolate());
   new SeparatorWidget(env->principal_realm(), args.This());
@@ -43,6 +48,10 @@ void SpacingWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate>
   target->Set(FixedOneByteString(isolate, "Spacing"), tmpl);
 }
 
+void SpacingWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+}
+
 void SpacingWidget::New(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args.GetIsolate());
   new SpacingWidget(env->principal_realm(), args.This());
@@ -65,6 +74,10 @@ void SameLineWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate>
   target->Set(FixedOneByteString(isolate, "SameLine"), tmpl);
 }
 
+void SameLineWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+}
+
 void SameLineWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Local<Context> context = isolate->GetCurrentContext();
@@ -88,6 +101,10 @@ void NewLineWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate>
   target->Set(FixedOneByteString(isolate, "NewLine"), tmpl);
 }
 
+void NewLineWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+}
+
 void NewLineWidget::New(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args.GetIsolate());
   new NewLineWidget(env->principal_realm(), args.This());
@@ -110,6 +127,10 @@ void IndentWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate> t
   target->Set(FixedOneByteString(isolate, "Indent"), tmpl);
 }
 
+void IndentWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+}
+
 void IndentWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Local<Context> context = isolate->GetCurrentContext();
@@ -137,6 +158,10 @@ void UnindentWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate>
   target->Set(FixedOneByteString(isolate, "Unindent"), tmpl);
 }
 
+void UnindentWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+}
+
 void UnindentWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Local<Context> context = isolate->GetCurrentContext();
@@ -164,6 +189,10 @@ void DummyWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate> ta
   target->Set(FixedOneByteString(isolate, "Dummy"), tmpl);
 }
 
+void DummyWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+}
+
 void DummyWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Local<Context> context = isolate->GetCurrentContext();
@@ -187,6 +216,10 @@ void GroupWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate> ta
   target->Set(FixedOneByteString(isolate, "Group"), tmpl);
 }
 
+void GroupWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+}
+
 void GroupWidget::New(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args.GetIsolate());
   new GroupWidget(env->principal_realm(), args.This());
@@ -213,6 +246,12 @@ void DisabledWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate>
   target->Set(FixedOneByteString(isolate, "Disabled"), tmpl);
 }
 
+void DisabledWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetDisabled);
+  registry->Register(SetDisabled);
+}
+
 void DisabledWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Environment* env = Environment::GetCurrent(isolate);
@@ -37,6 +37,7 @@ class SeparatorWidget : public Widget {
   using Widget::Widget;
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -48,6 +49,7 @@ class SpacingWidget : public Widget {
   using Widget::Widget;
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -59,6 +61,7 @@ class SameLineWidget : public Widget {
   SameLineWidget(Realm* realm, v8::Local<v8::Object> object, float offset, float spacing);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -74,6 +77,7 @@ class NewLineWidget : public Widget {
   using Widget::Widget;
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -85,6 +89,7 @@ class IndentWidget : public Widget {
   IndentWidget(Realm* realm, v8::Local<v8::Object> object, float width);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -100,6 +105,7 @@ class UnindentWidget : public Widget {
   UnindentWidget(Realm* realm, v8::Local<v8::Object> object, float width);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -115,6 +121,7 @@ class DummyWidget : public Widget {
   DummyWidget(Realm* realm, v8::Local<v8::Object> object, float width, float height);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -129,6 +136,7 @@ class GroupWidget : public Widget {
   using Widget::Widget;
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -141,6 +149,7 @@ class DisabledWidget : public Widget {
   DisabledWidget(Realm* realm, v8::Local<v8::Object> object, bool disabled);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -1,6 +1,7 @@
 #include "nyx/gui/listbox.h"
 
 #include "nyx/env.h"
+#include "nyx/external_references.h"
 
 namespace nyx {
 
@@ -41,6 +42,13 @@ void ListBoxWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate>
   target->Set(FixedOneByteString(isolate, "ListBox"), tmpl);
 }
 
+void ListBoxWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetSelected);
+  registry->Register(SetSelected);
+  registry->Register(SetItems);
+}
+
 static std::vector<std::string> ArrayToStringVector(Isolate* isolate, Local<Context> context, Local<Value> val) {
   std::vector<std::string> result;
   if (!val->IsArray()) return result;
@@ -1,6 +1,7 @@
 #include "nyx/gui/menus.h"
 
 #include "nyx/env.h"
+#include "nyx/external_references.h"
 
 namespace nyx {
 
@@ -26,6 +27,10 @@ void MainMenuBarWidget::Initialize(IsolateData* isolate_data, Local<ObjectTempla
   target->Set(FixedOneByteString(isolate, "MainMenuBar"), tmpl);
 }
 
+void MainMenuBarWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+}
+
 void MainMenuBarWidget::New(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args.GetIsolate());
   new MainMenuBarWidget(env->principal_realm(), args.This());
@@ -48,6 +53,10 @@ void MenuBarWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate>
   target->Set(FixedOneByteString(isolate, "MenuBar"), tmpl);
 }
 
+void MenuBarWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+}
+
 void MenuBarWidget::New(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args.GetIsolate());
   new MenuBarWidget(env->principal_realm(), args.This());
@@ -72,6 +81,10 @@ void MenuWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate> tar
   target->Set(FixedOneByteString(isolate, "Menu"), tmpl);
 }
 
+void MenuWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+}
+
 void MenuWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Environment* env = Environment::GetCurrent(isolate);
@@ -103,6 +116,13 @@ void MenuItemWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate>
   target->Set(FixedOneByteString(isolate, "MenuItem"), tmpl);
 }
 
+void MenuItemWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetClicked);
+  registry->Register(GetSelected);
+  registry->Register(SetSelected);
+}
+
 void MenuItemWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Environment* env = Environment::GetCurrent(isolate);
@@ -19,6 +19,7 @@ class MainMenuBarWidget : public Widget {
   using Widget::Widget;
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -31,6 +32,7 @@ class MenuBarWidget : public Widget {
   using Widget::Widget;
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -43,6 +45,7 @@ class MenuWidget : public Widget {
   MenuWidget(Realm* realm, v8::Local<v8::Object> object, const std::string& label);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -58,6 +61,7 @@ class MenuItemWidget : public Widget {
       Realm* realm, v8::Local<v8::Object> object, const std::string& label, const std::string& shortcut, bool selected);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
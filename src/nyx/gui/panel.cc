@@ -1,6 +1,7 @@
 #include "nyx/gui/panel.h"
 
 #include "nyx/env.h"
+#include "nyx/external_references.h"
 #include "nyx/gui/widget_manager.h"
 #include "nyx/isolate_data.h"
 
@@ -39,6 +40,18 @@ void PanelWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate> ta
   target->Set(FixedOneByteString(isolate, "Panel"), tmpl);
 }
 
+void PanelWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetOpen);
+  registry->Register(SetOpen);
+  registry->Register(GetTitle);
+  registry->Register(SetTitle);
+  registry->Register(GetFlags);
+  registry->Register(SetFlags);
+  registry->Register(GetVisible);
+  registry->Register(GetCanvas);
+}
+
 void PanelWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Environment* env = Environment::GetCurrent(isolate);
@@ -1,6 +1,7 @@
 #include "nyx/gui/plotting.h"
 
 #include "nyx/env.h"
+#include "nyx/external_references.h"
 
 namespace nyx {
 
@@ -44,6 +45,11 @@ void PlotLinesWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate
   target->Set(FixedOneByteString(isolate, "PlotLines"), tmpl);
 }
 
+void PlotLinesWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(SetValues);
+}
+
 static std::vector<float> ArrayToFloatVector(Isolate* isolate, Local<Context> context, Local<Value> val) {
   std::vector<float> result;
   if (!val->IsArray()) return result;
@@ -125,6 +131,11 @@ void PlotHistogramWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemp
   target->Set(FixedOneByteString(isolate, "PlotHistogram"), tmpl);
 }
 
+void PlotHistogramWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(SetValues);
+}
+
 void PlotHistogramWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Local<Context> context = isolate->GetCurrentContext();
@@ -1,6 +1,7 @@
 #include "nyx/gui/popups.h"
 
 #include "nyx/env.h"
+#include "nyx/external_references.h"
 
 namespace nyx {
   
@@ -30,6 +31,12 @@ void PopupWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate> ta
   target->Set(FixedOneByteString(isolate, "Popup"), tmpl);
 }
 
+void PopupWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(Open);
+  registry->Register(Close);
+}
+
 void PopupWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Environment* env = Environment::GetCurrent(isolate);
@@ -79,6 +86,13 @@ void ModalWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate> ta
   target->Set(FixedOneByteString(isolate, "Modal"), tmpl);
 }
 
+void ModalWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(Open);
+  registry->Register(Close);
+  registry->Register(IsOpen);
+}
+
 void ModalWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Environment* env = Environment::GetCurrent(isolate);
@@ -22,6 +22,7 @@ class PopupWidget : public Widget {
   PopupWidget(Realm* realm, v8::Local<v8::Object> object, const std::string& id);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -44,6 +45,7 @@ class ModalWidget : public Widget {
   ModalWidget(Realm* realm, v8::Local<v8::Object> object, const std::string& title);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -1,6 +1,7 @@
 #include "nyx/gui/selectable.h"
 
 #include "nyx/env.h"
+#include "nyx/external_references.h"
 
 namespace nyx {
 
@@ -31,6 +32,12 @@ void SelectableWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplat
   target->Set(FixedOneByteString(isolate, "Selectable"), tmpl);
 }
 
+void SelectableWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetSelected);
+  registry->Register(SetSelected);
+}
+
 void SelectableWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Environment* env = Environment::GetCurrent(isolate);
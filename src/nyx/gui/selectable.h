@@ -13,6 +13,7 @@ class SelectableWidget : public Widget {
   SelectableWidget(Realm* realm, v8::Local<v8::Object> object, const std::string& label, bool selected);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -1,6 +1,7 @@
 #include "nyx/gui/slider.h"
 
 #include "nyx/env.h"
+#include "nyx/external_references.h"
 
 namespace nyx {
 
@@ -33,6 +34,12 @@ void SliderFloatWidget::Initialize(IsolateData* isolate_data, Local<ObjectTempla
   target->Set(FixedOneByteString(isolate, "SliderFloat"), tmpl);
 }
 
+void SliderFloatWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetValue);
+  registry->Register(SetValue);
+}
+
 void SliderFloatWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Local<Context> context = isolate->GetCurrentContext();
@@ -83,6 +90,12 @@ void SliderIntWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate
   target->Set(FixedOneByteString(isolate, "SliderInt"), tmpl);
 }
 
+void SliderIntWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetValue);
+  registry->Register(SetValue);
+}
+
 void SliderIntWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Local<Context> context = isolate->GetCurrentContext();
@@ -133,6 +146,12 @@ void DragFloatWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate
   target->Set(FixedOneByteString(isolate, "DragFloat"), tmpl);
 }
 
+void DragFloatWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetValue);
+  registry->Register(SetValue);
+}
+
 void DragFloatWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Local<Context> context = isolate->GetCurrentContext();
@@ -184,6 +203,12 @@ void DragIntWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate>
   target->Set(FixedOneByteString(isolate, "DragInt"), tmpl);
 }
 
+void DragIntWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetValue);
+  registry->Register(SetValue);
+}
+
 void DragIntWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Local<Context> context = isolate->GetCurrentContext();
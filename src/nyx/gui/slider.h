@@ -20,6 +20,7 @@ class SliderFloatWidget : public Widget {
       Realm* realm, v8::Local<v8::Object> object, const std::string& label, float min, float max, float value);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -46,6 +47,7 @@ class SliderIntWidget : public Widget {
   SliderIntWidget(Realm* realm, v8::Local<v8::Object> object, const std::string& label, int min, int max, int value);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -78,6 +80,7 @@ class DragFloatWidget : public Widget {
                   float max);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -98,6 +101,7 @@ class DragIntWidget : public Widget {
       Realm* realm, v8::Local<v8::Object> object, const std::string& label, int value, float speed, int min, int max);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
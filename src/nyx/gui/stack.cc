@@ -1,6 +1,7 @@
 #include "nyx/gui/stack.h"
 
 #include "nyx/env.h"
+#include "nyx/external_references.h"
 
 namespace nyx {
 
@@ -39,6 +40,26 @@ void StackWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate> ta
   target->Set(FixedOneByteString(isolate, "Stack"), tmpl);
 }
 
+void StackWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetID);
+  registry->Register(SetID);
+  registry->Register(GetClipRect);
+  registry->Register(SetClipRect);
+  registry->Register(GetColors);
+  registry->Register(SetColor);
+  registry->Register(GetVars);
+  registry->Register(SetVar);
+  registry->Register(GetTabStop);
+  registry->Register(SetTabStop);
+  registry->Register(GetButtonRepeat);
+  registry->Register(SetButtonRepeat);
+  registry->Register(GetItemWidth);
+  registry->Register(SetItemWidth);
+  registry->Register(GetTextWrap);
+  registry->Register(SetTextWrap);
+}
+
 void StackWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Local<Context> context = isolate->GetCurrentContext();
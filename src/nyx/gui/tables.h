@@ -29,6 +29,7 @@ class TableWidget : public Widget {
   TableWidget(Realm* realm, v8::Local<v8::Object> object, const std::string& id, int columns, ImGuiTableFlags flags);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -55,6 +56,7 @@ class TableRowWidget : public Widget {
   using Widget::Widget;
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
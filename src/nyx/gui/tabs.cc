@@ -1,6 +1,7 @@
 #include "nyx/gui/tabs.h"
 
 #include "nyx/env.h"
+#include "nyx/external_references.h"
 
 namespace nyx {
 
@@ -30,6 +31,10 @@ void TabBarWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate> t
   target->Set(FixedOneByteString(isolate, "TabBar"), tmpl);
 }
 
+void TabBarWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+}
+
 void TabBarWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Environment* env = Environment::GetCurrent(isolate);
@@ -59,6 +64,11 @@ void TabItemWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate>
   target->Set(FixedOneByteString(isolate, "TabItem"), tmpl);
 }
 
+void TabItemWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetSelected);
+}
+
 void TabItemWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Environment* env = Environment::GetCurrent(isolate);
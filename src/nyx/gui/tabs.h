@@ -18,6 +18,7 @@ class TabBarWidget : public Widget {
   TabBarWidget(Realm* realm, v8::Local<v8::Object> object, const std::string& id);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -33,6 +34,7 @@ class TabItemWidget : public Widget {
   TabItemWidget(Realm* realm, v8::Local<v8::Object> object, const std::string& label);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
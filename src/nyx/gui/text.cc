@@ -1,6 +1,7 @@
 #include "nyx/gui/text.h"
 
 #include "nyx/env.h"
+#include "nyx/external_references.h"
 
 namespace nyx {
 
@@ -32,6 +33,12 @@ void TextWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate> tar
   target->Set(FixedOneByteString(isolate, "Text"), tmpl);
 }
 
+void TextWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetText);
+  registry->Register(SetText);
+}
+
 void TextWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Environment* env = Environment::GetCurrent(isolate);
@@ -74,6 +81,12 @@ void TextColoredWidget::Initialize(IsolateData* isolate_data, Local<ObjectTempla
   target->Set(FixedOneByteString(isolate, "TextColored"), tmpl);
 }
 
+void TextColoredWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetText);
+  registry->Register(SetText);
+}
+
 void TextColoredWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Local<Context> context = isolate->GetCurrentContext();
@@ -120,6 +133,12 @@ void TextWrappedWidget::Initialize(IsolateData* isolate_data, Local<ObjectTempla
   target->Set(FixedOneByteString(isolate, "TextWrapped"), tmpl);
 }
 
+void TextWrappedWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetText);
+  registry->Register(SetText);
+}
+
 void TextWrappedWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Environment* env = Environment::GetCurrent(isolate);
@@ -161,6 +180,12 @@ void TextDisabledWidget::Initialize(IsolateData* isolate_data, Local<ObjectTempl
   target->Set(FixedOneByteString(isolate, "TextDisabled"), tmpl);
 }
 
+void TextDisabledWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetText);
+  registry->Register(SetText);
+}
+
 void TextDisabledWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Environment* env = Environment::GetCurrent(isolate);
@@ -202,6 +227,12 @@ void LabelTextWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate
   target->Set(FixedOneByteString(isolate, "LabelText"), tmpl);
 }
 
+void LabelTextWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetText);
+  registry->Register(SetText);
+}
+
 void LabelTextWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Environment* env = Environment::GetCurrent(isolate);
@@ -245,6 +276,12 @@ void BulletTextWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplat
   target->Set(FixedOneByteString(isolate, "BulletText"), tmpl);
 }
 
+void BulletTextWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetText);
+  registry->Register(SetText);
+}
+
 void BulletTextWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Environment* env = Environment::GetCurrent(isolate);
@@ -286,6 +323,12 @@ void SeparatorTextWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemp
   target->Set(FixedOneByteString(isolate, "SeparatorText"), tmpl);
 }
 
+void SeparatorTextWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetText);
+  registry->Register(SetText);
+}
+
 void SeparatorTextWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Environment* env = Environment::GetCurrent(isolate);
@@ -19,6 +19,7 @@ class TextWidget : public Widget {
   TextWidget(Realm* realm, v8::Local<v8::Object> object, const std::string& text);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -40,6 +41,7 @@ class TextColoredWidget : public Widget {
       Realm* realm, v8::Local<v8::Object> object, const std::string& text, float r, float g, float b, float a);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -71,6 +73,7 @@ class TextWrappedWidget : public Widget {
   TextWrappedWidget(Realm* realm, v8::Local<v8::Object> object, const std::string& text);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -90,6 +93,7 @@ class TextDisabledWidget : public Widget {
   TextDisabledWidget(Realm* realm, v8::Local<v8::Object> object, const std::string& text);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -109,6 +113,7 @@ class LabelTextWidget : public Widget {
   LabelTextWidget(Realm* realm, v8::Local<v8::Object> object, const std::string& label, const std::string& text);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -128,6 +133,7 @@ class BulletTextWidget : public Widget {
   BulletTextWidget(Realm* realm, v8::Local<v8::Object> object, const std::string& text);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -147,6 +153,7 @@ class SeparatorTextWidget : public Widget {
   SeparatorTextWidget(Realm* realm, v8::Local<v8::Object> object, const std::string& text);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
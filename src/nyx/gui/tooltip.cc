@@ -1,6 +1,7 @@
 #include "nyx/gui/tooltip.h"
 
 #include "nyx/env.h"
+#include "nyx/external_references.h"
 
 namespace nyx {
   
@@ -32,6 +33,12 @@ void TooltipWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate>
   target->Set(FixedOneByteString(isolate, "Tooltip"), tmpl);
 }
 
+void TooltipWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetText);
+  registry->Register(SetText);
+}
+
 void TooltipWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Environment* env = Environment::GetCurrent(isolate);
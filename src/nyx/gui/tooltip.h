@@ -17,6 +17,7 @@ class TooltipWidget : public Widget {
   TooltipWidget(Realm* realm, v8::Local<v8::Object> object, const std::string& text);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
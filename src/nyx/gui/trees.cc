@@ -1,6 +1,7 @@
 #include "nyx/gui/trees.h"
 
 #include "nyx/env.h"
+#include "nyx/external_references.h"
 
 namespace nyx {
 
@@ -32,6 +33,11 @@ void TreeNodeWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate>
   target->Set(FixedOneByteString(isolate, "TreeNode"), tmpl);
 }
 
+void TreeNodeWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetOpen);
+}
+
 void TreeNodeWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Environment* env = Environment::GetCurrent(isolate);
@@ -70,6 +76,11 @@ void CollapsingHeaderWidget::Initialize(IsolateData* isolate_data, Local<ObjectT
   target->Set(FixedOneByteString(isolate, "CollapsingHeader"), tmpl);
 }
 
+void CollapsingHeaderWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(GetOpen);
+}
+
 void CollapsingHeaderWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Local<Context> context = isolate->GetCurrentContext();
@@ -18,6 +18,7 @@ class TreeNodeWidget : public Widget {
   TreeNodeWidget(Realm* realm, v8::Local<v8::Object> object, const std::string& label);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
@@ -40,6 +41,7 @@ class CollapsingHeaderWidget : public Widget {
                          ImGuiTreeNodeFlags flags);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
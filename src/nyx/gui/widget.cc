@@ -1,7 +1,9 @@
 #include "nyx/gui/widget.h"
 
 #include "nyx/env.h"
+#include "nyx/external_references.h"
 #include "nyx/gui/widget_manager.h"
+#include "nyx/package_watchdog.h"
 
 #include <algorithm>
 
@@ -23,7 +25,7 @@ using v8::String;
 using v8::Value;
 
 Widget::Widget(Realm* realm, Local<Object> object, std::string_view label)
-    : BaseObject(realm, object), label_(label) {
+    : BaseObject(realm, object), label_(label), package_(realm->env()->package_watchdog().current_package()) {
   ClearWeak();  // prevent GC by default; destroy() makes it weak again
 }
 
@@ -136,6 +138,16 @@ Local<FunctionTemplate> Widget::GetConstructorTemplate(IsolateData* isolate_data
   return tmpl;
 }
 
+void Widget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(Add);
+  registry->Register(Remove);
+  registry->Register(On);
+  registry->Register(Off);
+  registry->Register(Destroy);
+  registry->Register(VisibleGetter);
+  registry->Register(VisibleSetter);
+}
+
 void Widget::AddChild(Widget* child) {
   if (child->parent_) {
     child->parent_->RemoveChild(child);
@@ -208,6 +220,8 @@ void Widget::EmitEvent(const std::string& event) {
   Isolate* iso = isolate();
   HandleScope scope(iso);
   Local<Context> ctx = env()->context();
+  PackageWatchdog::Scope package_scope(&env()->package_watchdog(), package_);
+  if (package_scope.stopped()) return;
   for (const Global<Function>& it : it->second) {
     Local<Function> fn = it.Get(iso);
     if (fn.IsEmpty()) continue;
@@ -224,6 +238,8 @@ void Widget::EmitEvent(const std::string& event, Local<Value> arg) {
   Isolate* iso = isolate();
   HandleScope scope(iso);
   Local<Context> ctx = env()->context();
+  PackageWatchdog::Scope package_scope(&env()->package_watchdog(), package_);
+  if (package_scope.stopped()) return;
   for (const Global<Function>& it : it->second) {
     Local<Function> fn = it.Get(iso);
     if (fn.IsEmpty()) continue;
@@ -257,6 +273,10 @@ void ChildWidget::Initialize(IsolateData* isolate_data, Local<ObjectTemplate> ta
   target->Set(FixedOneByteString(isolate, "Child"), tmpl);
 }
 
+void ChildWidget::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+}
+
 void ChildWidget::New(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Local<Context> context = isolate->GetCurrentContext();
@@ -81,6 +81,7 @@
 namespace nyx {
 
 class Environment;
+class ExternalReferenceRegistry;
 class IsolateData;
 class WidgetManager;
 
@@ -100,6 +101,7 @@ class Widget : public BaseObject {
   static void LabelSetter(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   static v8::Local<v8::FunctionTemplate> GetConstructorTemplate(IsolateData* isolate_data);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   virtual void Render() = 0;
   virtual void Update() {
@@ -115,6 +117,9 @@ class Widget : public BaseObject {
   void RemoveChild(Widget* child);
   void ClearChildren();
 
+  // The package that created this widget, see PackageWatchdog.
+  uint32_t package() const { return package_; }
+
   bool visible() const { return visible_; }
   void set_visible(bool v) { visible_ = v; }
   const std::string& label() const { return label_; }
@@ -134,6 +139,7 @@ class Widget : public BaseObject {
   bool visible_ = true;
   std::unordered_map<std::string, std::vector<v8::Global<v8::Function>>> event_handlers_;
   std::string label_;
+  uint32_t package_;
 };
 
 class ChildWidget : public Widget {
@@ -147,6 +153,7 @@ class ChildWidget : public Widget {
               ImGuiWindowFlags window_flags);
 
   static void Initialize(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
 
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
 
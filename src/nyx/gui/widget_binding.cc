@@ -1,8 +1,13 @@
 #include "nyx/env.h"
+#include "nyx/errors.h"
+#include "nyx/external_references.h"
+#include "nyx/frame_scheduler.h"
+#include "nyx/gc_scheduler.h"
 #include "nyx/gui/canvas.h"
 #include "nyx/gui/colors.h"
 #include "nyx/gui/combo.h"
 #include "nyx/gui/common.h"
+#include "nyx/gui/flame_graph.h"
 #include "nyx/gui/image.h"
 #include "nyx/gui/input.h"
 #include "nyx/gui/layout.h"
@@ -22,6 +27,7 @@
 #include "nyx/gui/widget.h"
 #include "nyx/gui/widget_manager.h"
 #include "nyx/nyx_binding.h"
+#include "nyx/nyx_imgui.h"
 #include "nyx/util.h"
 
 namespace nyx {
@@ -44,20 +50,7 @@ using v8::Value;
 
 // forward declerations
 void CreatePerIsolatePropertiesIO(IsolateData* isolate_data, Local<ObjectTemplate> target);
-
-static void DemoWindowNew(const FunctionCallbackInfo<Value>& args) {
-  Environment* env = Environment::GetCurrent(args.GetIsolate());
-  DemoWindowWidget* demo = new DemoWindowWidget(env->principal_realm(), args.This());
-  if (env->widget_manager()) {
-    env->widget_manager()->AddRoot(demo);
-  }
-}
-
-static void CreatePerIsolateProperties(IsolateData* isolate_data, Local<ObjectTemplate> target) {
-  Isolate* isolate = isolate_data->isolate();
-  HandleScope scope(isolate);
-
-  Canvas::Initialize(isolate_data);
+void RegisterExternalReferencesIO(ExternalReferenceRegistry* registry);
 
 #define INIT_WIDGET_CONSTRUCTORS(V)                                                                                    \
   V(ChildWidget)                                                                                                       \
@@ -89,6 +82,7 @@ static void CreatePerIsolateProperties(IsolateData* isolate_data, Local<ObjectTe
   V(PanelWidget)                                                                                                       \
   V(PlotLinesWidget)                                                                                                   \
   V(PlotHistogramWidget)                                                                                               \
+  V(FlameGraphWidget)                                                                                                  \
   V(PopupWidget)                                                                                                       \
   V(ModalWidget)                                                                                                       \
   V(SelectableWidget)                                                                                                  \
@@ -112,6 +106,134 @@ static void CreatePerIsolateProperties(IsolateData* isolate_data, Local<ObjectTe
   V(TreeNodeWidget)                                                                                                    \
   V(CollapsingHeaderWidget)
 
+static void DemoWindowNew(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args.GetIsolate());
+  DemoWindowWidget* demo = new DemoWindowWidget(env->principal_realm(), args.This());
+  if (env->widget_manager()) {
+    env->widget_manager()->AddRoot(demo);
+  }
+}
+
+static void GetFontSize(const FunctionCallbackInfo<Value>& args) {
+  args.GetReturnValue().Set(ImGui::GetFontSize());
+}
+
+// setFrameRate(rate: number, rendererPaced: boolean) -> void
+static void SetFrameRate(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Environment* env = Environment::GetCurrent(args);
+
+  if (!args[0]->IsNumber()) {
+    THROW_ERR_INVALID_ARG_TYPE(isolate, "rate must be a number");
+    return;
+  }
+  double rate = args[0].As<Number>()->Value();
+  if (!(rate >= 1.0 && rate <= 1000.0)) {
+    THROW_ERR_OUT_OF_RANGE(isolate, "rate must be between 1 and 1000");
+    return;
+  }
+  env->frame_scheduler().Configure(rate, args[1]->IsTrue());
+}
+
+// setIdleGc(enabled: boolean, heapGrowthThreshold: number) -> undefined
+static void SetIdleGc(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Environment* env = Environment::GetCurrent(args);
+
+  if (!args[1]->IsNumber()) {
+    THROW_ERR_INVALID_ARG_TYPE(isolate, "heapGrowthThreshold must be a number");
+    return;
+  }
+  double threshold = args[1].As<Number>()->Value();
+  if (!(threshold >= 0 && threshold <= 9007199254740991.0)) {
+    THROW_ERR_OUT_OF_RANGE(isolate, "heapGrowthThreshold must be a non-negative number of bytes");
+    return;
+  }
+  env->gc_scheduler().Configure(args[0]->IsTrue(), static_cast<size_t>(threshold));
+}
+
+static Local<Object> GcStatsObject(Local<Context> context, const GcScheduler& gc) {
+  Isolate* isolate = context->GetIsolate();
+  const GcScheduler::Stats& stats = gc.stats();
+  Local<Object> result = Object::New(isolate);
+  auto set = [&](const char* name, Local<Value> value) {
+    result->Set(context, OneByteString(isolate, name), value).Check();
+  };
+  set("enabled", Boolean::New(isolate, gc.enabled()));
+  set("heapGrowthThreshold", Number::New(isolate, static_cast<double>(gc.growth_threshold())));
+  set("collections", Number::New(isolate, static_cast<double>(stats.collections)));
+  set("frameCollections", Number::New(isolate, static_cast<double>(stats.frame_collections)));
+  set("idlePeriods", Number::New(isolate, static_cast<double>(stats.idle_periods)));
+  set("idleTime", Number::New(isolate, static_cast<double>(stats.idle_ns) / 1e3));
+  set("pressureNotifications", Number::New(isolate, static_cast<double>(stats.pressure_notifications)));
+  set("pause", LatencySummaryObject(context, stats.pause, 1e-3));
+  set("framePause", LatencySummaryObject(context, stats.frame_pause, 1e-3));
+  return result;
+}
+
+static Local<Object> DrawDataStatsObject(Local<Context> context, const ImGuiDrawDataStore::Stats& stats) {
+  Isolate* isolate = context->GetIsolate();
+  Local<Object> result = Object::New(isolate);
+  auto set = [&](const char* name, double value) {
+    result->Set(context, OneByteString(isolate, name), Number::New(isolate, value)).Check();
+  };
+  double submitted = static_cast<double>(stats.submitted.load());
+  double unchanged = static_cast<double>(stats.unchanged.load());
+  set("submitted", submitted);
+  set("unchanged", unchanged);
+  set("skipRatio", submitted > 0 ? unchanged / submitted : 0);
+  set("acquired", static_cast<double>(stats.acquired.load()));
+  set("reacquired", static_cast<double>(stats.reacquired.load()));
+  return result;
+}
+
+// getFrameStats(reset?: boolean) -> object
+// Times in microseconds.
+static void GetFrameStats(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Local<Context> context = isolate->GetCurrentContext();
+  Environment* env = Environment::GetCurrent(args);
+  FrameScheduler& scheduler = env->frame_scheduler();
+  const FrameScheduler::Stats& stats = scheduler.stats();
+
+  Local<Object> result = Object::New(isolate);
+  auto set = [&](const char* name, Local<Value> value) {
+    result->Set(context, OneByteString(isolate, name), value).Check();
+  };
+  set("rate", Number::New(isolate, scheduler.rate()));
+  set("rendererPaced", Boolean::New(isolate, scheduler.renderer_paced()));
+  set("frames", Number::New(isolate, static_cast<double>(stats.frames)));
+  set("idleIterations", Number::New(isolate, static_cast<double>(stats.idle_iterations)));
+  set("rendererFrames", Number::New(isolate, static_cast<double>(stats.renderer_frames)));
+  set("inputFrames", Number::New(isolate, static_cast<double>(stats.input_frames)));
+  if (NyxImGui* nyx_imgui = env->nyx_imgui()) {
+    set("inputCoalesced", Number::New(isolate, static_cast<double>(nyx_imgui->input_ring().coalesced())));
+    set("inputDropped", Number::New(isolate, static_cast<double>(nyx_imgui->input_ring().dropped())));
+    set("foreground", DrawDataStatsObject(context, nyx_imgui->foreground()->stats()));
+    set("background", DrawDataStatsObject(context, nyx_imgui->background()->stats()));
+  }
+  set("build", LatencySummaryObject(context, stats.build, 1e-3));
+  set("interval", LatencySummaryObject(context, stats.interval, 1e-3));
+  set("gc", GcStatsObject(context, env->gc_scheduler()));
+
+  if (args[0]->IsTrue()) {
+    scheduler.ResetStats();
+    env->gc_scheduler().ResetStats();
+    if (NyxImGui* nyx_imgui = env->nyx_imgui()) {
+      nyx_imgui->foreground()->ResetStats();
+      nyx_imgui->background()->ResetStats();
+    }
+  }
+
+  args.GetReturnValue().Set(result);
+}
+
+static void CreatePerIsolateProperties(IsolateData* isolate_data, Local<ObjectTemplate> target) {
+  Isolate* isolate = isolate_data->isolate();
+  HandleScope scope(isolate);
+
+  Canvas::Initialize(isolate_data);
+
 #define V(name) name::Initialize(isolate_data, target);
   INIT_WIDGET_CONSTRUCTORS(V)
 #undef V
@@ -127,16 +249,33 @@ static void CreatePerIsolateProperties(IsolateData* isolate_data, Local<ObjectTe
 
   CreatePerIsolatePropertiesIO(isolate_data, target);
 
-  SetProperty(isolate, target, "fontSize", [](const FunctionCallbackInfo<Value>& args) {
-    args.GetReturnValue().Set(ImGui::GetFontSize());
-  });
+  SetProperty(isolate, target, "fontSize", GetFontSize);
+
+  SetMethod(isolate, target, "setFrameRate", SetFrameRate);
+  SetMethod(isolate, target, "getFrameStats", GetFrameStats);
+  SetMethod(isolate, target, "setIdleGc", SetIdleGc);
 }
 
 static void CreatePerContextProperties(Local<Object> target, Local<Context> context) {
   Canvas::CreatePerContextProperties(target, context);
 }
 
+static void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  Widget::RegisterExternalReferences(registry);
+  Canvas::RegisterExternalReferences(registry);
+#define V(name) name::RegisterExternalReferences(registry);
+  INIT_WIDGET_CONSTRUCTORS(V)
+#undef V
+
+  RegisterExternalReferencesIO(registry);
+  registry->Register(GetFontSize);
+  registry->Register(SetFrameRate);
+  registry->Register(GetFrameStats);
+  registry->Register(SetIdleGc);
+}
+
 NYX_BINDING_PER_ISOLATE_INIT(gui, CreatePerIsolateProperties)
 NYX_BINDING_CONTEXT_AWARE(gui, CreatePerContextProperties)
+NYX_BINDING_EXTERNAL_REFERENCE(gui, RegisterExternalReferences)
 
 }  // namespace nyx
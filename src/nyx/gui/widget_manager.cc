@@ -15,6 +15,17 @@ void WidgetManager::RemoveRoot(Widget* widget) {
   }
 }
 
+void WidgetManager::RemovePackage(uint32_t package) {
+  auto snapshot = roots_;
+  for (Widget* root : snapshot) {
+    if (root->package() == package) {
+      RemoveRoot(root);
+      root->ClearChildren();
+      root->MakeWeak();
+    }
+  }
+}
+
 void WidgetManager::UpdateAll() const {
   auto snapshot = roots_;
   for (Widget* root : snapshot) {
@@ -14,6 +14,8 @@ class WidgetManager {
 
   void AddRoot(Widget* widget);
   void RemoveRoot(Widget* widget);
+  // Destroys the root widgets created by the package, see PackageWatchdog.
+  void RemovePackage(uint32_t package);
   void UpdateAll() const;
   void RenderAll() const;
 
@@ -0,0 +1,187 @@
+#include "nyx/heap.h"
+
+#include <v8-profiler.h>
+
+#include <algorithm>
+#include <fstream>
+
+#include "nyx/env.h"
+#include "nyx/errors.h"
+#include "nyx/external_references.h"
+#include "nyx/nyx.h"
+#include "nyx/nyx_binding.h"
+
+namespace nyx {
+
+using v8::Array;
+using v8::Context;
+using v8::FunctionCallbackInfo;
+using v8::HeapSnapshot;
+using v8::HeapSpaceStatistics;
+using v8::HeapStatistics;
+using v8::Isolate;
+using v8::Local;
+using v8::Number;
+using v8::Object;
+using v8::ObjectTemplate;
+using v8::OutputStream;
+using v8::Value;
+
+namespace {
+
+constexpr double kMiB = 1024.0 * 1024.0;
+
+// Writes the snapshot as V8 produces it, so a multi-hundred-megabyte snapshot never sits in memory whole.
+class FileOutputStream : public OutputStream {
+ public:
+  explicit FileOutputStream(std::ofstream* file) : file_(file) {}
+
+  void EndOfStream() override { file_->flush(); }
+  int GetChunkSize() override { return 64 * 1024; }
+  WriteResult WriteAsciiChunk(char* data, int size) override {
+    file_->write(data, size);
+    return file_->good() ? kContinue : kAbort;
+  }
+
+ private:
+  std::ofstream* file_;
+};
+
+}  // namespace
+
+NearHeapLimitHandler::NearHeapLimitHandler(Isolate* isolate, std::function<void()> on_limit)
+    : isolate_(isolate), on_limit_(std::move(on_limit)) {
+  isolate_->AddNearHeapLimitCallback(OnNearHeapLimit, this);
+}
+
+NearHeapLimitHandler::~NearHeapLimitHandler() {
+  isolate_->RemoveNearHeapLimitCallback(OnNearHeapLimit, 0);
+}
+
+size_t NearHeapLimitHandler::OnNearHeapLimit(void* data, size_t current_heap_limit, size_t initial_heap_limit) {
+  NearHeapLimitHandler* handler = static_cast<NearHeapLimitHandler*>(data);
+  if (current_heap_limit >= initial_heap_limit * 2) {
+    return current_heap_limit;
+  }
+
+  if (!handler->triggered_) {
+    handler->triggered_ = true;
+    HeapStatistics stats;
+    handler->isolate_->GetHeapStatistics(&stats);
+    fprintf(GetStderr(),
+            "Heap is near its limit (%.1f of %.1f MiB used, %.1f MiB external); stopping scripts to restart\n",
+            static_cast<double>(stats.used_heap_size()) / kMiB,
+            static_cast<double>(current_heap_limit) / kMiB,
+            static_cast<double>(stats.external_memory()) / kMiB);
+    handler->on_limit_();
+  }
+  handler->isolate_->TerminateExecution();
+  return std::min(current_heap_limit + initial_heap_limit / 4, initial_heap_limit * 2);
+}
+
+// getHeapStatistics() -> object
+// Sizes in bytes.
+static void GetHeapStatistics(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Local<Context> context = isolate->GetCurrentContext();
+  HeapStatistics stats;
+  isolate->GetHeapStatistics(&stats);
+
+  Local<Object> result = Object::New(isolate);
+  auto set = [&](const char* name, size_t value) {
+    result->Set(context, OneByteString(isolate, name), Number::New(isolate, static_cast<double>(value))).Check();
+  };
+  set("totalHeapSize", stats.total_heap_size());
+  set("totalHeapSizeExecutable", stats.total_heap_size_executable());
+  set("totalPhysicalSize", stats.total_physical_size());
+  set("totalAvailableSize", stats.total_available_size());
+  set("usedHeapSize", stats.used_heap_size());
+  set("heapSizeLimit", stats.heap_size_limit());
+  set("mallocedMemory", stats.malloced_memory());
+  set("peakMallocedMemory", stats.peak_malloced_memory());
+  set("externalMemory", stats.external_memory());
+  set("totalGlobalHandlesSize", stats.total_global_handles_size());
+  set("usedGlobalHandlesSize", stats.used_global_handles_size());
+  set("numberOfNativeContexts", stats.number_of_native_contexts());
+  set("numberOfDetachedContexts", stats.number_of_detached_contexts());
+  args.GetReturnValue().Set(result);
+}
+
+// getHeapSpaceStatistics() -> object[]
+// Sizes in bytes.
+static void GetHeapSpaceStatistics(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Local<Context> context = isolate->GetCurrentContext();
+
+  size_t count = isolate->NumberOfHeapSpaces();
+  Local<Array> spaces = Array::New(isolate, static_cast<int>(count));
+  for (size_t i = 0; i < count; i++) {
+    HeapSpaceStatistics stats;
+    if (!isolate->GetHeapSpaceStatistics(&stats, i)) {
+      continue;
+    }
+    Local<Object> entry = Object::New(isolate);
+    auto set = [&](const char* name, size_t value) {
+      entry->Set(context, OneByteString(isolate, name), Number::New(isolate, static_cast<double>(value))).Check();
+    };
+    entry->Set(context, OneByteString(isolate, "spaceName"), OneByteString(isolate, stats.space_name())).Check();
+    set("spaceSize", stats.space_size());
+    set("spaceUsedSize", stats.space_used_size());
+    set("spaceAvailableSize", stats.space_available_size());
+    set("physicalSpaceSize", stats.physical_space_size());
+    spaces->Set(context, static_cast<uint32_t>(i), entry).Check();
+  }
+  args.GetReturnValue().Set(spaces);
+}
+
+// writeHeapSnapshot(path: string) -> void
+// Blocks the isolate while the snapshot is taken and written.
+static void WriteHeapSnapshot(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  if (!args[0]->IsString()) {
+    THROW_ERR_INVALID_ARG_TYPE(isolate, "path must be a string");
+    return;
+  }
+  Utf8Value path(isolate, args[0]);
+
+  std::ofstream file(*path, std::ios::binary);
+  if (!file.good()) {
+    THROW_ERR_OPERATION_FAILED(isolate, "Failed to open file for writing");
+    return;
+  }
+
+  const HeapSnapshot* snapshot = isolate->GetHeapProfiler()->TakeHeapSnapshot();
+  if (snapshot == nullptr) {
+    THROW_ERR_OPERATION_FAILED(isolate, "Failed to take heap snapshot");
+    return;
+  }
+  FileOutputStream stream(&file);
+  snapshot->Serialize(&stream, HeapSnapshot::kJSON);
+  const_cast<HeapSnapshot*>(snapshot)->Delete();
+
+  if (!file.good()) {
+    THROW_ERR_OPERATION_FAILED(isolate, "Failed to write to file");
+  }
+}
+
+static void CreatePerIsolateProperties(IsolateData* isolate_data, Local<ObjectTemplate> target) {
+  Isolate* isolate = isolate_data->isolate();
+
+  SetMethod(isolate, target, "getHeapStatistics", GetHeapStatistics);
+  SetMethod(isolate, target, "getHeapSpaceStatistics", GetHeapSpaceStatistics);
+  SetMethod(isolate, target, "writeHeapSnapshot", WriteHeapSnapshot);
+}
+
+static void CreatePerContextProperties(Local<Object> target, Local<Context> context) {}
+
+static void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(GetHeapStatistics);
+  registry->Register(GetHeapSpaceStatistics);
+  registry->Register(WriteHeapSnapshot);
+}
+
+NYX_BINDING_PER_ISOLATE_INIT(heap, CreatePerIsolateProperties)
+NYX_BINDING_CONTEXT_AWARE(heap, CreatePerContextProperties)
+NYX_BINDING_EXTERNAL_REFERENCE(heap, RegisterExternalReferences)
+
+}  // namespace nyx
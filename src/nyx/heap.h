@@ -0,0 +1,31 @@
+#pragma once
+
+#include <v8.h>
+
+#include <functional>
+
+namespace nyx {
+
+// Keeps an isolate that runs out of heap from taking the host process down with it.
+//
+// Near the heap limit V8 calls back before it would abort. The handler logs the heap, calls on_limit once so the
+// owner tears the isolate down, terminates the running script and raises the limit far enough for V8 to get
+// there. Past twice the initial limit it stops raising and V8 aborts as it would have without the handler.
+class NearHeapLimitHandler {
+ public:
+  NearHeapLimitHandler(v8::Isolate* isolate, std::function<void()> on_limit);
+  // Before the isolate is disposed.
+  ~NearHeapLimitHandler();
+
+  NearHeapLimitHandler(const NearHeapLimitHandler&) = delete;
+  NearHeapLimitHandler& operator=(const NearHeapLimitHandler&) = delete;
+
+ private:
+  static size_t OnNearHeapLimit(void* data, size_t current_heap_limit, size_t initial_heap_limit);
+
+  v8::Isolate* isolate_;
+  std::function<void()> on_limit_;
+  bool triggered_ = false;
+};
+
+}  // namespace nyx
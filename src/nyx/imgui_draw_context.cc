@@ -1,10 +1,12 @@
 #include "nyx/imgui_draw_context.h"
 
+#include "nyx/frame_timeline.h"
 #include "nyx/nyx_imgui.h"
 
 namespace nyx {
 
-ImGuiDrawContext::ImGuiDrawContext(NyxImGui* nyx_imgui) : nyx_imgui_(nyx_imgui) {
+ImGuiDrawContext::ImGuiDrawContext(NyxImGui* nyx_imgui)
+    : nyx_imgui_(nyx_imgui), input_events_(ImGuiInputEventRing::kCapacity) {
   ctx_ = ImGui::CreateContext(nyx_imgui_->font_atlas());
 
   ImGui::SetCurrentContext(ctx_);
@@ -31,9 +33,9 @@ void ImGuiDrawContext::BeginFrame() {
 
   GImGui = ctx_;
 
-  auto events = nyx_imgui_->DrainInputEvents();
+  size_t count = nyx_imgui_->DrainInputEvents(input_events_.data(), input_events_.size());
   ImGuiIO& io = ImGui::GetIO();
-  ImGuiInputEvent::ReplayTo(io, events.data(), static_cast<int>(events.size()));
+  ImGuiInputEvent::ReplayTo(io, input_events_.data(), static_cast<int>(count));
 
   auto now = std::chrono::steady_clock::now();
   float dt = std::chrono::duration<float>(now - last_frame_time_).count();
@@ -47,32 +49,36 @@ void ImGuiDrawContext::BeginFrame() {
   frame_active_ = true;
 }
 
-void ImGuiDrawContext::EndFrame() {
+void ImGuiDrawContext::EndFrame(FrameTimeline* timeline) {
   if (!frame_active_) {
     return;
   }
 
-  ImGui::Render();
+  {
+    FrameTimeline::Scope scope(timeline, FrameTimeline::Phase::kEndFrame);
+    ImGui::Render();
+  }
 
+  FrameTimeline::Scope scope(timeline, FrameTimeline::Phase::kSubmit);
   ImDrawData* draw_data = ImGui::GetDrawData();
   if (draw_data && draw_data->Valid && draw_data->CmdListsCount > 0) {
     ImDrawList* bg_list = ImGui::GetBackgroundDrawList();
 
     // Split draw lists: background vs foreground
-    ImVector<ImDrawList*> fg_lists;
+    fg_lists_.resize(0);
     ImDrawList* bg_found = nullptr;
 
     for (int i = 0; i < draw_data->CmdListsCount; ++i) {
       if (draw_data->CmdLists[i] == bg_list) {
         bg_found = draw_data->CmdLists[i];
       } else {
-        fg_lists.push_back(draw_data->CmdLists[i]);
+        fg_lists_.push_back(draw_data->CmdLists[i]);
       }
     }
 
-    if (fg_lists.Size > 0) {
+    if (fg_lists_.Size > 0) {
       nyx_imgui_->foreground()->Submit(
-          fg_lists.Data, fg_lists.Size, draw_data->DisplayPos, draw_data->DisplaySize, draw_data->FramebufferScale);
+          fg_lists_.Data, fg_lists_.Size, draw_data->DisplayPos, draw_data->DisplaySize, draw_data->FramebufferScale);
     } else {
       nyx_imgui_->foreground()->Clear();
     }
@@ -1,10 +1,14 @@
 #pragma once
 
+#include "nyx/imgui_input_event.h"
+
 #include <imgui.h>
 #include <chrono>
+#include <vector>
 
 namespace nyx {
 
+class FrameTimeline;
 class NyxImGui;
 
 class ImGuiDrawContext {
@@ -16,7 +20,8 @@ class ImGuiDrawContext {
   ImGuiDrawContext& operator=(const ImGuiDrawContext&) = delete;
 
   void BeginFrame();
-  void EndFrame();
+  // Times ImGui::Render and the hand-off to the renderer separately when given a timeline.
+  void EndFrame(FrameTimeline* timeline = nullptr);
 
   ImGuiContext* context() const { return ctx_; }
   bool frame_active() const { return frame_active_; }
@@ -26,6 +31,8 @@ class ImGuiDrawContext {
   NyxImGui* nyx_imgui_;  // shared, not owned
   bool frame_active_ = false;
   std::chrono::steady_clock::time_point last_frame_time_;
+  std::vector<ImGuiInputEvent> input_events_;  // drain buffer, sized once
+  ImVector<ImDrawList*> fg_lists_;             // reused every frame
 };
 
 }  // namespace nyx
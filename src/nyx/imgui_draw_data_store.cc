@@ -1,10 +1,116 @@
 #include "nyx/imgui_draw_data_store.h"
 
+#include <nmmintrin.h>
+
+#include <cstring>
+
 namespace nyx {
 
+namespace {
+
+// CRC32C over four interleaved lanes, which hides the instruction's latency. Meant to tell one frame from
+// the next, not to resist anyone.
+class ContentHash {
+ public:
+  void Update(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+      uint64_t chunk[4];
+      std::memcpy(chunk, bytes + i, sizeof(chunk));
+      lanes_[0] = _mm_crc32_u64(lanes_[0], chunk[0]);
+      lanes_[1] = _mm_crc32_u64(lanes_[1], chunk[1]);
+      lanes_[2] = _mm_crc32_u64(lanes_[2], chunk[2]);
+      lanes_[3] = _mm_crc32_u64(lanes_[3], chunk[3]);
+    }
+    for (; i + 8 <= size; i += 8) {
+      uint64_t chunk;
+      std::memcpy(&chunk, bytes + i, sizeof(chunk));
+      lanes_[0] = _mm_crc32_u64(lanes_[0], chunk);
+    }
+    for (; i < size; i++) {
+      lanes_[0] = _mm_crc32_u8(static_cast<uint32_t>(lanes_[0]), bytes[i]);
+    }
+    // Sizes go in too, so moving bytes from one buffer to the next changes the hash.
+    lanes_[1] = _mm_crc32_u64(lanes_[1], size);
+  }
+
+  template <typename T>
+  void Update(const ImVector<T>& vector) {
+    Update(vector.Data, static_cast<size_t>(vector.Size) * sizeof(T));
+  }
+
+  uint64_t Finish() const {
+    return (_mm_crc32_u64(lanes_[0], lanes_[2]) << 32) | _mm_crc32_u64(lanes_[1], lanes_[3]);
+  }
+
+ private:
+  uint64_t lanes_[4] = {0x9E3779B9, 0x85EBCA6B, 0xC2B2AE35, 0x27D4EB2F};
+};
+
+// Hashes what a command draws. The struct itself has padding and UserCallbackData, which can differ between
+// identical frames.
+void HashCommands(ContentHash& hash, const ImVector<ImDrawCmd>& commands) {
+  static_assert(sizeof(ImTextureID) <= sizeof(uint64_t), "texture ids must fit a word");
+  for (const ImDrawCmd& cmd : commands) {
+    struct {
+      float clip_rect[4];
+      uint64_t texture_id;
+      uint32_t vtx_offset;
+      uint32_t idx_offset;
+      uint32_t elem_count;
+      uint32_t unused;
+    } record = {{cmd.ClipRect.x, cmd.ClipRect.y, cmd.ClipRect.z, cmd.ClipRect.w},
+                0,
+                cmd.VtxOffset,
+                cmd.IdxOffset,
+                cmd.ElemCount,
+                0};
+    std::memcpy(&record.texture_id, &cmd.TextureId, sizeof(cmd.TextureId));
+    hash.Update(&record, sizeof(record));
+  }
+}
+
+uint64_t HashDrawLists(ImDrawList* const* lists,
+                       int count,
+                       const ImVec2& display_pos,
+                       const ImVec2& display_size,
+                       const ImVec2& framebuffer_scale) {
+  ContentHash hash;
+  const float header[] = {display_pos.x,
+                          display_pos.y,
+                          display_size.x,
+                          display_size.y,
+                          framebuffer_scale.x,
+                          framebuffer_scale.y,
+                          static_cast<float>(lists ? count : 0)};
+  hash.Update(header, sizeof(header));
+  for (int i = 0; lists && i < count; ++i) {
+    HashCommands(hash, lists[i]->CmdBuffer);
+    hash.Update(lists[i]->IdxBuffer);
+    hash.Update(lists[i]->VtxBuffer);
+  }
+  return hash.Finish();
+}
+
+// Copies size elements into dest, growing its storage only if it is too small.
+template <typename T>
+void CopyInto(ImVector<T>& dest, const ImVector<T>& src) {
+  dest.resize(src.Size);
+  if (src.Size > 0) {
+    std::memcpy(dest.Data, src.Data, static_cast<size_t>(src.Size) * sizeof(T));
+  }
+}
+
+}  // namespace
+
+ImGuiDrawDataStore::ImGuiDrawDataStore() = default;
+
 ImGuiDrawDataStore::~ImGuiDrawDataStore() {
-  draw_data_.CmdLists.clear_delete();
-  draw_data_.Clear();
+  for (Buffer& buffer : buffers_) {
+    buffer.lists.clear_delete();
+    buffer.draw_data.Clear();
+  }
 }
 
 void ImGuiDrawDataStore::Submit(ImDrawList* const* lists,
@@ -12,53 +118,91 @@ void ImGuiDrawDataStore::Submit(ImDrawList* const* lists,
                                 const ImVec2& display_pos,
                                 const ImVec2& display_size,
                                 const ImVec2& framebuffer_scale) {
-  std::scoped_lock lock(mutex_);
-
-  draw_data_.CmdLists.clear_delete();
-  draw_data_.Clear();
+  stats_.submitted.fetch_add(1, std::memory_order_relaxed);
 
-  if (!lists || count == 0) {
-    has_data_ = false;
+  uint64_t hash = HashDrawLists(lists, count, display_pos, display_size, framebuffer_scale);
+  if (published_ && hash == published_hash_ && !cleared_.load(std::memory_order_acquire)) {
+    // The consumer already has this frame, or will get it from the middle buffer.
+    stats_.unchanged.fetch_add(1, std::memory_order_relaxed);
     return;
   }
 
-  int total_vtx = 0;
-  int total_idx = 0;
-  draw_data_.CmdLists.resize(count);
-  for (int i = 0; i < count; ++i) {
-    draw_data_.CmdLists[i] = lists[i]->CloneOutput();
-    total_vtx += lists[i]->VtxBuffer.Size;
-    total_idx += lists[i]->IdxBuffer.Size;
+  Buffer& buffer = buffers_[write_];
+  ImDrawData& draw_data = buffer.draw_data;
+  draw_data.Clear();
+
+  if (!lists || count == 0) {
+    buffer.has_data = false;
+  } else {
+    while (buffer.lists.Size < count) {
+      buffer.lists.push_back(IM_NEW(ImDrawList)(lists[0]->_Data));
+    }
+
+    int total_vtx = 0;
+    int total_idx = 0;
+    draw_data.CmdLists.resize(count);
+    for (int i = 0; i < count; ++i) {
+      ImDrawList* dst = buffer.lists[i];
+      CopyInto(dst->CmdBuffer, lists[i]->CmdBuffer);
+      CopyInto(dst->IdxBuffer, lists[i]->IdxBuffer);
+      CopyInto(dst->VtxBuffer, lists[i]->VtxBuffer);
+      dst->Flags = lists[i]->Flags;
+      draw_data.CmdLists[i] = dst;
+      total_vtx += lists[i]->VtxBuffer.Size;
+      total_idx += lists[i]->IdxBuffer.Size;
+    }
+
+    draw_data.TotalVtxCount = total_vtx;
+    draw_data.TotalIdxCount = total_idx;
+    draw_data.CmdListsCount = count;
+    draw_data.DisplayPos = display_pos;
+    draw_data.DisplaySize = display_size;
+    draw_data.FramebufferScale = framebuffer_scale;
+    draw_data.Valid = true;
+    buffer.has_data = true;
   }
 
-  draw_data_.TotalVtxCount = total_vtx;
-  draw_data_.TotalIdxCount = total_idx;
-  draw_data_.CmdListsCount = count;
-  draw_data_.DisplayPos = display_pos;
-  draw_data_.DisplaySize = display_size;
-  draw_data_.FramebufferScale = framebuffer_scale;
-  draw_data_.Valid = true;
-  has_data_ = true;
+  buffer.frame_id = next_frame_id_++;
+  published_hash_ = hash;
+  published_ = true;
+
+  write_ = middle_.exchange(write_ | kFresh, std::memory_order_acq_rel) & kIndexMask;
+  cleared_.store(false, std::memory_order_release);
 }
 
 void ImGuiDrawDataStore::Clear() {
-  std::scoped_lock lock(mutex_);
-  draw_data_.CmdLists.clear_delete();
-  draw_data_.Clear();
-  has_data_ = false;
+  cleared_.store(true, std::memory_order_release);
 }
 
-ImDrawData* ImGuiDrawDataStore::Acquire() {
-  mutex_.lock();
-  if (!has_data_) {
-    mutex_.unlock();
+ImDrawData* ImGuiDrawDataStore::Acquire(uint64_t* frame_id) {
+  if (middle_.load(std::memory_order_relaxed) & kFresh) {
+    read_ = middle_.exchange(read_, std::memory_order_acq_rel) & kIndexMask;
+  }
+  Buffer& buffer = buffers_[read_];
+  if (cleared_.load(std::memory_order_acquire) || !buffer.has_data) {
     return nullptr;
   }
-  return &draw_data_;
+
+  stats_.acquired.fetch_add(1, std::memory_order_relaxed);
+  if (buffer.frame_id == acquired_frame_id_) {
+    stats_.reacquired.fetch_add(1, std::memory_order_relaxed);
+  }
+  acquired_frame_id_ = buffer.frame_id;
+  if (frame_id) {
+    *frame_id = buffer.frame_id;
+  }
+  return &buffer.draw_data;
 }
 
 void ImGuiDrawDataStore::Release() {
-  mutex_.unlock();
+  // Nothing to do: the acquired buffer belongs to the consumer until its next Acquire().
+}
+
+void ImGuiDrawDataStore::ResetStats() {
+  stats_.submitted = 0;
+  stats_.unchanged = 0;
+  stats_.acquired = 0;
+  stats_.reacquired = 0;
 }
 
 }  // namespace nyx
@@ -1,28 +1,76 @@
 #pragma once
 
 #include <imgui.h>
-#include <mutex>
+#include <atomic>
+#include <cstdint>
 
 namespace nyx {
 
+// Hands draw data from the nyx thread (producer) to the render thread (consumer) without either waiting
+// on the other. Three buffers rotate: the producer fills its own, then swaps it with the shared middle
+// one; the consumer swaps the middle one for its own when a newer frame is there. Each buffer keeps its
+// ImDrawLists and their vertex/index/command storage across frames and only ever grows it, so a frame no
+// larger than the ones before it allocates nothing.
+//
+// Submitted content is hashed first. A frame identical to the last published one is not copied or
+// published at all, so the consumer keeps seeing the previous frame id and can reuse what it uploaded.
 class ImGuiDrawDataStore {
  public:
+  struct Stats {
+    std::atomic<uint64_t> submitted{0};
+    std::atomic<uint64_t> unchanged{0};  // submitted but identical to the previous frame
+    std::atomic<uint64_t> acquired{0};
+    std::atomic<uint64_t> reacquired{0};  // acquired with the same frame id as last time
+  };
+
+  ImGuiDrawDataStore();
   ~ImGuiDrawDataStore();
 
+  ImGuiDrawDataStore(const ImGuiDrawDataStore&) = delete;
+  ImGuiDrawDataStore& operator=(const ImGuiDrawDataStore&) = delete;
+
+  // Producer thread.
   void Submit(ImDrawList* const* lists,
               int count,
               const ImVec2& display_pos,
               const ImVec2& display_size,
               const ImVec2& framebuffer_scale);
+  // Any thread. Hides whatever was submitted until the next Submit().
   void Clear();
 
-  ImDrawData* Acquire();
+  // Consumer thread. Returns the newest frame, or nullptr if there is nothing to draw. The data stays
+  // valid and untouched by the producer until the next Acquire(). frame_id receives a non-zero id that
+  // only changes when the content does.
+  ImDrawData* Acquire(uint64_t* frame_id = nullptr);
   void Release();
 
+  const Stats& stats() const { return stats_; }
+  void ResetStats();
+
  private:
-  std::mutex mutex_;
-  ImDrawData draw_data_;
-  bool has_data_ = false;
+  struct Buffer {
+    ImDrawData draw_data;
+    ImVector<ImDrawList*> lists;  // owned, grow-only
+    uint64_t frame_id = 0;
+    bool has_data = false;
+  };
+
+  static constexpr uint32_t kIndexMask = 0x3;
+  static constexpr uint32_t kFresh = 0x4;  // middle holds a frame the consumer has not taken yet
+
+  Buffer buffers_[3];
+  uint32_t write_ = 0;                 // producer only
+  std::atomic<uint32_t> middle_{1};    // index | kFresh
+  uint32_t read_ = 2;                  // consumer only
+  std::atomic<bool> cleared_{false};
+
+  // Producer only.
+  uint64_t published_hash_ = 0;
+  uint64_t next_frame_id_ = 1;
+  bool published_ = false;
+
+  uint64_t acquired_frame_id_ = 0;  // consumer only
+  Stats stats_;
 };
 
 }  // namespace nyx
@@ -37,4 +37,61 @@ void ImGuiInputEvent::ReplayTo(ImGuiIO& io, const ImGuiInputEvent* events, int c
   }
 }
 
+bool ImGuiInputEventRing::Coalescable(ImGuiInputEvent::Type type) {
+  return type == ImGuiInputEvent::kMousePos || type == ImGuiInputEvent::kMouseWheel ||
+         type == ImGuiInputEvent::kDisplaySize;
+}
+
+bool ImGuiInputEventRing::Push(const ImGuiInputEvent& event) {
+  size_t write = write_.load(std::memory_order_relaxed);
+
+  if (Coalescable(event.type) && write != read_.load(std::memory_order_acquire)) {
+    Slot& last = slots_[(write - 1) % kCapacity];
+    uint32_t expected = kReady;
+    if (last.event.type == event.type &&
+        last.state.compare_exchange_strong(expected, kMerging, std::memory_order_acquire)) {
+      if (event.type == ImGuiInputEvent::kMouseWheel) {
+        last.event.mouse_wheel.x += event.mouse_wheel.x;
+        last.event.mouse_wheel.y += event.mouse_wheel.y;
+      } else {
+        last.event = event;
+      }
+      last.state.store(kReady, std::memory_order_release);
+      coalesced_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+
+  if (write - read_.load(std::memory_order_acquire) >= kCapacity) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  Slot& slot = slots_[write % kCapacity];
+  slot.event = event;
+  slot.state.store(kReady, std::memory_order_release);
+  write_.store(write + 1, std::memory_order_release);
+  return true;
+}
+
+size_t ImGuiInputEventRing::Drain(ImGuiInputEvent* out, size_t capacity) {
+  size_t read = read_.load(std::memory_order_relaxed);
+  size_t write = write_.load(std::memory_order_acquire);
+
+  size_t count = 0;
+  for (; read != write && count < capacity; read++) {
+    Slot& slot = slots_[read % kCapacity];
+    uint32_t expected = kReady;
+    // The producer holds kMerging only for a copy; wait it out.
+    while (!slot.state.compare_exchange_weak(expected, kTaken, std::memory_order_acquire)) {
+      expected = kReady;
+    }
+    out[count++] = slot.event;
+    slot.state.store(kFree, std::memory_order_relaxed);
+  }
+
+  read_.store(read, std::memory_order_release);
+  return count;
+}
+
 }  // namespace nyx
@@ -2,6 +2,10 @@
 
 #include <imgui.h>
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
 namespace nyx {
 
 struct ImGuiInputEvent {
@@ -54,4 +58,44 @@ struct ImGuiInputEvent {
   static void ReplayTo(ImGuiIO& io, const ImGuiInputEvent* events, int count);
 };
 
+// Fixed-size single-producer/single-consumer queue between the window thread and the nyx thread.
+// Consecutive kMousePos and kDisplaySize events collapse into the latest one and consecutive kMouseWheel
+// events are summed, as long as the consumer has not taken the earlier event yet.
+class ImGuiInputEventRing {
+ public:
+  static constexpr size_t kCapacity = 1024;
+
+  ImGuiInputEventRing() = default;
+  ImGuiInputEventRing(const ImGuiInputEventRing&) = delete;
+  ImGuiInputEventRing& operator=(const ImGuiInputEventRing&) = delete;
+
+  // Producer thread. Returns false if the event was dropped because the ring is full.
+  bool Push(const ImGuiInputEvent& event);
+
+  // Consumer thread. Copies up to capacity events in order into out and returns how many.
+  size_t Drain(ImGuiInputEvent* out, size_t capacity);
+  bool empty() const { return read_.load(std::memory_order_acquire) == write_.load(std::memory_order_acquire); }
+
+  uint64_t coalesced() const { return coalesced_.load(std::memory_order_relaxed); }
+  uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+ private:
+  // A published slot is either claimed by the producer to merge into it or by the consumer to read it;
+  // whoever loses the race leaves it alone (the producer then appends a new event instead).
+  enum SlotState : uint32_t { kFree, kReady, kMerging, kTaken };
+
+  struct Slot {
+    std::atomic<uint32_t> state{kFree};
+    ImGuiInputEvent event;
+  };
+
+  static bool Coalescable(ImGuiInputEvent::Type type);
+
+  Slot slots_[kCapacity];
+  alignas(64) std::atomic<size_t> write_{0};
+  alignas(64) std::atomic<size_t> read_{0};
+  std::atomic<uint64_t> coalesced_{0};
+  std::atomic<uint64_t> dropped_{0};
+};
+
 }  // namespace nyx
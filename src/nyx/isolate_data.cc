@@ -11,15 +11,31 @@ using v8::Local;
 using v8::NewStringType;
 using v8::ObjectTemplate;
 using v8::Private;
+using v8::SnapshotCreator;
 using v8::String;
 using v8::Symbol;
 
-IsolateData::IsolateData(Isolate* isolate, uv_loop_t* event_loop) : isolate_(isolate), event_loop_(event_loop) {
-  CreateProperties();
+IsolateData::IsolateData(Isolate* isolate, uv_loop_t* event_loop, bool from_snapshot)
+    : isolate_(isolate), event_loop_(event_loop), from_snapshot_(from_snapshot) {
+  if (from_snapshot_) {
+    DeserializeProperties();
+  } else {
+    CreateProperties();
+  }
 }
 
-IsolateData::~IsolateData() {
-  CleanupExternalBindings();
+IsolateData::~IsolateData() {}
+
+Local<ObjectTemplate> IsolateData::external_binding_template(const std::string& name) const {
+  auto it = external_binding_templates_.find(name);
+  if (it == external_binding_templates_.end()) {
+    return Local<ObjectTemplate>();
+  }
+  return it->second.Get(isolate_);
+}
+
+void IsolateData::set_external_binding_template(const std::string& name, Local<ObjectTemplate> templ) {
+  external_binding_templates_[name].Reset(isolate_, templ);
 }
 
 #define VP(PropertyName, StringValue) V(v8::Private, PropertyName)
@@ -106,4 +122,49 @@ void IsolateData::CreateProperties() {
   CreateInternalBindingTemplates(this);
 }
 
+// Isolate snapshot data is indexed in the order it was added, so both functions walk the same lists.
+#define VP(PropertyName, StringValue) V(v8::Private, PropertyName)
+#define VY(PropertyName, StringValue) V(v8::Symbol, PropertyName)
+#define VS(PropertyName, StringValue) V(v8::String, PropertyName)
+#define VT(PropertyName, TypeName) V(TypeName, PropertyName)
+#define VR(PropertyName, TypeName) V(v8::Private, per_realm_##PropertyName)
+#define VM(PropertyName) V(v8::ObjectTemplate, PropertyName##_binding_template)
+#define ISOLATE_DATA_PROPERTIES(V)                                                                                     \
+  PER_ISOLATE_PRIVATE_SYMBOL_PROPERTIES(VP)                                                                            \
+  PER_ISOLATE_SYMBOL_PROPERTIES(VY)                                                                                    \
+  PER_ISOLATE_STRING_PROPERTIES(VS)                                                                                    \
+  PER_ISOLATE_TEMPLATE_PROPERTIES(VT)                                                                                  \
+  PER_REALM_STRONG_PERSISTENT_VALUES(VR)                                                                               \
+  NYX_BINDINGS_WITH_PER_ISOLATE_INIT(VM)
+
+void IsolateData::Serialize(SnapshotCreator* creator) {
+  HandleScope handle_scope(isolate_);
+
+#define V(TypeName, PropertyName) creator->AddData(PropertyName##_.Get(isolate_));
+  ISOLATE_DATA_PROPERTIES(V)
+#undef V
+}
+
+void IsolateData::DeserializeProperties() {
+  Isolate::Scope isolate_scope(isolate_);
+  HandleScope handle_scope(isolate_);
+
+  size_t index = 0;
+#define V(TypeName, PropertyName)                                                                                      \
+  PropertyName##_.Set(isolate_, isolate_->GetDataFromSnapshotOnce<TypeName>(index++).ToLocalChecked());
+  ISOLATE_DATA_PROPERTIES(V)
+#undef V
+
+  // Templates of bindings registered through extension.h are never part of the snapshot.
+  CreateExternalBindingTemplates(this);
+}
+
+#undef ISOLATE_DATA_PROPERTIES
+#undef VM
+#undef VR
+#undef VT
+#undef VS
+#undef VY
+#undef VP
+
 }  // namespace nyx
@@ -1,10 +1,14 @@
 #pragma once
 
 #include <uv.h>
+#include <v8-snapshot.h>
 
 #include "nyx/nyx_binding.h"
 #include "nyx/util.h"
 
+#include <string>
+#include <unordered_map>
+
 namespace nyx {
 
 #define PER_ISOLATE_PRIVATE_SYMBOL_PROPERTIES(V)                                                                       \
@@ -15,6 +19,8 @@ namespace nyx {
 
 #define PER_ISOLATE_STRING_PROPERTIES(V)                                                                               \
   V(attributes_string, "attributes")                                                                                   \
+  V(onexit_string, "onexit")                                                                                           \
+  V(onmessage_string, "onmessage")                                                                                     \
   V(original_string, "original")                                                                                       \
   V(required_module_facade_url_string, "nyx:internal/required_module_default_facade")                                  \
   V(required_module_facade_source_string,                                                                              \
@@ -45,15 +51,21 @@ namespace nyx {
   V(builtin_module_require, v8::Function)                                                                              \
   V(host_import_module_dynamically_callback, v8::Function)                                                             \
   V(host_initialize_import_meta_object_callback, v8::Function)                                                         \
-  V(internal_binding_loader, v8::Function)
+  V(internal_binding_loader, v8::Function)                                                                              \
+  V(add_builtin_ids, v8::Function)
 
 class IsolateData {
  public:
-  IsolateData(v8::Isolate* isolate, uv_loop_t* event_loop);
+  // from_snapshot: the isolate was created from SnapshotBuilder's blob, which already holds the properties.
+  IsolateData(v8::Isolate* isolate, uv_loop_t* event_loop, bool from_snapshot = false);
   ~IsolateData();
 
   v8::Isolate* isolate() const { return isolate_; }
   uv_loop_t* event_loop() const { return event_loop_; }
+  bool from_snapshot() const { return from_snapshot_; }
+
+  // Adds every property to the snapshot, in the order DeserializeProperties reads them back.
+  void Serialize(v8::SnapshotCreator* creator);
 
 #define VP(PropertyName, StringValue) V(v8::Private, PropertyName)
 #define VY(PropertyName, StringValue) V(v8::Symbol, PropertyName)
@@ -78,11 +90,18 @@ class IsolateData {
 #undef V
 #undef VM
 
+  // Templates of bindings registered through extension.h. Empty for unknown names.
+  v8::Local<v8::ObjectTemplate> external_binding_template(const std::string& name) const;
+  void set_external_binding_template(const std::string& name, v8::Local<v8::ObjectTemplate> templ);
+
  private:
   void CreateProperties();
+  void DeserializeProperties();
 
   v8::Isolate* isolate_;
   uv_loop_t* event_loop_;
+  bool from_snapshot_;
+  std::unordered_map<std::string, v8::Global<v8::ObjectTemplate>> external_binding_templates_;
 
 #define VP(PropertyName, StringValue) V(v8::Private, PropertyName)
 #define VY(PropertyName, StringValue) V(v8::Symbol, PropertyName)
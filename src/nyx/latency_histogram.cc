@@ -0,0 +1,79 @@
+#include "nyx/latency_histogram.h"
+
+#include <bit>
+#include <limits>
+
+namespace nyx {
+
+size_t LatencyHistogram::BucketIndex(uint64_t value) {
+  if (value < kSubBuckets) return static_cast<size_t>(value);
+  int shift = std::bit_width(value) - 1 - kSubBucketBits;
+  return static_cast<size_t>((shift + 1) * kSubBuckets + ((value >> shift) & (kSubBuckets - 1)));
+}
+
+uint64_t LatencyHistogram::BucketUpperBound(size_t index) {
+  if (index < kSubBuckets) return index;
+  int shift = static_cast<int>(index / kSubBuckets) - 1;
+  uint64_t mantissa = kSubBuckets + index % kSubBuckets;
+  uint64_t lower = mantissa << shift;
+  return lower + ((uint64_t{1} << shift) - 1);
+}
+
+void LatencyHistogram::Record(uint64_t value) {
+  buckets_[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(value, std::memory_order_relaxed);
+
+  uint64_t current = min_.load(std::memory_order_relaxed);
+  while (value < current && !min_.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+  }
+  current = max_.load(std::memory_order_relaxed);
+  while (value > current && !max_.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+  }
+}
+
+void LatencyHistogram::Reset() {
+  for (auto& bucket : buckets_) bucket.store(0, std::memory_order_relaxed);
+  count_.store(0, std::memory_order_relaxed);
+  sum_.store(0, std::memory_order_relaxed);
+  min_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::Percentile(double percentile) const {
+  uint64_t total = count();
+  if (total == 0) return 0;
+
+  // Rank of the requested sample, 1-based and clamped so p100 lands on the last recorded value.
+  uint64_t rank = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(total) + 0.5);
+  if (rank < 1) rank = 1;
+  if (rank > total) rank = total;
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBucketCount; i++) {
+    seen += buckets_[i].load(std::memory_order_relaxed);
+    if (seen >= rank) {
+      uint64_t bound = BucketUpperBound(i);
+      uint64_t max = max_.load(std::memory_order_relaxed);
+      return bound < max ? bound : max;
+    }
+  }
+  return max_.load(std::memory_order_relaxed);
+}
+
+LatencyHistogram::Summary LatencyHistogram::Summarize() const {
+  Summary summary{};
+  summary.count = count();
+  if (summary.count == 0) return summary;
+
+  summary.min = min_.load(std::memory_order_relaxed);
+  summary.max = max_.load(std::memory_order_relaxed);
+  summary.mean = static_cast<double>(sum_.load(std::memory_order_relaxed)) / static_cast<double>(summary.count);
+  summary.p50 = Percentile(50.0);
+  summary.p90 = Percentile(90.0);
+  summary.p99 = Percentile(99.0);
+  summary.p999 = Percentile(99.9);
+  return summary;
+}
+
+}  // namespace nyx
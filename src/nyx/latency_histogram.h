@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace nyx {
+
+// Log-linear histogram in the style of HdrHistogram: each power of two is split into kSubBuckets linear
+// buckets, so any recorded value is reported within 1/kSubBuckets (~6%) of its true value. Recording is
+// a handful of relaxed atomic adds and safe from any number of threads; readers see an approximate but
+// never torn view.
+class LatencyHistogram {
+ public:
+  static constexpr int kSubBucketBits = 4;
+  static constexpr uint64_t kSubBuckets = uint64_t{1} << kSubBucketBits;
+  static constexpr size_t kBucketCount = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+  struct Summary {
+    uint64_t count;
+    uint64_t min;
+    uint64_t max;
+    double mean;
+    uint64_t p50;
+    uint64_t p90;
+    uint64_t p99;
+    uint64_t p999;
+  };
+
+  LatencyHistogram() { Reset(); }
+  LatencyHistogram(const LatencyHistogram&) = delete;
+  LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+  void Record(uint64_t value);
+  // Not atomic with respect to concurrent Record() calls; values recorded meanwhile may be lost.
+  void Reset();
+
+  uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+  // Highest value equivalent to the bucket holding the given percentile (0..100), 0 if empty.
+  uint64_t Percentile(double percentile) const;
+  Summary Summarize() const;
+
+ private:
+  static size_t BucketIndex(uint64_t value);
+  static uint64_t BucketUpperBound(size_t index);
+
+  std::atomic<uint64_t> buckets_[kBucketCount];
+  std::atomic<uint64_t> count_;
+  std::atomic<uint64_t> sum_;
+  std::atomic<uint64_t> min_;
+  std::atomic<uint64_t> max_;
+};
+
+}  // namespace nyx
@@ -0,0 +1,271 @@
+#include "nyx/memory_scan.h"
+
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define NYX_SCAN_SSE2 1
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace nyx {
+
+size_t ScanSpec::width() const {
+  switch (type) {
+    case ScanValueType::kInt32:
+    case ScanValueType::kFloat:
+      return 4;
+    case ScanValueType::kPointer:
+      return 8;
+    case ScanValueType::kPattern:
+      return pattern.size();
+  }
+  return 0;
+}
+
+namespace {
+
+// Distance from base to the next address that is a multiple of alignment.
+size_t FirstAligned(uint64_t base, uint32_t alignment) {
+  uint64_t rem = base % alignment;
+  return rem == 0 ? 0 : alignment - rem;
+}
+
+inline bool Push(uint64_t address, size_t max_hits, std::vector<uint64_t>* hits) {
+  hits->push_back(address);
+  return hits->size() < max_hits;
+}
+
+inline int CountTrailingZeros(uint32_t value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index;
+  _BitScanForward(&index, value);
+  return static_cast<int>(index);
+#else
+  return __builtin_ctz(value);
+#endif
+}
+
+bool PatternMatchesAt(const uint8_t* data, const uint8_t* pattern, const uint8_t* mask, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    if (mask[i] != 0 && data[i] != pattern[i]) return false;
+  }
+  return true;
+}
+
+// Byte pattern with optional wildcards, any alignment. One fixed byte is used as an anchor and searched
+// 16 positions at a time; candidates are verified in full.
+bool ScanPattern(const uint8_t* pattern, const uint8_t* mask, size_t length, uint32_t alignment,
+                 const uint8_t* data, size_t size, uint64_t base, size_t max_hits, std::vector<uint64_t>* hits) {
+  if (length == 0 || size < length) return true;
+
+  size_t anchor = 0;
+  while (anchor < length && mask[anchor] == 0) anchor++;
+  size_t last = size - length;  // last valid start offset
+
+  auto candidate = [&](size_t pos) {
+    if ((base + pos) % alignment != 0) return true;
+    if (!PatternMatchesAt(data + pos, pattern, mask, length)) return true;
+    return Push(base + pos, max_hits, hits);
+  };
+
+  if (anchor == length) {
+    for (size_t pos = FirstAligned(base, alignment); pos <= last; pos += alignment) {
+      if (!Push(base + pos, max_hits, hits)) return false;
+    }
+    return true;
+  }
+
+  size_t pos = 0;
+#ifdef NYX_SCAN_SSE2
+  const __m128i needle = _mm_set1_epi8(static_cast<char>(pattern[anchor]));
+  for (; pos + 16 <= last + 1; pos += 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos + anchor));
+    uint32_t bits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)));
+    while (bits != 0) {
+      if (!candidate(pos + CountTrailingZeros(bits))) return false;
+      bits &= bits - 1;
+    }
+  }
+#endif
+  for (; pos <= last; pos++) {
+    if (data[pos + anchor] == pattern[anchor] && !candidate(pos)) return false;
+  }
+  return true;
+}
+
+bool ScanInt32(int32_t value, uint32_t alignment, const uint8_t* data, size_t size, uint64_t base, size_t max_hits,
+               std::vector<uint64_t>* hits) {
+  size_t pos = FirstAligned(base, alignment);
+#ifdef NYX_SCAN_SSE2
+  // Four consecutive 4-byte slots per compare; slots off the requested alignment are skipped.
+  const __m128i needle = _mm_set1_epi32(value);
+  for (; pos + 16 <= size; pos += (alignment > 16 ? alignment : 16)) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+    uint32_t bits = static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(chunk, needle))));
+    while (bits != 0) {
+      size_t at = pos + CountTrailingZeros(bits) * 4;
+      if ((base + at) % alignment == 0 && !Push(base + at, max_hits, hits)) return false;
+      bits &= bits - 1;
+    }
+  }
+#endif
+  for (pos += FirstAligned(base + pos, alignment); pos + 4 <= size; pos += alignment) {
+    int32_t current;
+    std::memcpy(&current, data + pos, 4);
+    if (current == value && !Push(base + pos, max_hits, hits)) return false;
+  }
+  return true;
+}
+
+bool ScanFloat(float value, float epsilon, uint32_t alignment, const uint8_t* data, size_t size, uint64_t base,
+               size_t max_hits, std::vector<uint64_t>* hits) {
+  size_t pos = FirstAligned(base, alignment);
+#ifdef NYX_SCAN_SSE2
+  if (alignment % 4 == 0) {
+    const __m128 target = _mm_set1_ps(value);
+    const __m128 tolerance = _mm_set1_ps(epsilon);
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    for (; pos + 16 <= size; pos += (alignment > 16 ? alignment : 16)) {
+      __m128 chunk = _mm_loadu_ps(reinterpret_cast<const float*>(data + pos));
+      __m128 diff = _mm_andnot_ps(sign, _mm_sub_ps(chunk, target));
+      uint32_t bits = static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(diff, tolerance)));
+      while (bits != 0) {
+        size_t at = pos + CountTrailingZeros(bits) * 4;
+        if ((base + at) % alignment == 0 && !Push(base + at, max_hits, hits)) return false;
+        bits &= bits - 1;
+      }
+    }
+  }
+#endif
+  for (pos += FirstAligned(base + pos, alignment); pos + 4 <= size; pos += alignment) {
+    float current;
+    std::memcpy(&current, data + pos, 4);
+    if (std::fabs(current - value) <= epsilon && !Push(base + pos, max_hits, hits)) return false;
+  }
+  return true;
+}
+
+bool ScanPointer(uint64_t value, uint32_t alignment, const uint8_t* data, size_t size, uint64_t base,
+                 size_t max_hits, std::vector<uint64_t>* hits) {
+  size_t pos = FirstAligned(base, alignment);
+#ifdef NYX_SCAN_SSE2
+  // SSE2 has no 64-bit compare: a slot matches when both of its 32-bit halves do.
+  const __m128i needle = _mm_set1_epi64x(static_cast<long long>(value));
+  for (; pos + 16 <= size; pos += (alignment > 16 ? alignment : 16)) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+    uint32_t halves = static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(chunk, needle))));
+    if ((halves & 0x3) == 0x3 && (base + pos) % alignment == 0 && !Push(base + pos, max_hits, hits)) return false;
+    if ((halves & 0xC) == 0xC && (base + pos + 8) % alignment == 0 && !Push(base + pos + 8, max_hits, hits)) {
+      return false;
+    }
+  }
+#endif
+  for (pos += FirstAligned(base + pos, alignment); pos + 8 <= size; pos += alignment) {
+    uint64_t current;
+    std::memcpy(&current, data + pos, 8);
+    if (current == value && !Push(base + pos, max_hits, hits)) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+bool ScanBuffer(const ScanSpec& spec, const uint8_t* data, size_t size, uint64_t base, size_t max_hits,
+                std::vector<uint64_t>* hits) {
+  uint32_t alignment = spec.alignment == 0 ? 1 : spec.alignment;
+  if (hits->size() >= max_hits) return false;
+
+  // Value scans below their natural alignment fall back to the byte-anchored pattern search.
+  uint8_t bytes[8];
+  static constexpr uint8_t kAllFixed[8] = {1, 1, 1, 1, 1, 1, 1, 1};
+  switch (spec.type) {
+    case ScanValueType::kInt32:
+      if (alignment % 4 == 0) return ScanInt32(spec.int_value, alignment, data, size, base, max_hits, hits);
+      std::memcpy(bytes, &spec.int_value, 4);
+      return ScanPattern(bytes, kAllFixed, 4, alignment, data, size, base, max_hits, hits);
+    case ScanValueType::kFloat:
+      return ScanFloat(spec.float_value, spec.epsilon, alignment, data, size, base, max_hits, hits);
+    case ScanValueType::kPointer:
+      if (alignment % 8 == 0) return ScanPointer(spec.pointer_value, alignment, data, size, base, max_hits, hits);
+      std::memcpy(bytes, &spec.pointer_value, 8);
+      return ScanPattern(bytes, kAllFixed, 8, alignment, data, size, base, max_hits, hits);
+    case ScanValueType::kPattern:
+      return ScanPattern(spec.pattern.data(), spec.mask.data(), spec.pattern.size(), alignment, data, size, base,
+                         max_hits, hits);
+  }
+  return true;
+}
+
+bool MatchesNext(const ScanSpec& spec, const uint8_t* current, const uint8_t* previous) {
+  size_t width = spec.width();
+
+  if (spec.compare == ScanCompare::kEqual) {
+    switch (spec.type) {
+      case ScanValueType::kInt32:
+        return std::memcmp(current, &spec.int_value, 4) == 0;
+      case ScanValueType::kFloat: {
+        float value;
+        std::memcpy(&value, current, 4);
+        return std::fabs(value - spec.float_value) <= spec.epsilon;
+      }
+      case ScanValueType::kPointer:
+        return std::memcmp(current, &spec.pointer_value, 8) == 0;
+      case ScanValueType::kPattern:
+        return PatternMatchesAt(current, spec.pattern.data(), spec.mask.data(), width);
+    }
+    return false;
+  }
+
+  // Signed difference between current and previous: < 0 decreased, 0 unchanged, > 0 increased.
+  int order;
+  switch (spec.type) {
+    case ScanValueType::kInt32: {
+      int32_t a, b;
+      std::memcpy(&a, current, 4);
+      std::memcpy(&b, previous, 4);
+      order = (a > b) - (a < b);
+      break;
+    }
+    case ScanValueType::kFloat: {
+      float a, b;
+      std::memcpy(&a, current, 4);
+      std::memcpy(&b, previous, 4);
+      order = std::fabs(a - b) <= spec.epsilon ? 0 : (a > b ? 1 : -1);
+      break;
+    }
+    case ScanValueType::kPointer: {
+      uint64_t a, b;
+      std::memcpy(&a, current, 8);
+      std::memcpy(&b, previous, 8);
+      order = (a > b) - (a < b);
+      break;
+    }
+    case ScanValueType::kPattern:
+      // Bytes have no ordering; only changed/unchanged are meaningful.
+      if (spec.compare == ScanCompare::kIncreased || spec.compare == ScanCompare::kDecreased) return false;
+      order = std::memcmp(current, previous, width) == 0 ? 0 : 1;
+      break;
+    default:
+      return false;
+  }
+
+  switch (spec.compare) {
+    case ScanCompare::kChanged:
+      return order != 0;
+    case ScanCompare::kUnchanged:
+      return order == 0;
+    case ScanCompare::kIncreased:
+      return order > 0;
+    case ScanCompare::kDecreased:
+      return order < 0;
+    default:
+      return false;
+  }
+}
+
+}  // namespace nyx
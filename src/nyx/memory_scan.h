@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nyx {
+
+// Matching core behind memory.scan(). It only works on plain buffers, so it does not depend on V8 or
+// Win32 and can be exercised against a synthetic heap on any platform.
+
+enum class ScanValueType : uint8_t {
+  kInt32,
+  kFloat,
+  kPointer,
+  kPattern,
+};
+
+enum class ScanCompare : uint8_t {
+  kEqual,
+  kChanged,
+  kUnchanged,
+  kIncreased,
+  kDecreased,
+};
+
+struct ScanSpec {
+  ScanValueType type = ScanValueType::kInt32;
+  ScanCompare compare = ScanCompare::kEqual;
+  int32_t int_value = 0;
+  float float_value = 0.0f;
+  float epsilon = 0.0f;
+  uint64_t pointer_value = 0;
+  // kPattern only. mask[i] == 0 marks pattern[i] as a wildcard.
+  std::vector<uint8_t> pattern;
+  std::vector<uint8_t> mask;
+  // Hits start at addresses that are a multiple of alignment.
+  uint32_t alignment = 1;
+
+  // Number of bytes covered by one hit.
+  size_t width() const;
+};
+
+// Appends the address of every match that lies entirely within data, which was read from base.
+// Returns false if it stopped early because hits reached max_hits.
+bool ScanBuffer(const ScanSpec& spec, const uint8_t* data, size_t size, uint64_t base, size_t max_hits,
+                std::vector<uint64_t>* hits);
+
+// Next-scan test for one previous hit. current and previous each hold spec.width() bytes; previous is
+// ignored for kEqual.
+bool MatchesNext(const ScanSpec& spec, const uint8_t* current, const uint8_t* previous);
+
+}  // namespace nyx
@@ -0,0 +1,253 @@
+#include "nyx/module_code_cache.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+
+namespace nyx {
+
+using v8::HandleScope;
+using v8::Isolate;
+using v8::Local;
+using v8::Module;
+using v8::ScriptCompiler;
+using v8::String;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::string Hex(uint64_t value) {
+  char buffer[17];
+  snprintf(buffer, sizeof(buffer), "%016" PRIx64, value);
+  return buffer;
+}
+
+bool WriteEntry(const fs::path& path, const std::vector<uint8_t>& data) {
+  // Written under a temporary name so a concurrent reader never sees a partial entry.
+  fs::path temp = path;
+  temp += ".tmp";
+  {
+    std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+    if (!out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+      return false;
+    }
+  }
+  std::error_code ec;
+  fs::rename(temp, path, ec);
+  if (ec) {
+    fs::remove(temp, ec);
+    return false;
+  }
+  return true;
+}
+
+uint64_t EvictLeastRecentlyUsed(const fs::path& directory, uint64_t max_bytes) {
+  struct File {
+    fs::path path;
+    uint64_t size;
+    fs::file_time_type time;
+  };
+  std::vector<File> files;
+  uint64_t total = 0;
+  std::error_code ec;
+  // Incremented with an error code: another process may remove or lock entries while this runs, and a
+  // throwing iterator would terminate the thread pool.
+  for (fs::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+    const fs::directory_entry& entry = *it;
+    std::error_code entry_ec;
+    if (!entry.is_regular_file(entry_ec)) {
+      continue;
+    }
+    uint64_t size = entry.file_size(entry_ec);
+    if (entry_ec) {
+      continue;
+    }
+    fs::file_time_type time = entry.last_write_time(entry_ec);
+    if (entry_ec) {
+      continue;
+    }
+    files.push_back({entry.path(), size, time});
+    total += size;
+  }
+  if (total <= max_bytes) {
+    return 0;
+  }
+
+  std::sort(files.begin(), files.end(), [](const File& a, const File& b) { return a.time < b.time; });
+  uint64_t evicted = 0;
+  for (const File& file : files) {
+    if (total <= max_bytes) {
+      break;
+    }
+    if (fs::remove(file.path, ec)) {
+      total -= file.size;
+      evicted++;
+    }
+  }
+  return evicted;
+}
+
+}  // namespace
+
+ModuleCodeCache::ModuleCodeCache(uv_loop_t* loop, Isolate* isolate, const std::string& root, uint64_t max_bytes)
+    : loop_(loop), isolate_(isolate), max_bytes_(max_bytes) {
+  if (root.empty()) {
+    return;
+  }
+  root_ = (fs::path(root) / ".nyx" / "code-cache").string();
+  directory_ = (fs::path(root_) / Hex(ScriptCompiler::CachedDataVersionTag())).string();
+
+  uv_timer_init(loop_, &flush_timer_);
+  uv_unref(reinterpret_cast<uv_handle_t*>(&flush_timer_));
+  flush_timer_.data = this;
+}
+
+ModuleCodeCache::~ModuleCodeCache() {}
+
+uint64_t ModuleCodeCache::Key(Isolate* isolate, Local<String> source) {
+  // FNV-1a over the UTF-8 text, seeded with its length.
+  String::Utf8Value utf8(isolate, source);
+  uint64_t hash = 14695981039346656037ull ^ static_cast<uint64_t>(utf8.length());
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(*utf8);
+  for (int i = 0; i < utf8.length(); i++) {
+    hash = (hash ^ bytes[i]) * 1099511628211ull;
+  }
+  return hash;
+}
+
+std::string ModuleCodeCache::EntryPath(uint64_t key) const {
+  return (fs::path(directory_) / (Hex(key) + ".bin")).string();
+}
+
+ScriptCompiler::CachedData* ModuleCodeCache::Lookup(uint64_t key) {
+  std::string path = EntryPath(key);
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  if (!in) {
+    stats_.misses++;
+    return nullptr;
+  }
+  std::streamsize size = in.tellg();
+  if (size <= 0 || size > INT32_MAX) {
+    stats_.misses++;
+    return nullptr;
+  }
+  std::unique_ptr<uint8_t[]> data(new uint8_t[static_cast<size_t>(size)]);
+  in.seekg(0);
+  if (!in.read(reinterpret_cast<char*>(data.get()), size)) {
+    stats_.misses++;
+    return nullptr;
+  }
+
+  // Eviction goes by modification time, so a hit marks the entry as recently used.
+  std::error_code ec;
+  fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+
+  return new ScriptCompiler::CachedData(
+      data.release(), static_cast<int>(size), ScriptCompiler::CachedData::BufferOwned);
+}
+
+void ModuleCodeCache::Consumed(uint64_t key, bool rejected) {
+  if (!rejected) {
+    stats_.hits++;
+    return;
+  }
+  stats_.rejected++;
+  std::error_code ec;
+  fs::remove(EntryPath(key), ec);
+}
+
+void ModuleCodeCache::Produce(uint64_t key, Local<Module> module) {
+  if (!enabled()) {
+    return;
+  }
+  pending_.push_back({key, v8::Global<Module>(isolate_, module)});
+}
+
+void ModuleCodeCache::ScheduleFlush() {
+  if (!enabled() || pending_.empty()) {
+    return;
+  }
+  uv_timer_start(&flush_timer_, OnFlushTimer, kFlushDelay, 0);
+}
+
+void ModuleCodeCache::OnFlushTimer(uv_timer_t* handle) {
+  static_cast<ModuleCodeCache*>(handle->data)->Flush();
+}
+
+void ModuleCodeCache::Flush() {
+  std::unique_ptr<WriteJob> job = std::make_unique<WriteJob>();
+  job->req.data = job.get();
+  job->cache = this;
+  job->root = root_;
+  job->directory = directory_;
+  job->max_bytes = max_bytes_;
+  job->remove_stale = !removed_stale_;
+  job->stored = 0;
+  job->evicted = 0;
+
+  {
+    HandleScope handle_scope(isolate_);
+    // A module still not evaluated kFlushDelay after the last evaluation is most likely part of a graph that
+    // failed to link and never will be. It is dropped with the ones that threw rather than held forever; at
+    // worst a module still loading goes without a cache until the next run.
+    std::erase_if(pending_, [&](const Pending& pending) {
+      Local<Module> module = pending.module.Get(isolate_);
+      if (module->GetStatus() != Module::kEvaluated) {
+        return true;
+      }
+      std::unique_ptr<ScriptCompiler::CachedData> data(
+          ScriptCompiler::CreateCodeCache(module->GetUnboundModuleScript()));
+      if (data && data->length > 0) {
+        job->entries.push_back({pending.key, std::vector<uint8_t>(data->data, data->data + data->length)});
+      }
+      return true;
+    });
+  }
+  if (job->entries.empty()) {
+    return;
+  }
+  removed_stale_ = true;
+
+  if (uv_queue_work(loop_, &job->req, RunWriteJob, AfterWriteJob) == 0) {
+    job.release();
+  }
+}
+
+void ModuleCodeCache::RunWriteJob(uv_work_t* req) {
+  WriteJob* job = static_cast<WriteJob*>(req->data);
+  std::error_code ec;
+  fs::path directory(job->directory);
+
+  if (job->remove_stale) {
+    for (fs::directory_iterator it(job->root, ec), end; !ec && it != end; it.increment(ec)) {
+      if (it->path() != directory) {
+        std::error_code remove_ec;
+        fs::remove_all(it->path(), remove_ec);
+      }
+    }
+    ec.clear();
+  }
+
+  fs::create_directories(directory, ec);
+  if (ec) {
+    return;
+  }
+  for (const Entry& entry : job->entries) {
+    if (WriteEntry(directory / (Hex(entry.key) + ".bin"), entry.data)) {
+      job->stored++;
+    }
+  }
+  job->evicted = EvictLeastRecentlyUsed(directory, job->max_bytes);
+}
+
+void ModuleCodeCache::AfterWriteJob(uv_work_t* req, int status) {
+  std::unique_ptr<WriteJob> job(static_cast<WriteJob*>(req->data));
+  job->cache->stats_.stored += job->stored;
+  job->cache->stats_.evicted += job->evicted;
+}
+
+}  // namespace nyx
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <uv.h>
+#include <v8.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace nyx {
+
+// On-disk V8 code cache for user ES modules, keyed by a hash of the module source.
+//
+// ModuleWrap::CompileSourceTextModule consumes an entry when one exists; a module compiled without one is queued.
+// kFlushDelay after the last ModuleWrap evaluation, the queued modules that have been evaluated are serialized on
+// the loop thread, so functions that ran at top level are in their cache too, and written by the thread pool.
+// The others are dropped from the queue.
+//
+// Entries live in <root>/<CachedDataVersionTag>/, so a V8 upgrade or flag change starts an empty directory and
+// the stale ones are removed by the first write. When the directory grows past max_bytes, the least recently
+// used entries are deleted.
+//
+// The timer lives on the environment's loop and is closed by CloseEventLoop.
+class ModuleCodeCache {
+ public:
+  static constexpr uint64_t kDefaultMaxBytes = 64ull << 20;
+  static constexpr uint64_t kFlushDelay = 1000;  // ms
+
+  struct Stats {
+    uint64_t hits;
+    uint64_t rejected;  // entries V8 refused, deleted and rewritten
+    uint64_t misses;
+    uint64_t stored;
+    uint64_t evicted;
+  };
+
+  // An empty root disables the cache.
+  ModuleCodeCache(uv_loop_t* loop, v8::Isolate* isolate, const std::string& root, uint64_t max_bytes = kDefaultMaxBytes);
+  ~ModuleCodeCache();
+
+  ModuleCodeCache(const ModuleCodeCache&) = delete;
+  ModuleCodeCache& operator=(const ModuleCodeCache&) = delete;
+
+  bool enabled() const { return !directory_.empty(); }
+
+  static uint64_t Key(v8::Isolate* isolate, v8::Local<v8::String> source);
+
+  // The stored cache for key, or nullptr. ScriptCompiler::Source takes ownership of the result.
+  v8::ScriptCompiler::CachedData* Lookup(uint64_t key);
+  // Reports whether V8 accepted what Lookup returned; a rejected entry is deleted.
+  void Consumed(uint64_t key, bool rejected);
+
+  // Queues a module compiled without a usable cache. Its cache is written once it has been evaluated.
+  void Produce(uint64_t key, v8::Local<v8::Module> module);
+  // Called after evaluating modules; restarts the flush delay.
+  void ScheduleFlush();
+
+  Stats stats() const { return stats_; }
+  void ResetStats() { stats_ = {}; }
+
+ private:
+  struct Entry {
+    uint64_t key;
+    std::vector<uint8_t> data;
+  };
+
+  struct WriteJob {
+    uv_work_t req;
+    ModuleCodeCache* cache;
+    std::string root;
+    std::string directory;
+    uint64_t max_bytes;
+    bool remove_stale;
+    std::vector<Entry> entries;
+    uint64_t stored;
+    uint64_t evicted;
+  };
+
+  std::string EntryPath(uint64_t key) const;
+
+  static void OnFlushTimer(uv_timer_t* handle);
+  static void RunWriteJob(uv_work_t* req);
+  static void AfterWriteJob(uv_work_t* req, int status);
+  void Flush();
+
+  struct Pending {
+    uint64_t key;
+    v8::Global<v8::Module> module;
+  };
+
+  uv_loop_t* loop_;
+  v8::Isolate* isolate_;
+  uv_timer_t flush_timer_;
+  std::string root_;
+  std::string directory_;
+  uint64_t max_bytes_;
+  bool removed_stale_ = false;
+  std::vector<Pending> pending_;
+  Stats stats_ = {};
+};
+
+}  // namespace nyx
@@ -2,6 +2,8 @@
 
 #include "nyx/env.h"
 #include "nyx/errors.h"
+#include "nyx/external_references.h"
+#include "nyx/module_code_cache.h"
 #include "nyx/nyx_binding.h"
 #include "nyx/realm.h"
 
@@ -33,6 +35,7 @@ using v8::Module;
 using v8::ModuleRequest;
 using v8::Name;
 using v8::Nothing;
+using v8::Number;
 using v8::Object;
 using v8::ObjectTemplate;
 using v8::PrimitiveArray;
@@ -99,6 +102,7 @@ ModuleCacheKey ModuleCacheKey::From(Local<Context> context, Local<ModuleRequest>
 }
 
 static void ThrowIfPromiseRejected(const FunctionCallbackInfo<Value>& args);
+static void GetCodeCacheStats(const FunctionCallbackInfo<Value>& args);
 
 void ModuleWrap::CreatePerIsolateProperties(IsolateData* isolate_data, Local<ObjectTemplate> target) {
   Isolate* isolate = isolate_data->isolate();
@@ -129,6 +133,7 @@ void ModuleWrap::CreatePerIsolateProperties(IsolateData* isolate_data, Local<Obj
   SetMethod(isolate, target, "setInitializeImportMetaObjectCallback", SetInitializeImportMetaObjectCallback);
   SetMethod(isolate, target, "createRequiredModuleFacade", CreateRequiredModuleFacade);
   SetMethod(isolate, target, "throwIfPromiseRejected", ThrowIfPromiseRejected);
+  SetMethod(isolate, target, "getCodeCacheStats", GetCodeCacheStats);
 }
 
 void ModuleWrap::CreatePerContextProperties(Local<Object> target, Local<Context> context) {
@@ -145,6 +150,28 @@ void ModuleWrap::CreatePerContextProperties(Local<Object> target, Local<Context>
 #undef V
 }
 
+void ModuleWrap::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(Link);
+  registry->Register(GetModuleRequests);
+  registry->Register(Instantiate);
+  registry->Register(Evaluate);
+  registry->Register(EvaluateSync);
+  registry->Register(SetSyntheticExport);
+  registry->Register(SetModuleSourceObject);
+  registry->Register(GetModuleSourceObject);
+  registry->Register(GetNamespace);
+  registry->Register(GetStatus);
+  registry->Register(GetError);
+  registry->Register(HasAsyncGraph);
+
+  registry->Register(SetImportModuleDynamicallyCallback);
+  registry->Register(SetInitializeImportMetaObjectCallback);
+  registry->Register(CreateRequiredModuleFacade);
+  registry->Register(ThrowIfPromiseRejected);
+  registry->Register(GetCodeCacheStats);
+}
+
 void ModuleWrap::HostInitializeImportMetaObjectCallback(Local<Context> context,
                                                         Local<Module> module,
                                                         Local<Object> meta) {
@@ -227,13 +254,35 @@ MaybeLocal<Module> ModuleWrap::CompileSourceTextModule(Realm* realm,
 
   ScriptOrigin origin(
       url, line_offset, column_offset, true, -1, Local<Value>(), false, false, true, host_defined_options);
-  ScriptCompiler::Source source(source_text, origin);
+
+  ModuleCodeCache& code_cache = realm->env()->module_code_cache();
+  uint64_t cache_key = 0;
+  ScriptCompiler::CachedData* cached_data = nullptr;
+  if (code_cache.enabled()) {
+    cache_key = ModuleCodeCache::Key(isolate, source_text);
+    cached_data = code_cache.Lookup(cache_key);
+  }
+
+  // Source takes ownership of cached_data. A rejected cache makes V8 compile from source instead.
+  ScriptCompiler::Source source(source_text, origin, cached_data);
+  ScriptCompiler::CompileOptions options =
+      cached_data ? ScriptCompiler::kConsumeCodeCache : ScriptCompiler::kNoCompileOptions;
 
   Local<Module> module;
-  if (!ScriptCompiler::CompileModule(isolate, &source, ScriptCompiler::kNoCompileOptions).ToLocal(&module)) {
+  if (!ScriptCompiler::CompileModule(isolate, &source, options).ToLocal(&module)) {
     return scope.EscapeMaybe(MaybeLocal<Module>());
   }
 
+  if (code_cache.enabled()) {
+    bool rejected = cached_data && source.GetCachedData()->rejected;
+    if (cached_data) {
+      code_cache.Consumed(cache_key, rejected);
+    }
+    if (!cached_data || rejected) {
+      code_cache.Produce(cache_key, module);
+    }
+  }
+
   return scope.Escape(module);
 }
 
@@ -590,6 +639,7 @@ void ModuleWrap::Evaluate(const FunctionCallbackInfo<Value>& args) {
 
   TryCatchScope try_catch(isolate);
   MaybeLocal<Value> result = module->Evaluate(context);
+  realm->env()->module_code_cache().ScheduleFlush();
   if (result.IsEmpty()) {
     CHECK(try_catch.HasCaught());
   }
@@ -627,6 +677,30 @@ void ThrowIfPromiseRejected(const FunctionCallbackInfo<Value>& args) {
   ThrowIfPromiseRejected(Realm::GetCurrent(args), args[0].As<Promise>());
 }
 
+// getCodeCacheStats(reset?: boolean)
+void GetCodeCacheStats(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  Local<Context> context = isolate->GetCurrentContext();
+  ModuleCodeCache& code_cache = env->module_code_cache();
+  ModuleCodeCache::Stats stats = code_cache.stats();
+  if (args[0]->IsTrue()) {
+    code_cache.ResetStats();
+  }
+
+  Local<Object> result = Object::New(isolate);
+  auto set = [&](const char* name, Local<Value> value) {
+    result->Set(context, OneByteString(isolate, name), value).Check();
+  };
+  set("enabled", Boolean::New(isolate, code_cache.enabled()));
+  set("hits", Number::New(isolate, static_cast<double>(stats.hits)));
+  set("rejected", Number::New(isolate, static_cast<double>(stats.rejected)));
+  set("misses", Number::New(isolate, static_cast<double>(stats.misses)));
+  set("stored", Number::New(isolate, static_cast<double>(stats.stored)));
+  set("evicted", Number::New(isolate, static_cast<double>(stats.evicted)));
+  args.GetReturnValue().Set(result);
+}
+
 void ModuleWrap::EvaluateSync(const v8::FunctionCallbackInfo<v8::Value>& args) {
   Realm* realm = Realm::GetCurrent(args);
   Isolate* isolate = args.GetIsolate();
@@ -639,7 +713,9 @@ void ModuleWrap::EvaluateSync(const v8::FunctionCallbackInfo<v8::Value>& args) {
   Local<Value> result;
   {
     TryCatchScope try_catch(isolate);
-    if (!module->Evaluate(context).ToLocal(&result)) {
+    bool evaluated = module->Evaluate(context).ToLocal(&result);
+    env->module_code_cache().ScheduleFlush();
+    if (!evaluated) {
       if (try_catch.HasCaught()) {
         if (!try_catch.HasTerminated()) {
           try_catch.ReThrow();
@@ -850,5 +926,6 @@ v8::Maybe<ModuleWrap*> ModuleWrap::ResolveModule(v8::Local<v8::Context> context,
 
 NYX_BINDING_PER_ISOLATE_INIT(module_wrap, ModuleWrap::CreatePerIsolateProperties)
 NYX_BINDING_CONTEXT_AWARE(module_wrap, ModuleWrap::CreatePerContextProperties)
+NYX_BINDING_EXTERNAL_REFERENCE(module_wrap, ModuleWrap::RegisterExternalReferences)
 
 }  // namespace nyx
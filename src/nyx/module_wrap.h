@@ -8,6 +8,8 @@
 
 namespace nyx {
 
+class ExternalReferenceRegistry;
+
 struct ModuleCacheKey {
   using ImportAttributeVector = std::vector<std::pair<std::string, std::string>>;
 
@@ -59,6 +61,7 @@ class ModuleWrap : public BaseObject {
 
   static void CreatePerIsolateProperties(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
   static void CreatePerContextProperties(v8::Local<v8::Object> target, v8::Local<v8::Context> context);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
   static void HostInitializeImportMetaObjectCallback(v8::Local<v8::Context> context,
                                                      v8::Local<v8::Module> module,
                                                      v8::Local<v8::Object> meta);
@@ -2,15 +2,25 @@
 
 #include <uv.h>
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <memory>
 
 #include <libplatform/libplatform.h>
 
 #include "nyx/builtins.h"
+#include "nyx/checksum_cache.h"
+#include "nyx/external_references.h"
+#include "nyx/frame_scheduler.h"
+#include "nyx/frame_timeline.h"
+#include "nyx/gc_scheduler.h"
 #include "nyx/gui/widget_manager.h"
+#include "nyx/heap.h"
 #include "nyx/imgui_draw_context.h"
 #include "nyx/nyx_imgui.h"
+#include "nyx/package_watchdog.h"
+#include "nyx/snapshot.h"
 #include "nyx/util.h"
 
 namespace nyx {
@@ -37,7 +47,9 @@ static std::unique_ptr<v8::Platform> platform_;
 static std::atomic<uv_async_t*> shutdown_handle_{nullptr};
 static std::atomic<bool> running_{false};
 static std::atomic<bool> restart_requested_{false};
+static std::atomic<bool> reuse_isolate_{false};
 static std::string scripts_root_;
+static size_t heap_limit_ = 0;
 
 static FILE* g_stdout_{stdout};
 static FILE* g_stderr_{stderr};
@@ -62,6 +74,11 @@ static void SpinEventLoop(Environment* env) {
   Context::Scope context_scope(context);
 
   ImGuiDrawContext* draw_ctx = env->draw_context();
+  FrameScheduler& scheduler = env->frame_scheduler();
+  GcScheduler& gc = env->gc_scheduler();
+  PackageWatchdog& watchdog = env->package_watchdog();
+  FrameTimeline& timeline = env->frame_timeline();
+  using Phase = FrameTimeline::Phase;
 
   if (draw_ctx) {
     draw_ctx->BeginFrame();
@@ -69,22 +86,63 @@ static void SpinEventLoop(Environment* env) {
 
   bool more = true;
   while (more) {
-    isolate->PerformMicrotaskCheckpoint();
-    more = uv_run(env->event_loop(), UV_RUN_ONCE) != 0;
+    {
+      FrameTimeline::Scope timed(&timeline, Phase::kMicrotasks);
+      PackageWatchdog::MicrotaskScope guarded(&watchdog);
+      isolate->PerformMicrotaskCheckpoint();
+    }
+    {
+      FrameTimeline::Scope timed(&timeline, Phase::kUvRun);
+      more = uv_run(env->event_loop(), UV_RUN_ONCE) != 0;
+    }
+    watchdog.CancelStoppedPackages();
 
     if (isolate->HasPendingBackgroundTasks()) {
       more = true;
     }
 
+    // Iterations woken by I/O or timers between frames only run their callbacks.
+    if (!scheduler.ShouldBuildFrame()) {
+      continue;
+    }
+
+    gc.FrameStarted();
+    watchdog.FrameStarted();
+    timeline.FrameStarted();
+    {
+      FrameTimeline::Scope timed(&timeline, Phase::kMicrotasks);
+      PackageWatchdog::MicrotaskScope guarded(&watchdog);
+      isolate->PerformMicrotaskCheckpoint();
+    }
     if (env->widget_manager()) {
-      env->widget_manager()->UpdateAll();
+      {
+        FrameTimeline::Scope timed(&timeline, Phase::kUpdate);
+        env->widget_manager()->UpdateAll();
+      }
+      FrameTimeline::Scope timed(&timeline, Phase::kRender);
       env->widget_manager()->RenderAll();
     }
 
     if (draw_ctx) {
-      draw_ctx->EndFrame();
+      draw_ctx->EndFrame(&timeline);
+      FrameTimeline::Scope timed(&timeline, Phase::kBeginFrame);
       draw_ctx->BeginFrame();
     }
+
+    env->checksum_cache().AdvanceFrame();
+    scheduler.FrameBuilt();
+    timeline.FrameBuilt();
+    gc.FrameEnded();
+    watchdog.CancelStoppedPackages();
+
+    // Give V8 the slack until the next frame or timer is due.
+    auto deadline = scheduler.next_frame_time();
+    int timeout = uv_backend_timeout(env->event_loop());
+    if (timeout >= 0) {
+      deadline = std::min(deadline, GcScheduler::Clock::now() + std::chrono::milliseconds(timeout));
+    }
+    FrameTimeline::Scope timed(&timeline, Phase::kIdleTasks);
+    gc.RunIdle(platform_.get(), deadline);
   }
 
   if (draw_ctx && draw_ctx->frame_active()) {
@@ -92,28 +150,27 @@ static void SpinEventLoop(Environment* env) {
   }
 }
 
-static void CloseWalkCallback(uv_handle_t* handle, void* arg) {
-  if (!uv_is_closing(handle)) {
-    uv_close(handle, nullptr);
-  }
+static void OnShutdownSignal(uv_async_t* handle) {
+  shutdown_handle_.store(nullptr, std::memory_order_release);
+  // Other threads must stop signalling the loop's handles before they start closing.
+  static_cast<Environment*>(handle->data)->Stop();
+  CloseAllHandles(handle->loop);
 }
 
-static void CloseEventLoop(uv_loop_t* loop) {
-  uv_walk(loop, CloseWalkCallback, nullptr);
-
-  while (uv_loop_alive(loop)) {
-    uv_run(loop, UV_RUN_ONCE);
-  }
+void SetHeapLimit(size_t bytes) {
+  heap_limit_ = bytes;
+}
+size_t GetHeapLimit() {
+  return heap_limit_;
 }
 
-static void OnShutdownSignal(uv_async_t* handle) {
-  shutdown_handle_.store(nullptr, std::memory_order_release);
-  uv_loop_t* loop = handle->loop;
-  uv_walk(loop, CloseWalkCallback, nullptr);
+v8::Platform* GetPlatform() {
+  return platform_.get();
 }
 
 void Initialize() {
-  platform_ = v8::platform::NewDefaultPlatform();
+  // Idle tasks run in the time between UI frames, see GcScheduler.
+  platform_ = v8::platform::NewDefaultPlatform(0, v8::platform::IdleTaskSupport::kEnabled);
   v8::V8::InitializePlatform(platform_.get());
   v8::V8::Initialize();
 }
@@ -132,41 +189,79 @@ int Start(NyxImGui* nyx_imgui, GameLock* game_lock) {
       return 1;
     }
 
-    uv_async_t shutdown_async;
-    uv_async_init(&event_loop, &shutdown_async, OnShutdownSignal);
-    shutdown_handle_.store(&shutdown_async, std::memory_order_release);
-
     RegisterBuiltinBindings();
 
     {
       Isolate::CreateParams create_params;
-      create_params.array_buffer_allocator = ArrayBuffer::Allocator::NewDefaultAllocator();
+      // Shared so that backing stores transferred to a worker outlive this isolate.
+      create_params.array_buffer_allocator_shared =
+          std::shared_ptr<ArrayBuffer::Allocator>(ArrayBuffer::Allocator::NewDefaultAllocator());
+      const v8::StartupData* snapshot = SnapshotBuilder::GetUsableSnapshotData();
+      if (snapshot) {
+        create_params.snapshot_blob = snapshot;
+        create_params.external_references = ExternalReferenceRegistry::Get().external_references();
+      }
+      if (heap_limit_ > 0) {
+        create_params.constraints.ConfigureDefaultsFromHeapSize(0, heap_limit_);
+      }
       Isolate* isolate = Isolate::New(create_params);
+      auto heap_limit_handler =
+          std::make_unique<NearHeapLimitHandler>(isolate, []() { Restart(RestartMode::kFull); });
       // fixme: isolate data is created here but it should really be created by Environment
       // with the current order CreateProperties does not have access to Environment which it should
       //  -> pass event_loop to Environment and move IsolateData ownership there
-      IsolateData* isolate_data = new IsolateData(isolate, &event_loop);
-
-      {
-        Isolate::Scope isolate_scope(isolate);
-        HandleScope handle_scope(isolate);
-
-        Environment env(isolate_data, isolate, scripts_root_, nyx_imgui, game_lock);
-        Realm* realm = env.principal_realm();
-        realm->ExecuteBootstrapper("internal/main/run_packages");
-        SpinEventLoop(&env);
-
-        nyx_imgui->ClearDrawData();
-        CloseEventLoop(&event_loop);
-      }
-
+      IsolateData* isolate_data = new IsolateData(isolate, &event_loop, snapshot != nullptr);
+
+      // A RestartMode::kReuseIsolate restart only replaces the environment: its context, realm, module registry,
+      // timers and widgets. The isolate, its templates, the allocator and the (by then empty) event loop stay.
+      bool reuse_isolate = false;
+      do {
+        restart_requested_.store(false, std::memory_order_release);
+
+        // CloseEventLoop closes this along with every other handle, so each environment gets its own.
+        uv_async_t shutdown_async;
+        uv_async_init(&event_loop, &shutdown_async, OnShutdownSignal);
+        shutdown_handle_.store(&shutdown_async, std::memory_order_release);
+
+        {
+          Isolate::Scope isolate_scope(isolate);
+          HandleScope handle_scope(isolate);
+
+          Environment env(isolate_data, isolate, scripts_root_, nyx_imgui, game_lock);
+          // The loop first runs in SpinEventLoop, so the signal cannot arrive before this.
+          shutdown_async.data = &env;
+          Realm* realm = env.principal_realm();
+          realm->ExecuteBootstrapper("internal/main/run_packages");
+          SpinEventLoop(&env);
+
+          nyx_imgui->ClearDrawData();
+          {
+            // Nothing queued by this context may run in the next one. Drained before the handles close, so
+            // whatever these microtasks start is closed with everything else.
+            Context::Scope context_scope(env.context());
+            PackageWatchdog::MicrotaskScope guarded(&env.package_watchdog());
+            isolate->PerformMicrotaskCheckpoint();
+          }
+          env.Stop();
+          CloseEventLoop(&event_loop);
+        }
+
+        shutdown_handle_.store(nullptr, std::memory_order_release);
+
+        reuse_isolate =
+            restart_requested_.load(std::memory_order_acquire) && reuse_isolate_.load(std::memory_order_acquire);
+        if (reuse_isolate) {
+          // A watchdog may have terminated the last script; the next context must start clean.
+          isolate->CancelTerminateExecution();
+          isolate->ContextDisposedNotification();
+        }
+      } while (reuse_isolate);
+
+      heap_limit_handler.reset();
       delete isolate_data;
       isolate->Dispose();
-      delete create_params.array_buffer_allocator;
     }
 
-    shutdown_handle_.store(nullptr, std::memory_order_release);
-
     uv_loop_close(&event_loop);
 
   } while (restart_requested_.load(std::memory_order_acquire));
@@ -182,7 +277,8 @@ void Shutdown() {
   }
 }
 
-void Restart() {
+void Restart(RestartMode mode) {
+  reuse_isolate_.store(mode == RestartMode::kReuseIsolate, std::memory_order_release);
   restart_requested_.store(true, std::memory_order_release);
   Shutdown();
 }
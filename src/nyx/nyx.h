@@ -19,15 +19,31 @@ FILE* GetStderr();
 // Call once at startup, initializes V8 platform.
 void Initialize();
 
+// The platform created by Initialize(), for isolates running their own loops.
+v8::Platform* GetPlatform();
+
+// Maximum heap size in bytes for the isolates Start() and workers create, 0 for V8's default. Set before Start().
+// An isolate that reaches its limit is restarted, or a worker stopped, instead of aborting the process.
+void SetHeapLimit(size_t bytes);
+size_t GetHeapLimit();
+
 // Blocks until Shutdown() is called. Safe to call repeatedly after Initialize().
 int Start(NyxImGui* nyx_imgui = nullptr, GameLock* game_lock = nullptr);
 
 // Thread-safe. Signals the running instance to stop.
 void Shutdown();
 
+enum class RestartMode {
+  // Disposes the isolate and event loop and starts over as if Start() had just been called.
+  kFull,
+  // Keeps the isolate, its templates and the allocator; only the environment and its context are recreated.
+  // Scripts still start from a fresh global object, module registry, timers and widgets. Meant for hot reload.
+  kReuseIsolate,
+};
+
 // Thread-safe. Tears down the current isolate/env and spins up a fresh one
 // without returning from Start(). Safe to call from anywhere.
-void Restart();
+void Restart(RestartMode mode = RestartMode::kFull);
 
 // Call once at final cleanup, disposes V8 platform.
 void Teardown();
@@ -1,16 +1,15 @@
 #include "nyx/nyx_binding.h"
 
 #include "nyx/base_object.h"
+#include "nyx/env.h"
 #include "nyx/errors.h"
 #include "nyx/extension.h"
 #include "nyx/isolate_data.h"
 #include "nyx/realm.h"
+#include "nyx/worker.h"
 
 namespace nyx {
 
-// Forward declaration from extension.cc
-v8::Local<v8::ObjectTemplate> GetExternalBindingTemplate(v8::Isolate* isolate, const std::string& name);
-
 using v8::Context;
 using v8::EscapableHandleScope;
 using v8::FunctionCallbackInfo;
@@ -28,9 +27,14 @@ using v8::Value;
   V(module_wrap)                                                                                                       \
   V(fs)                                                                                                                \
   V(gui)                                                                                                               \
+  V(heap)                                                                                                              \
   V(memory)                                                                                                            \
   V(process)                                                                                                           \
-  V(timers)
+  V(profiler)                                                                                                          \
+  V(timers)                                                                                                            \
+  V(trace)                                                                                                             \
+  V(watchdog)                                                                                                          \
+  V(worker)
 
 #define NYX_BUILTIN_BINDINGS(V) NYX_BUILTIN_STANDARD_BINDINGS(V)
 
@@ -98,7 +102,7 @@ static Local<Object> GetInternalBindingExportObject(IsolateData* isolate_data,
 #undef V
   {
     // check for external bindings
-    templ = GetExternalBindingTemplate(isolate_data->isolate(), binding_name);
+    templ = isolate_data->external_binding_template(binding_name);
     if (templ.IsEmpty()) {
       templ = isolate_data->binding_data_default_template();
     }
@@ -124,6 +128,11 @@ void GetInternalBinding(const FunctionCallbackInfo<Value>& args) {
   String::Utf8Value module_v(isolate, module);
   Local<Object> exports;
 
+  if (realm->env()->worker() && !Worker::IsBindingAllowed(*module_v)) {
+    THROW_ERR_INVALID_MODULE(isolate, *module_v);
+    return;
+  }
+
   InternalBinding* mod = FindModule(*module_v);
   if (mod != nullptr) {
     exports = InitInternalBinding(realm, mod);
@@ -14,7 +14,12 @@ class IsolateData;
   V(process)                                                                                                           \
   V(memory)                                                                                                            \
   V(timers)                                                                                                            \
-  V(gui)
+  V(gui)                                                                                                               \
+  V(heap)                                                                                                              \
+  V(profiler)                                                                                                          \
+  V(trace)                                                                                                             \
+  V(watchdog)                                                                                                          \
+  V(worker)
 
 typedef void (*BindingRegisterContextCallback)(v8::Local<v8::Object> target, v8::Local<v8::Context> context);
 
@@ -5,6 +5,7 @@
 
 #include "nyx/env.h"
 #include "nyx/errors.h"
+#include "nyx/external_references.h"
 #include "nyx/util.h"
 
 namespace nyx {
@@ -1021,7 +1022,30 @@ static void CreatePerIsolateProperties(IsolateData* isolate_data, Local<ObjectTe
 
 static void CreatePerContextProperties(Local<Object> target, Local<Context> context) {}
 
+static void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(ReadFileSync);
+  registry->Register(WriteFileSync);
+  registry->Register(ExistsSync);
+  registry->Register(StatSync);
+  registry->Register(ReaddirSync);
+  registry->Register(MkdirSync);
+  registry->Register(UnlinkSync);
+  registry->Register(RmdirSync);
+  registry->Register(RenameSync);
+  registry->Register(RealpathSync);
+
+  registry->Register(ReadFile);
+  registry->Register(WriteFile);
+  registry->Register(Stat);
+  registry->Register(Readdir);
+  registry->Register(Mkdir);
+  registry->Register(Unlink);
+  registry->Register(Rmdir);
+  registry->Register(Rename);
+}
+
 NYX_BINDING_PER_ISOLATE_INIT(fs, CreatePerIsolateProperties)
 NYX_BINDING_CONTEXT_AWARE(fs, CreatePerContextProperties)
+NYX_BINDING_EXTERNAL_REFERENCE(fs, RegisterExternalReferences)
 
 }  // namespace nyx
@@ -43,25 +43,47 @@ void NyxImGui::ClearDrawData() {
 }
 
 void NyxImGui::PushInputEvent(const ImGuiInputEvent& event) {
-  std::scoped_lock lock(input_mutex_);
-  input_queue_.push_back(event);
+  input_ring_.Push(event);
+
+  // Display size is re-sent on every idle window frame; the next scheduled frame picks it up.
+  if (event.type != ImGuiInputEvent::kDisplaySize && !input_signalled_.exchange(true, std::memory_order_acq_rel)) {
+    std::scoped_lock lock(callback_mutex_);
+    if (input_callback_) {
+      input_callback_();
+    }
+  }
 }
 
 void NyxImGui::PushInputEvents(const ImGuiInputEvent* events, int count) {
-  std::scoped_lock lock(input_mutex_);
-  input_queue_.insert(input_queue_.end(), events, events + count);
+  for (int i = 0; i < count; ++i) {
+    PushInputEvent(events[i]);
+  }
+}
+
+size_t NyxImGui::DrainInputEvents(ImGuiInputEvent* out, size_t capacity) {
+  input_signalled_.store(false, std::memory_order_release);
+  return input_ring_.Drain(out, capacity);
+}
+
+bool NyxImGui::HasPendingInputEvents() const {
+  return !input_ring_.empty();
+}
+
+void NyxImGui::NotifyFrameConsumed() {
+  std::scoped_lock lock(callback_mutex_);
+  if (frame_consumed_callback_) {
+    frame_consumed_callback_();
+  }
 }
 
-std::vector<ImGuiInputEvent> NyxImGui::DrainInputEvents() {
-  std::scoped_lock lock(input_mutex_);
-  std::vector<ImGuiInputEvent> events;
-  events.swap(input_queue_);
-  return events;
+void NyxImGui::SetFrameConsumedCallback(std::function<void()> callback) {
+  std::scoped_lock lock(callback_mutex_);
+  frame_consumed_callback_ = std::move(callback);
 }
 
-bool NyxImGui::HasPendingInputEvents() {
-  std::scoped_lock lock(input_mutex_);
-  return !input_queue_.empty();
+void NyxImGui::SetInputCallback(std::function<void()> callback) {
+  std::scoped_lock lock(callback_mutex_);
+  input_callback_ = std::move(callback);
 }
 
 }  // namespace nyx
@@ -5,8 +5,8 @@
 
 #include <imgui.h>
 #include <atomic>
+#include <functional>
 #include <mutex>
-#include <vector>
 
 namespace nyx {
 
@@ -24,10 +24,13 @@ class NyxImGui {
   // Clear all draw data from both stores (thread-safe).
   void ClearDrawData();
 
+  // Window thread only.
   void PushInputEvent(const ImGuiInputEvent& event);
   void PushInputEvents(const ImGuiInputEvent* events, int count);
-  std::vector<ImGuiInputEvent> DrainInputEvents();
-  bool HasPendingInputEvents();
+  // nyx thread only. Copies up to capacity queued events into out and returns how many.
+  size_t DrainInputEvents(ImGuiInputEvent* out, size_t capacity);
+  bool HasPendingInputEvents() const;
+  const ImGuiInputEventRing& input_ring() const { return input_ring_; }
 
   // Shared font atlas for all ImGui contexts
   ImFontAtlas* font_atlas() { return font_atlas_; }
@@ -45,16 +48,26 @@ class NyxImGui {
   void set_visible(bool v) { visible_.store(v, std::memory_order_relaxed); }
   bool visible() const { return visible_.load(std::memory_order_relaxed); }
 
+  // Renderer thread: the stores were read for a presented frame (whether or not the UI is visible).
+  void NotifyFrameConsumed();
+  // Called by NotifyFrameConsumed on the renderer thread. Used by the frame scheduler to pace frames.
+  void SetFrameConsumedCallback(std::function<void()> callback);
+  // Called on the window thread when input arrives after the last drain, so a frame can be built for it.
+  void SetInputCallback(std::function<void()> callback);
+
  private:
   ImGuiDrawDataStore foreground_;
   ImGuiDrawDataStore background_;
-  std::vector<ImGuiInputEvent> input_queue_;
-  std::mutex input_mutex_;
+  ImGuiInputEventRing input_ring_;
+  std::atomic<bool> input_signalled_{false};
   ImFontAtlas* font_atlas_;
   ImGuiContext* game_context_ = nullptr;
   std::atomic<bool> want_capture_mouse_{false};
   std::atomic<bool> want_capture_keyboard_{false};
   std::atomic<bool> visible_{true};
+  std::mutex callback_mutex_;
+  std::function<void()> frame_consumed_callback_;
+  std::function<void()> input_callback_;
 };
 
 }  // namespace nyx
@@ -1,37 +1,32 @@
+#include "nyx/checksum_cache.h"
 #include "nyx/env.h"
 #include "nyx/errors.h"
+#include "nyx/external_references.h"
 #include "nyx/game_lock.h"
 #include "nyx/isolate_data.h"
+#include "nyx/memory_scan.h"
 #include "nyx/nyx_binding.h"
+#include "nyx/package_watchdog.h"
+#include "nyx/snapshot_arena.h"
 #include "nyx/util.h"
 
 #include <Windows.h>
 #include <nmmintrin.h>
+#include <uv.h>
 
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <cstdlib>
 #include <cstring>
+#include <memory>
 #include <string>
-#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace nyx {
 
-struct MemCacheKey {
-  uint64_t address;
-  uint32_t size;
-  bool operator==(const MemCacheKey& o) const {
-    return address == o.address && size == o.size;
-  }
-};
-struct MemCacheKeyHash {
-  size_t operator()(const MemCacheKey& k) const {
-    size_t h = std::hash<uint64_t>()(k.address);
-    h ^= std::hash<uint32_t>()(k.size) + 0x9e3779b9u + (h << 6) + (h >> 2);
-    return h;
-  }
-};
-static std::unordered_map<MemCacheKey, uint32_t, MemCacheKeyHash> checksum_cache_;
 static thread_local std::vector<uint8_t> read_buf_;
 
 using v8::Array;
@@ -63,15 +58,6 @@ static uint32_t Crc32Hash(const uint8_t* data, size_t size) {
   return static_cast<uint32_t>(crc ^ 0xFFFFFFFFull);
 }
 
-static bool SafeMemcpy(void* dest, const void* src, size_t size) {
-  __try {
-    std::memcpy(dest, src, size);
-    return true;
-  } __except (EXCEPTION_EXECUTE_HANDLER) {
-    return false;
-  }
-}
-
 // readMemory(address: BigInt, size: number) -> Uint8Array
 static void ReadMemory(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
@@ -125,14 +111,10 @@ static void ReadMemoryIfChanged(const FunctionCallbackInfo<Value>& args) {
     }
 
     uint32_t checksum = Crc32Hash(read_buf_.data(), size);
-    MemCacheKey key{address, static_cast<uint32_t>(size)};
-    auto [it, inserted] = checksum_cache_.emplace(key, checksum);
-    if (!inserted) {
-      if (it->second == checksum) {
-        args.GetReturnValue().SetUndefined();
-        return;
-      }
-      it->second = checksum;
+    ChecksumCache& cache = Environment::GetCurrent(args)->checksum_cache();
+    if (cache.Update(address, static_cast<uint32_t>(size), checksum)) {
+      args.GetReturnValue().SetUndefined();
+      return;
     }
 
     auto backing_store = v8::ArrayBuffer::NewBackingStore(isolate, size);
@@ -167,14 +149,10 @@ static void ReadMemoryIntoIfChanged(const FunctionCallbackInfo<Value>& args) {
     std::memcpy(dest, read_buf_.data(), size);
 
     uint32_t checksum = Crc32Hash(read_buf_.data(), size);
-    MemCacheKey key{address, static_cast<uint32_t>(size)};
-    auto [it, inserted] = checksum_cache_.emplace(key, checksum);
-    if (!inserted) {
-      if (it->second == checksum) {
-        args.GetReturnValue().Set(v8::False(isolate));
-        return;
-      }
-      it->second = checksum;
+    ChecksumCache& cache = Environment::GetCurrent(args)->checksum_cache();
+    if (cache.Update(address, static_cast<uint32_t>(size), checksum)) {
+      args.GetReturnValue().Set(v8::False(isolate));
+      return;
     }
   } else {
     if (!SafeMemcpy(dest, reinterpret_cast<void*>(address), size)) {
@@ -187,7 +165,52 @@ static void ReadMemoryIntoIfChanged(const FunctionCallbackInfo<Value>& args) {
 
 // clearChecksumCache() -> void
 static void ClearChecksumCache(const FunctionCallbackInfo<Value>& args) {
-  checksum_cache_.clear();
+  Environment::GetCurrent(args)->checksum_cache().Clear();
+}
+
+// configureChecksumCache(capacity: number, maxAge: number) -> void
+// Capacity is rounded up to a power of two. Existing entries are dropped.
+static void ConfigureChecksumCache(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+
+  if (!args[0]->IsUint32() || !args[1]->IsUint32()) {
+    THROW_ERR_INVALID_ARG_TYPE(isolate, "(capacity: number, maxAge: number)");
+    return;
+  }
+
+  size_t capacity = args[0].As<v8::Uint32>()->Value();
+  if (capacity > ChecksumCache::kMaxCapacity) {
+    THROW_ERR_OUT_OF_RANGE(isolate, "capacity must not exceed 16777216");
+    return;
+  }
+
+  Environment::GetCurrent(args)->checksum_cache().Reconfigure(capacity, args[1].As<v8::Uint32>()->Value());
+}
+
+// getChecksumCacheStats(reset?: boolean) -> { hits, misses, evictions, size, capacity, maxAge, frame }
+static void GetChecksumCacheStats(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Local<Context> context = isolate->GetCurrentContext();
+  ChecksumCache& cache = Environment::GetCurrent(args)->checksum_cache();
+  ChecksumCache::Stats stats = cache.stats();
+
+  Local<Object> result = Object::New(isolate);
+  auto set = [&](const char* name, double value) {
+    result->Set(context, OneByteString(isolate, name), Number::New(isolate, value)).Check();
+  };
+  set("hits", static_cast<double>(stats.hits));
+  set("misses", static_cast<double>(stats.misses));
+  set("evictions", static_cast<double>(stats.evictions));
+  set("size", static_cast<double>(stats.size));
+  set("capacity", static_cast<double>(stats.capacity));
+  set("maxAge", stats.max_age);
+  set("frame", stats.frame);
+
+  if (args[0]->IsTrue()) {
+    cache.ResetStats();
+  }
+
+  args.GetReturnValue().Set(result);
 }
 
 // readMemoryInto(address: BigInt, buffer: Uint8Array) -> void
@@ -208,6 +231,778 @@ static void ReadMemoryInto(const FunctionCallbackInfo<Value>& args) {
   }
 }
 
+template <typename T>
+static T* ViewData(Local<v8::ArrayBufferView> view) {
+  return reinterpret_cast<T*>(static_cast<uint8_t*>(view->Buffer()->Data()) + view->ByteOffset());
+}
+
+// Returns true if the chunk differs. Compares 64 bytes per iteration and falls back to memcmp for the tail.
+static bool ChunkDiffers(const uint8_t* a, const uint8_t* b, size_t size) {
+  size_t i = 0;
+  for (; i + 64 <= size; i += 64) {
+    __m128i d0 = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+                               _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+    __m128i d1 = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i + 16)),
+                               _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i + 16)));
+    __m128i d2 = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i + 32)),
+                               _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i + 32)));
+    __m128i d3 = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i + 48)),
+                               _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i + 48)));
+    __m128i acc = _mm_or_si128(_mm_or_si128(d0, d1), _mm_or_si128(d2, d3));
+    if (!_mm_testz_si128(acc, acc)) return true;
+  }
+  for (; i + 16 <= size; i += 16) {
+    __m128i d = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)),
+                              _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i)));
+    if (!_mm_testz_si128(d, d)) return true;
+  }
+  return i < size && std::memcmp(a + i, b + i, size - i) != 0;
+}
+
+// readMemoryDiff(address: BigInt, buffer: Uint8Array, granularity?: number) -> Uint32Array
+// buffer holds the previous copy of the region. The region is compared against it in granularity-byte chunks
+// (power of two, 16..65536, default 64 = one cache line); only changed chunks are copied into buffer. Returns
+// the changed byte ranges as [start, end) pairs trimmed to the differing bytes, empty when nothing moved.
+static void ReadMemoryDiff(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+
+  if (!args[0]->IsBigInt() || !args[1]->IsUint8Array()) {
+    THROW_ERR_INVALID_ARG_TYPE(isolate, "(BigInt, Uint8Array)");
+    return;
+  }
+
+  size_t granularity = 64;
+  if (args.Length() > 2 && args[2]->IsUint32()) {
+    granularity = args[2].As<v8::Uint32>()->Value();
+    if (granularity < 16 || granularity > 65536 || (granularity & (granularity - 1)) != 0) {
+      THROW_ERR_OUT_OF_RANGE(isolate, "granularity must be a power of two between 16 and 65536");
+      return;
+    }
+  }
+
+  uint64_t address = args[0].As<BigInt>()->Uint64Value();
+  Local<Uint8Array> buffer = args[1].As<Uint8Array>();
+  size_t size = buffer->ByteLength();
+  uint8_t* previous = ViewData<uint8_t>(buffer);
+
+  if (read_buf_.size() < size) read_buf_.resize(size);
+  const uint8_t* current = read_buf_.data();
+  if (!SafeMemcpy(read_buf_.data(), reinterpret_cast<void*>(address), size)) {
+    isolate->ThrowError("Access violation reading memory");
+    return;
+  }
+
+  std::vector<uint32_t> ranges;
+  for (size_t start = 0; start < size; start += granularity) {
+    size_t length = std::min(granularity, size - start);
+    if (!ChunkDiffers(current + start, previous + start, length)) continue;
+
+    // Narrow the range to the bytes that actually differ so callers can map it to elements precisely
+    size_t first = start;
+    while (current[first] == previous[first]) first++;
+    size_t last = start + length - 1;
+    while (current[last] == previous[last]) last--;
+
+    std::memcpy(previous + start, current + start, length);
+    if (!ranges.empty() && ranges.back() == first) {
+      ranges.back() = static_cast<uint32_t>(last + 1);
+    } else {
+      ranges.push_back(static_cast<uint32_t>(first));
+      ranges.push_back(static_cast<uint32_t>(last + 1));
+    }
+  }
+
+  Local<v8::ArrayBuffer> ab = v8::ArrayBuffer::New(isolate, ranges.size() * sizeof(uint32_t));
+  if (!ranges.empty()) std::memcpy(ab->Data(), ranges.data(), ranges.size() * sizeof(uint32_t));
+  args.GetReturnValue().Set(v8::Uint32Array::New(ab, 0, ranges.size()));
+}
+
+// readMemoryBatch(addresses: BigUint64Array, layout: Uint32Array, dest: Uint8Array, status?: Uint8Array,
+//                 unchanged?: Uint8Array) -> Uint8Array
+// layout holds one (size, destOffset) pair per address. Every entry is copied independently so a fault only
+// affects its own slot (which is zeroed); bit i of the returned bitmap is set when entry i was read. Given
+// unchanged, every entry read is checked against and stored in the checksum cache like readMemoryIfChanged
+// does, and bit i of unchanged is set when entry i matched its last read.
+static void ReadMemoryBatch(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+
+  if (!args[0]->IsBigUint64Array() || !args[1]->IsUint32Array() || !args[2]->IsUint8Array()) {
+    THROW_ERR_INVALID_ARG_TYPE(isolate, "(BigUint64Array, Uint32Array, Uint8Array)");
+    return;
+  }
+
+  Local<v8::BigUint64Array> addresses = args[0].As<v8::BigUint64Array>();
+  Local<v8::Uint32Array> layout = args[1].As<v8::Uint32Array>();
+  Local<Uint8Array> dest = args[2].As<Uint8Array>();
+
+  size_t count = addresses->Length();
+  if (layout->Length() < count * 2) {
+    THROW_ERR_OUT_OF_RANGE(isolate, "layout must hold a (size, offset) pair per address");
+    return;
+  }
+
+  size_t status_size = (count + 7) / 8;
+  Local<Uint8Array> status;
+  if (args.Length() > 3 && args[3]->IsUint8Array() && args[3].As<Uint8Array>()->Length() >= status_size) {
+    status = args[3].As<Uint8Array>();
+  } else {
+    Local<v8::ArrayBuffer> ab = v8::ArrayBuffer::New(isolate, status_size);
+    status = Uint8Array::New(ab, 0, status_size);
+  }
+  ChecksumCache* cache = nullptr;
+  uint8_t* unchanged_bits = nullptr;
+  if (args.Length() > 4 && args[4]->IsUint8Array()) {
+    if (args[4].As<Uint8Array>()->Length() < status_size) {
+      THROW_ERR_OUT_OF_RANGE(isolate, "unchanged must hold a bit per address");
+      return;
+    }
+    cache = &Environment::GetCurrent(args)->checksum_cache();
+    unchanged_bits = ViewData<uint8_t>(args[4].As<Uint8Array>());
+    std::memset(unchanged_bits, 0, status_size);
+  }
+
+  const uint64_t* addrs = ViewData<const uint64_t>(addresses);
+  const uint32_t* entries = ViewData<const uint32_t>(layout);
+  uint8_t* dst = ViewData<uint8_t>(dest);
+  uint8_t* bits = ViewData<uint8_t>(status);
+  size_t dst_size = dest->ByteLength();
+
+  std::memset(bits, 0, status_size);
+  for (size_t i = 0; i < count; i++) {
+    size_t size = entries[i * 2];
+    size_t offset = entries[i * 2 + 1];
+    if (offset > dst_size || size > dst_size - offset) continue;
+
+    if (SafeMemcpy(dst + offset, reinterpret_cast<void*>(addrs[i]), size)) {
+      bits[i >> 3] |= static_cast<uint8_t>(1u << (i & 7));
+      // Regions of 8 bytes or less are never cached, see ReadMemoryIfChanged.
+      if (cache && size > 8 && cache->Update(addrs[i], static_cast<uint32_t>(size), Crc32Hash(dst + offset, size))) {
+        unchanged_bits[i >> 3] |= static_cast<uint8_t>(1u << (i & 7));
+      }
+    } else {
+      std::memset(dst + offset, 0, size);
+    }
+  }
+
+  args.GetReturnValue().Set(status);
+}
+
+// Upper bound on nodes a single walk may return, regardless of the caller's maxCount.
+static constexpr size_t kMaxWalkNodes = 1 << 22;
+// Bucket entries wider than a page are not an array of chain heads.
+static constexpr size_t kMaxBucketStride = 4096;
+// The largest single read the other readers accept, whose sizes are Uint32.
+static constexpr size_t kMaxReadSize = UINT32_MAX;
+
+// Rejects null, low (first 64 KiB) and non-canonical user-mode addresses before they are dereferenced.
+static inline bool IsPlausiblePointer(uint64_t address) {
+  return address >= 0x10000 && address <= 0x00007FFFFFFFFFFFull;
+}
+
+static inline bool SafeReadPointer(uint64_t address, uint64_t* out) {
+  return IsPlausiblePointer(address) && SafeMemcpy(out, reinterpret_cast<void*>(address), sizeof(*out));
+}
+
+static Local<v8::BigUint64Array> NewAddressArray(Isolate* isolate, const std::vector<uint64_t>& nodes) {
+  size_t byte_length = nodes.size() * sizeof(uint64_t);
+  auto backing_store = v8::ArrayBuffer::NewBackingStore(isolate, byte_length);
+  if (byte_length > 0) std::memcpy(backing_store->Data(), nodes.data(), byte_length);
+  Local<v8::ArrayBuffer> ab = v8::ArrayBuffer::New(isolate, std::move(backing_store));
+  return v8::BigUint64Array::New(ab, 0, nodes.size());
+}
+
+// Collects nodes reachable through next pointers, stopping at null, an implausible or unreadable pointer,
+// a node already visited by this walk, or a broken back link when prev_offset is given.
+static void WalkChain(uint64_t node,
+                      uint32_t next_offset,
+                      int64_t prev_offset,
+                      size_t max_count,
+                      std::unordered_set<uint64_t>* visited,
+                      std::vector<uint64_t>* out) {
+  while (out->size() < max_count && IsPlausiblePointer(node) && visited->insert(node).second) {
+    out->push_back(node);
+
+    uint64_t next = 0;
+    if (!SafeReadPointer(node + next_offset, &next)) return;
+
+    if (prev_offset >= 0 && IsPlausiblePointer(next)) {
+      uint64_t back = 0;
+      if (!SafeReadPointer(next + prev_offset, &back) || back != node) return;
+    }
+    node = next;
+  }
+}
+
+// resolvePointerChain(base: BigInt, offsets: BigInt64Array) -> BigUint64Array
+// Follows [base + o0], [[base + o0] + o1], ... and returns the pointer read at every hop. The result is shorter
+// than offsets if a hop faults, reads an implausible pointer or revisits an address.
+static void ResolvePointerChain(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+
+  if (!args[0]->IsBigInt() || !args[1]->IsBigInt64Array()) {
+    THROW_ERR_INVALID_ARG_TYPE(isolate, "(BigInt, BigInt64Array)");
+    return;
+  }
+
+  uint64_t address = args[0].As<BigInt>()->Uint64Value();
+  Local<v8::BigInt64Array> offsets = args[1].As<v8::BigInt64Array>();
+  const int64_t* hops = ViewData<const int64_t>(offsets);
+  size_t count = offsets->Length();
+
+  std::vector<uint64_t> nodes;
+  nodes.reserve(count);
+  std::unordered_set<uint64_t> visited;
+  for (size_t i = 0; i < count; i++) {
+    uint64_t next = 0;
+    if (!SafeReadPointer(address + static_cast<uint64_t>(hops[i]), &next)) break;
+    if (!IsPlausiblePointer(next) || !visited.insert(next).second) break;
+    nodes.push_back(next);
+    address = next;
+  }
+
+  args.GetReturnValue().Set(NewAddressArray(isolate, nodes));
+}
+
+// walkList(head: BigInt, nextOffset: number, maxCount: number, prevOffset?: number) -> BigUint64Array
+// Walks a singly linked list from head. With prevOffset the list is treated as doubly linked and the walk
+// stops at the first node whose successor does not point back at it.
+static void WalkList(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+
+  if (!args[0]->IsBigInt() || !args[1]->IsUint32() || !args[2]->IsUint32()) {
+    THROW_ERR_INVALID_ARG_TYPE(isolate, "(BigInt, number, number)");
+    return;
+  }
+
+  uint64_t head = args[0].As<BigInt>()->Uint64Value();
+  uint32_t next_offset = args[1].As<v8::Uint32>()->Value();
+  size_t max_count = std::min<size_t>(args[2].As<v8::Uint32>()->Value(), kMaxWalkNodes);
+  int64_t prev_offset = args.Length() > 3 && args[3]->IsUint32() ? args[3].As<v8::Uint32>()->Value() : -1;
+
+  std::vector<uint64_t> nodes;
+  nodes.reserve(std::min<size_t>(max_count, 1024));
+  std::unordered_set<uint64_t> visited;
+  WalkChain(head, next_offset, prev_offset, max_count, &visited, &nodes);
+
+  args.GetReturnValue().Set(NewAddressArray(isolate, nodes));
+}
+
+// walkHashBuckets(buckets: BigInt, bucketCount: number, nextOffset: number, maxCount: number,
+//                 bucketStride?: number) -> BigUint64Array
+// Walks an open-hash table: an array of bucketCount chain heads, bucketStride bytes apart (default 8), each
+// chained through nextOffset. Nodes shared between buckets are only reported once.
+static void WalkHashBuckets(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+
+  if (!args[0]->IsBigInt() || !args[1]->IsUint32() || !args[2]->IsUint32() || !args[3]->IsUint32()) {
+    THROW_ERR_INVALID_ARG_TYPE(isolate, "(BigInt, number, number, number)");
+    return;
+  }
+
+  uint64_t buckets = args[0].As<BigInt>()->Uint64Value();
+  size_t bucket_count = args[1].As<v8::Uint32>()->Value();
+  uint32_t next_offset = args[2].As<v8::Uint32>()->Value();
+  size_t max_count = std::min<size_t>(args[3].As<v8::Uint32>()->Value(), kMaxWalkNodes);
+  size_t stride = args.Length() > 4 && args[4]->IsUint32() ? args[4].As<v8::Uint32>()->Value() : sizeof(uint64_t);
+
+  if (bucket_count > kMaxWalkNodes || stride < sizeof(uint64_t) || stride > kMaxBucketStride) {
+    THROW_ERR_OUT_OF_RANGE(isolate, "bucketStride must be between 8 and 4096 and bucketCount at most 4194304");
+    return;
+  }
+  // Checked before the bucket array is staged, so an oversized table throws instead of failing to allocate.
+  size_t table_size = bucket_count * stride;
+  if (table_size > kMaxReadSize) {
+    THROW_ERR_OUT_OF_RANGE(isolate, "bucketCount * bucketStride must not exceed 4294967295 bytes");
+    return;
+  }
+
+  std::vector<uint64_t> nodes;
+  if (!IsPlausiblePointer(buckets) || bucket_count == 0) {
+    args.GetReturnValue().Set(NewAddressArray(isolate, nodes));
+    return;
+  }
+
+  // Copy the whole bucket array in one go instead of faulting through it one head at a time.
+  if (read_buf_.size() < table_size) read_buf_.resize(table_size);
+  if (!SafeMemcpy(read_buf_.data(), reinterpret_cast<void*>(buckets), table_size)) {
+    isolate->ThrowError("Access violation reading memory");
+    return;
+  }
+  std::vector<uint64_t> heads(bucket_count);
+  for (size_t i = 0; i < bucket_count; i++) {
+    std::memcpy(&heads[i], read_buf_.data() + i * stride, sizeof(uint64_t));
+  }
+
+  nodes.reserve(std::min<size_t>(max_count, 1024));
+  std::unordered_set<uint64_t> visited;
+  for (size_t i = 0; i < bucket_count && nodes.size() < max_count; i++) {
+    WalkChain(heads[i], next_offset, -1, max_count, &visited, &nodes);
+  }
+
+  args.GetReturnValue().Set(NewAddressArray(isolate, nodes));
+}
+
+template <size_t N>
+static void GatherColumn(const uint8_t* src, size_t stride, size_t count, uint8_t* dst) {
+  for (size_t i = 0; i < count; i++) {
+    std::memcpy(dst + i * N, src + i * stride, N);
+  }
+}
+
+// decodeColumns(source: BigUint64Array | BigInt, count: number, objectSize: number, layout: Uint32Array,
+//               columns: ArrayBufferView[]) -> Uint8Array
+// Reads count objects, either scattered (one address each) or contiguous from a base address, and transposes
+// them into one typed array per field. layout holds an (offset, elementSize) pair per column. Objects that
+// fault decode as zero and have their bit cleared in the returned bitmap.
+static void DecodeColumns(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Local<Context> context = isolate->GetCurrentContext();
+
+  bool contiguous = args[0]->IsBigInt();
+  if ((!contiguous && !args[0]->IsBigUint64Array()) || !args[1]->IsUint32() || !args[2]->IsUint32() ||
+      !args[3]->IsUint32Array() || !args[4]->IsArray()) {
+    THROW_ERR_INVALID_ARG_TYPE(isolate, "(BigUint64Array | BigInt, number, number, Uint32Array, Array)");
+    return;
+  }
+
+  size_t count = args[1].As<v8::Uint32>()->Value();
+  size_t object_size = args[2].As<v8::Uint32>()->Value();
+  Local<v8::Uint32Array> layout = args[3].As<v8::Uint32Array>();
+  Local<Array> columns = args[4].As<Array>();
+  size_t column_count = layout->Length() / 2;
+  const uint32_t* entries = ViewData<const uint32_t>(layout);
+
+  if (!contiguous && args[0].As<v8::BigUint64Array>()->Length() < count) {
+    THROW_ERR_OUT_OF_RANGE(isolate, "fewer addresses than count");
+    return;
+  }
+  if (columns->Length() < column_count) {
+    THROW_ERR_OUT_OF_RANGE(isolate, "one column is required per layout entry");
+    return;
+  }
+  // Checked before the objects are staged, so an oversized read throws instead of failing to allocate.
+  size_t total_size = count * object_size;
+  if (total_size > kMaxReadSize) {
+    THROW_ERR_OUT_OF_RANGE(isolate, "count * objectSize must not exceed 4294967295 bytes");
+    return;
+  }
+
+  // Validate every column before touching memory so a bad call never writes a partial result.
+  std::vector<uint8_t*> outputs(column_count);
+  for (size_t c = 0; c < column_count; c++) {
+    // Widened so offset + size cannot wrap past the object size check.
+    uint64_t offset = entries[c * 2];
+    uint64_t size = entries[c * 2 + 1];
+    Local<Value> column;
+    if (!columns->Get(context, static_cast<uint32_t>(c)).ToLocal(&column) || !column->IsArrayBufferView()) {
+      THROW_ERR_INVALID_ARG_TYPE(isolate, "columns must be typed arrays");
+      return;
+    }
+    Local<v8::ArrayBufferView> view = column.As<v8::ArrayBufferView>();
+    if ((size != 1 && size != 2 && size != 4 && size != 8) || offset + size > object_size ||
+        view->ByteLength() < count * size) {
+      THROW_ERR_OUT_OF_RANGE(isolate, "column does not fit its layout entry");
+      return;
+    }
+    outputs[c] = ViewData<uint8_t>(view);
+  }
+
+  size_t status_size = (count + 7) / 8;
+  Local<v8::ArrayBuffer> status_ab = v8::ArrayBuffer::New(isolate, status_size);
+  uint8_t* bits = static_cast<uint8_t*>(status_ab->Data());
+
+  // Stage all objects back to back, then transpose field by field.
+  if (read_buf_.size() < total_size) read_buf_.resize(total_size);
+  uint8_t* stage = read_buf_.data();
+
+  if (contiguous) {
+    uint64_t base = args[0].As<BigInt>()->Uint64Value();
+    bool ok = SafeMemcpy(stage, reinterpret_cast<void*>(base), total_size);
+    if (!ok) std::memset(stage, 0, total_size);
+    std::memset(bits, ok ? 0xFF : 0, status_size);
+  } else {
+    const uint64_t* addrs = ViewData<const uint64_t>(args[0].As<v8::BigUint64Array>());
+    for (size_t i = 0; i < count; i++) {
+      uint8_t* slot = stage + i * object_size;
+      if (SafeMemcpy(slot, reinterpret_cast<void*>(addrs[i]), object_size)) {
+        bits[i >> 3] |= static_cast<uint8_t>(1u << (i & 7));
+      } else {
+        std::memset(slot, 0, object_size);
+      }
+    }
+  }
+
+  for (size_t c = 0; c < column_count; c++) {
+    const uint8_t* src = stage + entries[c * 2];
+    switch (entries[c * 2 + 1]) {
+      case 1:
+        GatherColumn<1>(src, object_size, count, outputs[c]);
+        break;
+      case 2:
+        GatherColumn<2>(src, object_size, count, outputs[c]);
+        break;
+      case 4:
+        GatherColumn<4>(src, object_size, count, outputs[c]);
+        break;
+      case 8:
+        GatherColumn<8>(src, object_size, count, outputs[c]);
+        break;
+    }
+  }
+
+  args.GetReturnValue().Set(Uint8Array::New(status_ab, 0, status_size));
+}
+
+// Slices are this large so the threadpool can balance uneven regions; a slice also reads width - 1 bytes
+// past its end so matches straddling two slices are found by the first one.
+static constexpr size_t kScanSliceSize = 1 << 20;
+static constexpr size_t kMaxScanWorkers = 4;
+static constexpr size_t kMaxScanResults = 1 << 26;
+
+// Work items a scan queues: one thread short of the pool, as libuv sizes it from UV_THREADPOOL_SIZE (default 4,
+// at most 1024), so fs requests and code cache writes keep a thread while a scan runs. At least one.
+static size_t ScanWorkerCount() {
+  static const size_t count = [] {
+    size_t pool_size = 4;
+    char value[16];
+    size_t length = sizeof(value);
+    if (uv_os_getenv("UV_THREADPOOL_SIZE", value, &length) == 0) {
+      pool_size = std::clamp<size_t>(std::strtoul(value, nullptr, 10), 1, 1024);
+    }
+    return std::clamp<size_t>(pool_size - 1, 1, kMaxScanWorkers);
+  }();
+  return count;
+}
+
+// State for one scan() call, shared by every threadpool request it queues.
+struct ScanJob {
+  // First scan: [begin, end) is the address range the slice owns and limit the end of what it reads.
+  // Next scan: [begin, end) indexes into previous.
+  struct Slice {
+    uint64_t begin;
+    uint64_t end;
+    uint64_t limit;
+    std::vector<uint64_t> hits;
+    std::vector<uint8_t> values;
+  };
+
+  Environment* env;
+  v8::Global<v8::Promise::Resolver> resolver;
+  ScanSpec spec;
+  size_t max_hits = 0;
+  bool next_scan = false;
+  std::vector<uint64_t> previous;
+  std::vector<uint8_t> previous_values;
+  std::vector<Slice> slices;
+  std::vector<uv_work_t> workers;
+  size_t pending = 0;
+  std::atomic<size_t> next_slice{0};
+  std::atomic<size_t> hit_count{0};
+  std::atomic<bool> truncated{false};
+};
+
+static bool IsScannable(const MEMORY_BASIC_INFORMATION& mbi, bool writable_only) {
+  if (mbi.State != MEM_COMMIT || (mbi.Protect & (PAGE_GUARD | PAGE_NOACCESS)) != 0) return false;
+  constexpr DWORD kWritable = PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+  constexpr DWORD kReadable = kWritable | PAGE_READONLY | PAGE_EXECUTE_READ;
+  return (mbi.Protect & (writable_only ? kWritable : kReadable)) != 0;
+}
+
+// Enumerates committed, readable memory in [start, end) once and cuts it into slices. Adjacent regions are
+// merged first so a match spanning two allocations is still found.
+static void CollectScanSlices(uint64_t start, uint64_t end, bool writable_only, size_t width, ScanJob* job) {
+  std::vector<std::pair<uint64_t, uint64_t>> regions;
+  MEMORY_BASIC_INFORMATION mbi;
+  uint64_t address = start;
+  while (address < end && VirtualQuery(reinterpret_cast<void*>(address), &mbi, sizeof(mbi)) == sizeof(mbi)) {
+    uint64_t region_base = reinterpret_cast<uint64_t>(mbi.BaseAddress);
+    uint64_t region_end = region_base + mbi.RegionSize;
+    if (IsScannable(mbi, writable_only)) {
+      uint64_t lo = std::max(region_base, start);
+      uint64_t hi = std::min(region_end, end);
+      if (!regions.empty() && regions.back().second == lo) {
+        regions.back().second = hi;
+      } else {
+        regions.emplace_back(lo, hi);
+      }
+    }
+    if (region_end <= address) break;
+    address = region_end;
+  }
+
+  for (const auto& [lo, hi] : regions) {
+    for (uint64_t begin = lo; begin < hi; begin += kScanSliceSize) {
+      uint64_t slice_end = std::min<uint64_t>(begin + kScanSliceSize, hi);
+      job->slices.push_back({begin, slice_end, std::min<uint64_t>(slice_end + width - 1, hi), {}, {}});
+    }
+  }
+}
+
+static void ScanRegionSlice(ScanJob* job, ScanJob::Slice* slice, size_t width) {
+  size_t size = static_cast<size_t>(slice->limit - slice->begin);
+  if (size < width) return;
+  if (read_buf_.size() < size) read_buf_.resize(size);
+  // Regions can be released while the scan runs; such slices are simply skipped.
+  if (!SafeMemcpy(read_buf_.data(), reinterpret_cast<void*>(slice->begin), size)) return;
+
+  size_t used = job->hit_count.load(std::memory_order_relaxed);
+  if (used >= job->max_hits) {
+    job->truncated = true;
+    return;
+  }
+  if (!ScanBuffer(job->spec, read_buf_.data(), size, slice->begin, job->max_hits - used, &slice->hits)) {
+    job->truncated = true;
+  }
+  while (!slice->hits.empty() && slice->hits.back() >= slice->end) slice->hits.pop_back();
+
+  slice->values.resize(slice->hits.size() * width);
+  for (size_t i = 0; i < slice->hits.size(); i++) {
+    std::memcpy(slice->values.data() + i * width, read_buf_.data() + (slice->hits[i] - slice->begin), width);
+  }
+  job->hit_count.fetch_add(slice->hits.size(), std::memory_order_relaxed);
+}
+
+static void ScanPreviousSlice(ScanJob* job, ScanJob::Slice* slice, size_t width) {
+  uint8_t current[256];
+  const uint8_t* previous_values = job->previous_values.empty() ? nullptr : job->previous_values.data();
+  for (uint64_t i = slice->begin; i < slice->end; i++) {
+    uint64_t address = job->previous[i];
+    if (!SafeMemcpy(current, reinterpret_cast<void*>(address), width)) continue;
+    if (!MatchesNext(job->spec, current, previous_values ? previous_values + i * width : nullptr)) continue;
+    slice->hits.push_back(address);
+    slice->values.insert(slice->values.end(), current, current + width);
+  }
+  job->hit_count.fetch_add(slice->hits.size(), std::memory_order_relaxed);
+}
+
+static void RunScanWorker(uv_work_t* req) {
+  ScanJob* job = static_cast<ScanJob*>(req->data);
+  size_t width = job->spec.width();
+  for (;;) {
+    size_t index = job->next_slice.fetch_add(1, std::memory_order_relaxed);
+    if (index >= job->slices.size() || job->truncated) break;
+    if (job->next_scan) {
+      ScanPreviousSlice(job, &job->slices[index], width);
+    } else {
+      ScanRegionSlice(job, &job->slices[index], width);
+    }
+  }
+}
+
+// Concatenates slice results in address order into { hits: BigUint64Array, values: Uint8Array, truncated }.
+static Local<Object> ScanResult(Isolate* isolate, Local<Context> context, ScanJob* job) {
+  size_t width = job->spec.width();
+  size_t total = 0;
+  for (const ScanJob::Slice& slice : job->slices) total += slice.hits.size();
+  if (total > job->max_hits) {
+    total = job->max_hits;
+    job->truncated = true;
+  }
+
+  Local<v8::ArrayBuffer> hits_ab = v8::ArrayBuffer::New(isolate, total * sizeof(uint64_t));
+  Local<v8::ArrayBuffer> values_ab = v8::ArrayBuffer::New(isolate, total * width);
+  uint64_t* hits = static_cast<uint64_t*>(hits_ab->Data());
+  uint8_t* values = static_cast<uint8_t*>(values_ab->Data());
+  size_t n = 0;
+  for (const ScanJob::Slice& slice : job->slices) {
+    size_t take = std::min(slice.hits.size(), total - n);
+    if (take == 0) continue;
+    std::memcpy(hits + n, slice.hits.data(), take * sizeof(uint64_t));
+    std::memcpy(values + n * width, slice.values.data(), take * width);
+    n += take;
+  }
+
+  Local<Object> result = Object::New(isolate);
+  result->Set(context, OneByteString(isolate, "hits"), v8::BigUint64Array::New(hits_ab, 0, total)).Check();
+  result->Set(context, OneByteString(isolate, "values"), Uint8Array::New(values_ab, 0, total * width)).Check();
+  result->Set(context, OneByteString(isolate, "truncated"), v8::Boolean::New(isolate, job->truncated)).Check();
+  return result;
+}
+
+static void FinishScan(ScanJob* job) {
+  Environment* env = job->env;
+  Isolate* isolate = env->isolate();
+  HandleScope handle_scope(isolate);
+  Local<Context> context = env->context();
+  Context::Scope context_scope(context);
+
+  job->resolver.Get(isolate)->Resolve(context, ScanResult(isolate, context, job)).Check();
+  delete job;
+}
+
+static void AfterScanWorker(uv_work_t* req, int status) {
+  ScanJob* job = static_cast<ScanJob*>(req->data);
+  if (--job->pending == 0) {
+    FinishScan(job);
+  }
+}
+
+// scan(spec: { type, compare, value, epsilon, pattern, mask, alignment, start, end, writableOnly, maxResults,
+//              previous, previousValues }) -> Promise<{ hits: BigUint64Array, values: Uint8Array, truncated }>
+// type and compare are ScanValueType / ScanCompare ordinals. Without previous, every committed readable region
+// in [start, end) is searched for value; with it, only the previous hits are re-read and filtered by compare,
+// which needs previousValues unless compare is kEqual. values holds the bytes matched at each hit.
+static void Scan(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Local<Context> context = isolate->GetCurrentContext();
+  Environment* env = Environment::GetCurrent(context);
+
+  if (!args[0]->IsObject()) {
+    THROW_ERR_INVALID_ARG_TYPE(isolate, "spec must be an object");
+    return;
+  }
+  Local<Object> spec_obj = args[0].As<Object>();
+  auto get = [&](const char* name) -> Local<Value> {
+    Local<Value> value;
+    if (!spec_obj->Get(context, OneByteString(isolate, name)).ToLocal(&value)) return v8::Undefined(isolate);
+    return value;
+  };
+
+  auto job = std::make_unique<ScanJob>();
+  ScanSpec& spec = job->spec;
+
+  Local<Value> type = get("type");
+  Local<Value> compare = get("compare");
+  if (!type->IsUint32() || type.As<v8::Uint32>()->Value() > 3 || !compare->IsUint32() ||
+      compare.As<v8::Uint32>()->Value() > 4) {
+    THROW_ERR_INVALID_ARG_VALUE(isolate, "invalid scan type or compare mode");
+    return;
+  }
+  spec.type = static_cast<ScanValueType>(type.As<v8::Uint32>()->Value());
+  spec.compare = static_cast<ScanCompare>(compare.As<v8::Uint32>()->Value());
+
+  Local<Value> value = get("value");
+  if (spec.compare == ScanCompare::kEqual) {
+    switch (spec.type) {
+      case ScanValueType::kInt32:
+        if (!value->IsInt32()) {
+          THROW_ERR_INVALID_ARG_TYPE(isolate, "int32 scan value must be an int32");
+          return;
+        }
+        spec.int_value = value.As<v8::Int32>()->Value();
+        break;
+      case ScanValueType::kFloat:
+        if (!value->IsNumber()) {
+          THROW_ERR_INVALID_ARG_TYPE(isolate, "float scan value must be a number");
+          return;
+        }
+        spec.float_value = static_cast<float>(value.As<Number>()->Value());
+        break;
+      case ScanValueType::kPointer:
+        if (!value->IsBigInt()) {
+          THROW_ERR_INVALID_ARG_TYPE(isolate, "pointer scan value must be a BigInt");
+          return;
+        }
+        spec.pointer_value = value.As<BigInt>()->Uint64Value();
+        break;
+      case ScanValueType::kPattern:
+        break;
+    }
+  }
+
+  Local<Value> epsilon = get("epsilon");
+  if (epsilon->IsNumber()) spec.epsilon = static_cast<float>(epsilon.As<Number>()->Value());
+
+  if (spec.type == ScanValueType::kPattern) {
+    Local<Value> pattern = get("pattern");
+    Local<Value> mask = get("mask");
+    if (!pattern->IsUint8Array() || !mask->IsUint8Array() ||
+        pattern.As<Uint8Array>()->ByteLength() != mask.As<Uint8Array>()->ByteLength()) {
+      THROW_ERR_INVALID_ARG_TYPE(isolate, "pattern and mask must be Uint8Arrays of equal length");
+      return;
+    }
+    size_t length = pattern.As<Uint8Array>()->ByteLength();
+    if (length == 0 || length > 256) {
+      THROW_ERR_OUT_OF_RANGE(isolate, "pattern must be 1..256 bytes");
+      return;
+    }
+    const uint8_t* pattern_data = ViewData<uint8_t>(pattern.As<Uint8Array>());
+    const uint8_t* mask_data = ViewData<uint8_t>(mask.As<Uint8Array>());
+    spec.pattern.assign(pattern_data, pattern_data + length);
+    spec.mask.assign(mask_data, mask_data + length);
+    bool all_wildcards = std::all_of(spec.mask.begin(), spec.mask.end(), [](uint8_t m) { return m == 0; });
+    if (spec.compare == ScanCompare::kEqual && all_wildcards) {
+      THROW_ERR_INVALID_ARG_VALUE(isolate, "pattern must contain at least one fixed byte");
+      return;
+    }
+    if (spec.compare == ScanCompare::kIncreased || spec.compare == ScanCompare::kDecreased) {
+      THROW_ERR_INVALID_ARG_VALUE(isolate, "patterns only support equal, changed and unchanged");
+      return;
+    }
+  }
+
+  Local<Value> alignment = get("alignment");
+  spec.alignment = alignment->IsUint32() ? std::max(1u, alignment.As<v8::Uint32>()->Value()) : 1;
+
+  Local<Value> max_results = get("maxResults");
+  job->max_hits = max_results->IsUint32() ? max_results.As<v8::Uint32>()->Value() : kMaxScanResults;
+  job->max_hits = std::min(job->max_hits, kMaxScanResults);
+
+  size_t width = spec.width();
+  Local<Value> previous = get("previous");
+  if (previous->IsBigUint64Array()) {
+    Local<v8::BigUint64Array> prev = previous.As<v8::BigUint64Array>();
+    const uint64_t* addresses = ViewData<uint64_t>(prev);
+    job->next_scan = true;
+    job->previous.assign(addresses, addresses + prev->Length());
+
+    Local<Value> previous_values = get("previousValues");
+    if (previous_values->IsUint8Array()) {
+      Local<Uint8Array> values = previous_values.As<Uint8Array>();
+      if (values->ByteLength() != job->previous.size() * width) {
+        THROW_ERR_OUT_OF_RANGE(isolate, "previousValues must hold one value per previous hit");
+        return;
+      }
+      job->previous_values.assign(ViewData<uint8_t>(values), ViewData<uint8_t>(values) + values->ByteLength());
+    } else if (spec.compare != ScanCompare::kEqual) {
+      THROW_ERR_INVALID_ARG_VALUE(isolate, "compare needs previousValues");
+      return;
+    }
+
+    for (uint64_t begin = 0; begin < job->previous.size(); begin += kScanSliceSize / 16) {
+      uint64_t end = std::min<uint64_t>(begin + kScanSliceSize / 16, job->previous.size());
+      job->slices.push_back({begin, end, end, {}, {}});
+    }
+  } else {
+    if (spec.compare != ScanCompare::kEqual) {
+      THROW_ERR_INVALID_ARG_VALUE(isolate, "changed/unchanged/increased/decreased need a previous result");
+      return;
+    }
+
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    uint64_t start = reinterpret_cast<uint64_t>(info.lpMinimumApplicationAddress);
+    uint64_t end = reinterpret_cast<uint64_t>(info.lpMaximumApplicationAddress) + 1;
+    Local<Value> start_value = get("start");
+    Local<Value> end_value = get("end");
+    if (start_value->IsBigInt()) start = std::max(start, start_value.As<BigInt>()->Uint64Value());
+    if (end_value->IsBigInt()) end = std::min(end, end_value.As<BigInt>()->Uint64Value());
+
+    Local<Value> writable_only = get("writableOnly");
+    CollectScanSlices(start, end, writable_only->IsTrue(), width, job.get());
+  }
+
+  Local<v8::Promise::Resolver> resolver = v8::Promise::Resolver::New(context).ToLocalChecked();
+  args.GetReturnValue().Set(resolver->GetPromise());
+  job->env = env;
+  job->resolver.Reset(isolate, resolver);
+
+  if (job->slices.empty()) {
+    resolver->Resolve(context, ScanResult(isolate, context, job.get())).Check();
+    return;
+  }
+
+  size_t workers = std::min(job->slices.size(), ScanWorkerCount());
+  job->workers.resize(workers);
+  job->pending = workers;
+  ScanJob* raw = job.release();
+  for (uv_work_t& req : raw->workers) {
+    req.data = raw;
+    int result = uv_queue_work(env->event_loop(), &req, RunScanWorker, AfterScanWorker);
+    CHECK_EQ(result, 0);
+  }
+}
+
 // writeMemory(address: BigInt, data: Uint8Array) -> void
 static void WriteMemory(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
@@ -290,6 +1085,10 @@ static void AcquireGameLock(const FunctionCallbackInfo<Value>& args) {
   if (args.Length() > 0 && args[0]->IsNumber()) {
     timeout_ms = static_cast<int>(args[0]->NumberValue(context).FromMaybe(100));
   }
+  if (env->game_lock() == nullptr) {
+    THROW_ERR_INVALID_STATE(isolate, "no game lock");
+    return;
+  }
 
   bool acquired = env->game_lock()->Acquire(std::chrono::milliseconds(timeout_ms));
   args.GetReturnValue().Set(v8::Boolean::New(isolate, acquired));
@@ -297,19 +1096,239 @@ static void AcquireGameLock(const FunctionCallbackInfo<Value>& args) {
 
 static void ReleaseGameLock(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
+  if (env->game_lock() == nullptr) {
+    THROW_ERR_INVALID_STATE(args.GetIsolate(), "no game lock");
+    return;
+  }
   env->game_lock()->Release();
 }
 
 static void IsGameLockHeld(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Environment* env = Environment::GetCurrent(args);
-  args.GetReturnValue().Set(v8::Boolean::New(isolate, env->game_lock()->IsHeld()));
+  args.GetReturnValue().Set(v8::Boolean::New(isolate, env->game_lock() && env->game_lock()->IsHeld()));
 }
 
 static void IsGameLockOpen(const FunctionCallbackInfo<Value>& args) {
   Isolate* isolate = args.GetIsolate();
   Environment* env = Environment::GetCurrent(args);
-  args.GetReturnValue().Set(v8::Boolean::New(isolate, env->game_lock()->IsOpen()));
+  args.GetReturnValue().Set(v8::Boolean::New(isolate, env->game_lock() && env->game_lock()->IsOpen()));
+}
+
+// requestGameLock(callback: (acquired: boolean) => void) -> number
+// Queues a non-blocking acquire. callback runs on the event loop with true once the game thread has
+// granted the lock to this thread, or with false if the request was cancelled.
+static void RequestGameLock(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Environment* env = Environment::GetCurrent(args);
+
+  if (!args[0]->IsFunction()) {
+    THROW_ERR_INVALID_ARG_TYPE(isolate, "callback must be a function");
+    return;
+  }
+  if (env->game_lock() == nullptr) {
+    THROW_ERR_INVALID_STATE(isolate, "no game lock");
+    return;
+  }
+
+  // Freed by the immediate. If the environment is gone before that, so is the isolate, and the handle
+  // is left alone.
+  auto* callback = new v8::Global<v8::Function>(isolate, args[0].As<v8::Function>());
+  auto immediates = env->threadsafe_immediates();
+  uint32_t package = env->package_watchdog().current_package();
+  auto on_done = [callback, immediates, package](bool acquired) {
+    immediates->Post([callback, acquired, package](Environment* env) {
+      std::unique_ptr<v8::Global<v8::Function>> owned(callback);
+      Isolate* isolate = env->isolate();
+      Local<Context> context = env->context();
+      PackageWatchdog::Scope package_scope(&env->package_watchdog(), package);
+      if (package_scope.stopped()) {
+        // Granted before the watchdog stopped the package; nobody is left to release it.
+        if (acquired) {
+          env->game_lock()->Release();
+        }
+        return;
+      }
+      Local<Value> argv[] = {v8::Boolean::New(isolate, acquired)};
+      TryCatchScope try_catch(isolate);
+      owned->Get(isolate)->Call(context, context->Global(), 1, argv);
+    });
+  };
+  // Tagged with the package so the watchdog can cancel what a stopped package still waits on.
+  uint64_t id = env->game_lock()->AcquireAsync(env, std::move(on_done), package);
+
+  args.GetReturnValue().Set(Number::New(isolate, static_cast<double>(id)));
+}
+
+// cancelGameLockRequest(id: number) -> boolean
+// False if the request was already granted; its callback then still receives true.
+static void CancelGameLockRequest(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Environment* env = Environment::GetCurrent(args);
+
+  if (!args[0]->IsNumber()) {
+    THROW_ERR_INVALID_ARG_TYPE(isolate, "id must be a number");
+    return;
+  }
+  if (env->game_lock() == nullptr) {
+    return;
+  }
+
+  uint64_t id = static_cast<uint64_t>(args[0].As<Number>()->Value());
+  args.GetReturnValue().Set(v8::Boolean::New(isolate, env->game_lock()->CancelAsync(id)));
+}
+
+// setGameLockFrameBudget(microseconds: number) -> void
+// Caps how long a single game lock window may stay open.
+static void SetGameLockFrameBudget(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Environment* env = Environment::GetCurrent(args);
+
+  if (!args[0]->IsUint32()) {
+    THROW_ERR_INVALID_ARG_TYPE(isolate, "microseconds must be a non-negative integer");
+    return;
+  }
+  if (env->game_lock() == nullptr) {
+    THROW_ERR_INVALID_STATE(isolate, "no game lock");
+    return;
+  }
+  env->game_lock()->SetFrameBudget(std::chrono::microseconds(args[0].As<v8::Uint32>()->Value()));
+}
+
+// getGameLockStats(reset?: boolean) -> object | undefined
+// Times in microseconds, utilisation as a fraction of each window spent with the lock held.
+static void GetGameLockStats(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Local<Context> context = isolate->GetCurrentContext();
+  GameLock* game_lock = Environment::GetCurrent(args)->game_lock();
+  if (game_lock == nullptr) {
+    return;
+  }
+  const GameLock::Metrics& metrics = game_lock->metrics();
+
+  Local<Object> result = Object::New(isolate);
+  auto set = [&](const char* name, Local<Value> value) {
+    result->Set(context, OneByteString(isolate, name), value).Check();
+  };
+  auto count = [&](uint64_t value) { return Number::New(isolate, static_cast<double>(value)); };
+  set("windows", count(metrics.windows.load()));
+  set("skippedWindows", count(metrics.skipped_windows.load()));
+  set("closedWithWaiters", count(metrics.closed_with_waiters.load()));
+  set("timeouts", count(metrics.timeout.count()));
+  set("window", count(game_lock->window().count()));
+  set("frameBudget", count(game_lock->frame_budget().count()));
+  set("wait", LatencySummaryObject(context, metrics.wait, 1e-3));
+  set("timeout", LatencySummaryObject(context, metrics.timeout, 1e-3));
+  set("hold", LatencySummaryObject(context, metrics.hold, 1e-3));
+  set("utilisation", LatencySummaryObject(context, metrics.utilisation, 1e-3));
+
+  if (args[0]->IsTrue()) {
+    game_lock->ResetMetrics();
+  }
+
+  args.GetReturnValue().Set(result);
+}
+
+// registerSnapshotRegion(address: BigInt, size: number, chain?: BigInt64Array) -> number
+static void RegisterSnapshotRegion(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+
+  if (!args[0]->IsBigInt() || !args[1]->IsUint32()) {
+    THROW_ERR_INVALID_ARG_TYPE(isolate, "(BigInt, number, BigInt64Array?)");
+    return;
+  }
+  uint32_t size = args[1].As<v8::Uint32>()->Value();
+  if (size == 0) {
+    THROW_ERR_OUT_OF_RANGE(isolate, "size must be positive");
+    return;
+  }
+
+  std::vector<int64_t> chain;
+  if (args.Length() > 2 && args[2]->IsBigInt64Array()) {
+    Local<v8::BigInt64Array> offsets = args[2].As<v8::BigInt64Array>();
+    const int64_t* data = ViewData<int64_t>(offsets);
+    chain.assign(data, data + offsets->Length());
+  }
+
+  SnapshotArena& arena = Environment::GetCurrent(args)->snapshot_arena();
+  uint32_t id = arena.AddRegion(args[0].As<BigInt>()->Uint64Value(), size, std::move(chain));
+  args.GetReturnValue().Set(id);
+}
+
+// unregisterSnapshotRegion(id: number) -> bool
+static void UnregisterSnapshotRegion(const FunctionCallbackInfo<Value>& args) {
+  if (!args[0]->IsUint32()) {
+    THROW_ERR_INVALID_ARG_TYPE(args.GetIsolate(), "region id");
+    return;
+  }
+  bool removed = Environment::GetCurrent(args)->snapshot_arena().RemoveRegion(args[0].As<v8::Uint32>()->Value());
+  args.GetReturnValue().Set(removed);
+}
+
+// clearSnapshotRegions() -> void
+static void ClearSnapshotRegions(const FunctionCallbackInfo<Value>& args) {
+  Environment::GetCurrent(args)->snapshot_arena().Clear();
+}
+
+// captureSnapshot() -> void
+// Only for environments without a game lock; otherwise the game thread captures at the start of each window.
+static void CaptureSnapshot(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  if (env->game_lock() != nullptr) {
+    THROW_ERR_INVALID_STATE(args.GetIsolate(), "snapshots are captured by the game thread");
+    return;
+  }
+  env->snapshot_arena().Capture();
+}
+
+// pinSnapshot() -> number
+// Pins the newest snapshot until unpinSnapshot() and returns its sequence number (0 if none yet).
+static void PinSnapshot(const FunctionCallbackInfo<Value>& args) {
+  uint64_t sequence = Environment::GetCurrent(args)->snapshot_arena().Pin();
+  args.GetReturnValue().Set(static_cast<double>(sequence));
+}
+
+// unpinSnapshot() -> void
+static void UnpinSnapshot(const FunctionCallbackInfo<Value>& args) {
+  Environment::GetCurrent(args)->snapshot_arena().Unpin();
+}
+
+// readSnapshotRegion(id: number, dest: Uint8Array) -> bool
+// Copies the region from the pinned snapshot, pinning the newest one just for this call if none is pinned.
+static void ReadSnapshotRegion(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+
+  if (!args[0]->IsUint32() || !args[1]->IsUint8Array()) {
+    THROW_ERR_INVALID_ARG_TYPE(isolate, "(number, Uint8Array)");
+    return;
+  }
+
+  SnapshotArena& arena = Environment::GetCurrent(args)->snapshot_arena();
+  Local<Uint8Array> dest = args[1].As<Uint8Array>();
+  bool pin = !arena.pinned();
+  if (pin) arena.Pin();
+  bool ok = arena.Read(args[0].As<v8::Uint32>()->Value(), ViewData<uint8_t>(dest), dest->ByteLength());
+  if (pin) arena.Unpin();
+  args.GetReturnValue().Set(ok);
+}
+
+// getSnapshotStats() -> { sequence, captures, skipped, lastCaptureNs, regions, bytes }
+static void GetSnapshotStats(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Local<Context> context = isolate->GetCurrentContext();
+  SnapshotArena::Stats stats = Environment::GetCurrent(args)->snapshot_arena().stats();
+
+  Local<Object> result = Object::New(isolate);
+  auto set = [&](const char* name, double value) {
+    result->Set(context, OneByteString(isolate, name), Number::New(isolate, value)).Check();
+  };
+  set("sequence", static_cast<double>(stats.sequence));
+  set("captures", static_cast<double>(stats.captures));
+  set("skipped", static_cast<double>(stats.skipped));
+  set("lastCaptureNs", static_cast<double>(stats.last_capture_ns));
+  set("regions", static_cast<double>(stats.regions));
+  set("bytes", static_cast<double>(stats.bytes));
+  args.GetReturnValue().Set(result);
 }
 
 static void CreatePerIsolateProperties(IsolateData* isolate_data, Local<ObjectTemplate> target) {
@@ -320,8 +1339,17 @@ static void CreatePerIsolateProperties(IsolateData* isolate_data, Local<ObjectTe
   SetMethod(isolate, target, "readMemoryIfChanged", ReadMemoryIfChanged);
   SetMethod(isolate, target, "readMemoryIntoIfChanged", ReadMemoryIntoIfChanged);
   SetMethod(isolate, target, "readMemoryInto", ReadMemoryInto);
+  SetMethod(isolate, target, "readMemoryBatch", ReadMemoryBatch);
+  SetMethod(isolate, target, "readMemoryDiff", ReadMemoryDiff);
+  SetMethod(isolate, target, "resolvePointerChain", ResolvePointerChain);
+  SetMethod(isolate, target, "walkList", WalkList);
+  SetMethod(isolate, target, "walkHashBuckets", WalkHashBuckets);
+  SetMethod(isolate, target, "decodeColumns", DecodeColumns);
+  SetMethod(isolate, target, "scan", Scan);
   SetMethod(isolate, target, "writeMemory", WriteMemory);
   SetMethod(isolate, target, "clearChecksumCache", ClearChecksumCache);
+  SetMethod(isolate, target, "configureChecksumCache", ConfigureChecksumCache);
+  SetMethod(isolate, target, "getChecksumCacheStats", GetChecksumCacheStats);
 
   SetMethod(isolate, target, "allocateTestMemory", AllocateTestMemory);
   SetMethod(isolate, target, "freeTestMemory", FreeTestMemory);
@@ -332,11 +1360,67 @@ static void CreatePerIsolateProperties(IsolateData* isolate_data, Local<ObjectTe
   SetMethod(isolate, target, "releaseGameLock", ReleaseGameLock);
   SetMethod(isolate, target, "isGameLockHeld", IsGameLockHeld);
   SetMethod(isolate, target, "isGameLockOpen", IsGameLockOpen);
+  SetMethod(isolate, target, "requestGameLock", RequestGameLock);
+  SetMethod(isolate, target, "cancelGameLockRequest", CancelGameLockRequest);
+  SetMethod(isolate, target, "setGameLockFrameBudget", SetGameLockFrameBudget);
+  SetMethod(isolate, target, "getGameLockStats", GetGameLockStats);
+
+  SetMethod(isolate, target, "registerSnapshotRegion", RegisterSnapshotRegion);
+  SetMethod(isolate, target, "unregisterSnapshotRegion", UnregisterSnapshotRegion);
+  SetMethod(isolate, target, "clearSnapshotRegions", ClearSnapshotRegions);
+  SetMethod(isolate, target, "captureSnapshot", CaptureSnapshot);
+  SetMethod(isolate, target, "pinSnapshot", PinSnapshot);
+  SetMethod(isolate, target, "unpinSnapshot", UnpinSnapshot);
+  SetMethod(isolate, target, "readSnapshotRegion", ReadSnapshotRegion);
+  SetMethod(isolate, target, "getSnapshotStats", GetSnapshotStats);
 }
 
 static void CreatePerContextProperties(Local<Object> target, Local<Context> context) {}
 
+static void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(ReadMemory);
+  registry->Register(ReadMemoryFast);
+  registry->Register(ReadMemoryIfChanged);
+  registry->Register(ReadMemoryIntoIfChanged);
+  registry->Register(ReadMemoryInto);
+  registry->Register(ReadMemoryBatch);
+  registry->Register(ReadMemoryDiff);
+  registry->Register(ResolvePointerChain);
+  registry->Register(WalkList);
+  registry->Register(WalkHashBuckets);
+  registry->Register(DecodeColumns);
+  registry->Register(Scan);
+  registry->Register(WriteMemory);
+  registry->Register(ClearChecksumCache);
+  registry->Register(ConfigureChecksumCache);
+  registry->Register(GetChecksumCacheStats);
+
+  registry->Register(AllocateTestMemory);
+  registry->Register(FreeTestMemory);
+  registry->Register(FreeAllTestMemory);
+  registry->Register(HighResolutionTime);
+
+  registry->Register(AcquireGameLock);
+  registry->Register(ReleaseGameLock);
+  registry->Register(IsGameLockHeld);
+  registry->Register(IsGameLockOpen);
+  registry->Register(RequestGameLock);
+  registry->Register(CancelGameLockRequest);
+  registry->Register(SetGameLockFrameBudget);
+  registry->Register(GetGameLockStats);
+
+  registry->Register(RegisterSnapshotRegion);
+  registry->Register(UnregisterSnapshotRegion);
+  registry->Register(ClearSnapshotRegions);
+  registry->Register(CaptureSnapshot);
+  registry->Register(PinSnapshot);
+  registry->Register(UnpinSnapshot);
+  registry->Register(ReadSnapshotRegion);
+  registry->Register(GetSnapshotStats);
+}
+
 NYX_BINDING_PER_ISOLATE_INIT(memory, CreatePerIsolateProperties)
 NYX_BINDING_CONTEXT_AWARE(memory, CreatePerContextProperties)
+NYX_BINDING_EXTERNAL_REFERENCE(memory, RegisterExternalReferences)
 
 }  // namespace nyx
@@ -0,0 +1,397 @@
+#include "nyx/package_watchdog.h"
+
+#include <algorithm>
+
+#include "nyx/env.h"
+#include "nyx/errors.h"
+#include "nyx/external_references.h"
+#include "nyx/game_lock.h"
+#include "nyx/gui/widget_manager.h"
+#include "nyx/nyx.h"
+#include "nyx/nyx_binding.h"
+#include "nyx/timers.h"
+
+namespace nyx {
+
+using v8::Array;
+using v8::Boolean;
+using v8::Context;
+using v8::Function;
+using v8::FunctionCallbackInfo;
+using v8::Isolate;
+using v8::Local;
+using v8::MaybeLocal;
+using v8::Number;
+using v8::Object;
+using v8::ObjectTemplate;
+using v8::Value;
+
+namespace {
+
+uint64_t ElapsedNs(PackageWatchdog::Clock::duration duration) {
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+}
+
+}  // namespace
+
+PackageWatchdog::Scope::Scope(PackageWatchdog* watchdog, uint32_t package)
+    : watchdog_(watchdog), package_(package), outermost_(false), stopped_(false) {
+  PackageStats* stats = watchdog_->Get(package_);
+  if (stats == nullptr) {
+    return;
+  }
+  if (stats->stopped) {
+    stopped_ = true;
+    return;
+  }
+  if (watchdog_->current_ != kNoPackage) {
+    return;
+  }
+
+  outermost_ = true;
+  watchdog_->current_ = package_;
+  start_ = Clock::now();
+  {
+    // Promises created from here on carry the package into their continuations.
+    Isolate* isolate = watchdog_->isolate_;
+    v8::HandleScope handle_scope(isolate);
+    isolate->SetContinuationPreservedEmbedderData(v8::Integer::NewFromUnsigned(isolate, package_));
+  }
+
+  auto deadline = Clock::time_point::max();
+  if (watchdog_->callback_budget_.count() > 0) {
+    deadline = start_ + watchdog_->callback_budget_;
+  }
+  if (watchdog_->frame_budget_.count() > 0) {
+    auto used = std::chrono::nanoseconds(stats->frame_ns);
+    auto left = std::max(std::chrono::nanoseconds(watchdog_->frame_budget_) - used, std::chrono::nanoseconds(0));
+    deadline = std::min(deadline, start_ + std::chrono::duration_cast<Clock::duration>(left));
+  }
+  if (deadline != Clock::time_point::max()) {
+    watchdog_->Arm(deadline);
+  }
+}
+
+PackageWatchdog::Scope::~Scope() {
+  if (!outermost_) {
+    return;
+  }
+
+  uint64_t elapsed = ElapsedNs(Clock::now() - start_);
+  watchdog_->current_ = kNoPackage;
+  bool terminated = watchdog_->Disarm();
+  {
+    Isolate* isolate = watchdog_->isolate_;
+    v8::HandleScope handle_scope(isolate);
+    isolate->SetContinuationPreservedEmbedderData(v8::Undefined(isolate));
+  }
+
+  PackageStats* stats = watchdog_->Get(package_);
+  stats->callbacks++;
+  stats->total_ns += elapsed;
+  stats->frame_ns += elapsed;
+  stats->max_callback_ns = std::max(stats->max_callback_ns, elapsed);
+
+  if (terminated) {
+    watchdog_->Terminated(package_, elapsed);
+  }
+}
+
+PackageWatchdog::MicrotaskScope::MicrotaskScope(PackageWatchdog* watchdog) : watchdog_(watchdog), armed_(false) {
+  if (watchdog_->current_ != kNoPackage || watchdog_->callback_budget_.count() == 0) {
+    return;
+  }
+  armed_ = true;
+  start_ = Clock::now();
+  watchdog_->Arm(start_ + watchdog_->callback_budget_, true);
+}
+
+PackageWatchdog::MicrotaskScope::~MicrotaskScope() {
+  if (!armed_) {
+    return;
+  }
+  bool terminated = watchdog_->Disarm();
+  if (terminated) {
+    // Read under the watchdog's lock by the interrupt, which has run by now.
+    uint32_t culprit;
+    {
+      std::lock_guard<std::mutex> lock(watchdog_->mutex_);
+      culprit = watchdog_->culprit_;
+    }
+    watchdog_->Terminated(culprit, ElapsedNs(Clock::now() - start_));
+  }
+}
+
+PackageWatchdog::PackageWatchdog(Environment* env) : env_(env), isolate_(env->isolate()) {}
+
+PackageWatchdog::~PackageWatchdog() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    exiting_ = true;
+  }
+  cv_.notify_one();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+uint32_t PackageWatchdog::RegisterPackage(const std::string& name) {
+  packages_.push_back(PackageStats{name});
+  return static_cast<uint32_t>(packages_.size());
+}
+
+bool PackageWatchdog::IsStopped(uint32_t package) {
+  PackageStats* stats = Get(package);
+  return stats != nullptr && stats->stopped;
+}
+
+void PackageWatchdog::Configure(std::chrono::microseconds callback_budget, std::chrono::microseconds frame_budget) {
+  callback_budget_ = callback_budget;
+  frame_budget_ = frame_budget;
+}
+
+void PackageWatchdog::FrameStarted() {
+  for (PackageStats& stats : packages_) {
+    stats.last_frame_ns = stats.frame_ns;
+    stats.frame_ns = 0;
+  }
+}
+
+void PackageWatchdog::CancelStoppedPackages() {
+  if (newly_stopped_.empty()) {
+    return;
+  }
+
+  std::vector<uint32_t> stopped;
+  stopped.swap(newly_stopped_);
+  for (uint32_t package : stopped) {
+    env_->timer_registry().CancelPackage(package);
+    if (env_->widget_manager()) {
+      env_->widget_manager()->RemovePackage(package);
+    }
+  }
+}
+
+void PackageWatchdog::ResetStats() {
+  for (PackageStats& stats : packages_) {
+    stats.callbacks = 0;
+    stats.total_ns = 0;
+    stats.max_callback_ns = 0;
+  }
+}
+
+PackageWatchdog::PackageStats* PackageWatchdog::Get(uint32_t package) {
+  if (package == kNoPackage || package > packages_.size()) {
+    return nullptr;
+  }
+  return &packages_[package - 1];
+}
+
+void PackageWatchdog::Arm(Clock::time_point deadline, bool attribute) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    armed_ = true;
+    attribute_ = attribute;
+    interrupt_requested_ = false;
+    fired_ = false;
+    culprit_ = kNoPackage;
+    deadline_ = deadline;
+  }
+  if (!thread_.joinable()) {
+    thread_ = std::thread(&PackageWatchdog::ThreadMain, this);
+  }
+  cv_.notify_one();
+}
+
+bool PackageWatchdog::Disarm() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  bool fired = fired_;
+  armed_ = false;
+  fired_ = false;
+  return fired;
+}
+
+void PackageWatchdog::Terminated(uint32_t package, uint64_t elapsed_ns) {
+  // The terminated code has unwound by now; everything else on this isolate runs on.
+  isolate_->CancelTerminateExecution();
+  if (Get(package) == nullptr) {
+    fprintf(GetStderr(),
+            "Script code not attributed to any package exceeded the callback budget after %.1f ms and was terminated\n",
+            static_cast<double>(elapsed_ns) / 1e6);
+    return;
+  }
+  // Termination skips finally blocks, so a withGameLock or lease the package was inside never released the
+  // lock, and nothing it still waits on may be granted to it.
+  if (GameLock* game_lock = env_->game_lock()) {
+    game_lock->ReleaseIfOwned();
+    game_lock->CancelAsync(env_, package);
+  }
+  if (!IsStopped(package)) {
+    Stop(package, elapsed_ns);
+  }
+}
+
+void PackageWatchdog::Stop(uint32_t package, uint64_t elapsed_ns) {
+  PackageStats* stats = Get(package);
+  stats->stopped = true;
+  newly_stopped_.push_back(package);
+  fprintf(GetStderr(),
+          "Package '%s' exceeded its time budget after %.1f ms and was stopped\n",
+          stats->name.c_str(),
+          static_cast<double>(elapsed_ns) / 1e6);
+}
+
+void PackageWatchdog::ThreadMain() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!exiting_) {
+    if (!armed_ || fired_ || interrupt_requested_) {
+      cv_.wait(lock);
+      continue;
+    }
+    if (Clock::now() < deadline_) {
+      cv_.wait_until(lock, deadline_);
+      continue;
+    }
+    if (attribute_) {
+      // Only the isolate's thread can tell which continuation is running.
+      interrupt_requested_ = true;
+      isolate_->RequestInterrupt(OnDeadlineInterrupt, this);
+      continue;
+    }
+    // Under the lock, so Disarm either sees this or the scope has closed before it happens.
+    fired_ = true;
+    isolate_->TerminateExecution();
+  }
+}
+
+void PackageWatchdog::OnDeadlineInterrupt(Isolate* isolate, void* data) {
+  PackageWatchdog* watchdog = static_cast<PackageWatchdog*>(data);
+  std::lock_guard<std::mutex> lock(watchdog->mutex_);
+  // The checkpoint may have finished before the interrupt ran; then this is someone else's code.
+  if (!watchdog->armed_ || !watchdog->interrupt_requested_ || watchdog->fired_) {
+    return;
+  }
+  v8::HandleScope handle_scope(isolate);
+  Local<Value> tag = isolate->GetContinuationPreservedEmbedderData();
+  watchdog->culprit_ = tag->IsUint32() ? tag.As<v8::Uint32>()->Value() : kNoPackage;
+  watchdog->fired_ = true;
+  isolate->TerminateExecution();
+}
+
+// registerPackage(name: string) -> number
+static void RegisterPackage(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  if (!args[0]->IsString()) {
+    THROW_ERR_INVALID_ARG_TYPE(isolate, "name must be a string");
+    return;
+  }
+  Utf8Value name(isolate, args[0]);
+  uint32_t id = Environment::GetCurrent(args)->package_watchdog().RegisterPackage(name.ToString());
+  args.GetReturnValue().Set(id);
+}
+
+// runInPackage(id: number, fn: () => any) -> any
+// Calls fn charged to the package. Throws if the package is or gets stopped.
+static void RunInPackage(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Local<Context> context = isolate->GetCurrentContext();
+  if (!args[0]->IsUint32() || !args[1]->IsFunction()) {
+    THROW_ERR_INVALID_ARG_TYPE(isolate, "(number, function)");
+    return;
+  }
+  PackageWatchdog& watchdog = Environment::GetCurrent(args)->package_watchdog();
+  uint32_t package = args[0].As<v8::Uint32>()->Value();
+
+  MaybeLocal<Value> result;
+  {
+    PackageWatchdog::Scope scope(&watchdog, package);
+    if (!scope.stopped()) {
+      result = args[1].As<Function>()->Call(context, v8::Undefined(isolate), 0, nullptr);
+    }
+  }
+
+  Local<Value> value;
+  if (result.ToLocal(&value)) {
+    args.GetReturnValue().Set(value);
+  } else if (watchdog.IsStopped(package)) {
+    THROW_ERR_INVALID_STATE(isolate, "package stopped by the watchdog");
+  }
+}
+
+// setBudgets(callbackMicroseconds: number, frameMicroseconds: number) -> void
+// 0 disables a budget.
+static void SetBudgets(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  if (!args[0]->IsUint32() || !args[1]->IsUint32()) {
+    THROW_ERR_INVALID_ARG_TYPE(isolate, "microseconds must be non-negative integers");
+    return;
+  }
+  Environment::GetCurrent(args)->package_watchdog().Configure(
+      std::chrono::microseconds(args[0].As<v8::Uint32>()->Value()),
+      std::chrono::microseconds(args[1].As<v8::Uint32>()->Value()));
+}
+
+// getPackageStats(reset?: boolean) -> object
+// Times in microseconds.
+static void GetPackageStats(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Local<Context> context = isolate->GetCurrentContext();
+  PackageWatchdog& watchdog = Environment::GetCurrent(args)->package_watchdog();
+
+  auto us = [&](uint64_t ns) { return Number::New(isolate, static_cast<double>(ns) / 1e3); };
+  auto count = [&](uint64_t value) { return Number::New(isolate, static_cast<double>(value)); };
+
+  Local<Array> packages = Array::New(isolate, static_cast<int>(watchdog.packages().size()));
+  uint32_t index = 0;
+  for (const PackageWatchdog::PackageStats& stats : watchdog.packages()) {
+    Local<Object> entry = Object::New(isolate);
+    auto set = [&](const char* name, Local<Value> value) {
+      entry->Set(context, OneByteString(isolate, name), value).Check();
+    };
+    set("name", OneByteString(isolate, stats.name));
+    set("callbacks", count(stats.callbacks));
+    set("total", us(stats.total_ns));
+    set("frame", us(stats.last_frame_ns));
+    set("maxCallback", us(stats.max_callback_ns));
+    set("stopped", Boolean::New(isolate, stats.stopped));
+    packages->Set(context, index++, entry).Check();
+  }
+
+  Local<Object> result = Object::New(isolate);
+  auto set = [&](const char* name, Local<Value> value) {
+    result->Set(context, OneByteString(isolate, name), value).Check();
+  };
+  set("callbackBudget", count(watchdog.callback_budget().count()));
+  set("frameBudget", count(watchdog.frame_budget().count()));
+  set("packages", packages);
+
+  if (args[0]->IsTrue()) {
+    watchdog.ResetStats();
+  }
+
+  args.GetReturnValue().Set(result);
+}
+
+static void CreatePerIsolateProperties(IsolateData* isolate_data, Local<ObjectTemplate> target) {
+  Isolate* isolate = isolate_data->isolate();
+
+  SetMethod(isolate, target, "registerPackage", RegisterPackage);
+  SetMethod(isolate, target, "runInPackage", RunInPackage);
+  SetMethod(isolate, target, "setBudgets", SetBudgets);
+  SetMethod(isolate, target, "getPackageStats", GetPackageStats);
+}
+
+static void CreatePerContextProperties(Local<Object> target, Local<Context> context) {}
+
+static void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(RegisterPackage);
+  registry->Register(RunInPackage);
+  registry->Register(SetBudgets);
+  registry->Register(GetPackageStats);
+}
+
+NYX_BINDING_PER_ISOLATE_INIT(watchdog, CreatePerIsolateProperties)
+NYX_BINDING_CONTEXT_AWARE(watchdog, CreatePerContextProperties)
+NYX_BINDING_EXTERNAL_REFERENCE(watchdog, RegisterExternalReferences)
+
+}  // namespace nyx
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <v8.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace nyx {
+
+class Environment;
+
+// Charges the time spent running JS to the package that owns it and stops packages that overrun their budget.
+//
+// Packages are registered by the loader, which evaluates each runtime's module inside a Scope for it. Timers,
+// immediates and widgets remember the package current when they were created and run their callbacks in a Scope
+// for it, so everything a package schedules from its own code is charged back to it. Microtasks run outside any
+// callback and are not charged to anyone; nested scopes are charged to the outermost.
+//
+// Promise continuations run from microtask checkpoints, outside any scope. A scope tags the promises its code
+// creates with the package through V8's continuation preserved embedder data, and each checkpoint runs in a
+// MicrotaskScope with the callback budget. If a checkpoint overruns it, an interrupt reads the tag of the
+// continuation that is running, terminates it and the tagged package is stopped like any other.
+//
+// While a scope is open a watchdog thread waits for the earlier of the callback budget and what is left of the
+// package's frame budget. If the scope is still open by then it calls TerminateExecution, the scope cancels the
+// termination again once the callback has unwound, and the package is stopped: its callbacks no longer run, and
+// its timers and widgets are cancelled at the start of the next loop iteration. Times are wall clock on the
+// isolate's thread, which is what the frame time pays for.
+class PackageWatchdog {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // Code that is not attributed to any package; never charged or stopped.
+  static constexpr uint32_t kNoPackage = 0;
+
+  static constexpr std::chrono::microseconds kDefaultCallbackBudget{1000000};
+
+  struct PackageStats {
+    std::string name;
+    uint64_t callbacks;
+    uint64_t total_ns;
+    uint64_t frame_ns;       // in the frame being built
+    uint64_t last_frame_ns;  // in the last frame built
+    uint64_t max_callback_ns;
+    bool stopped;
+  };
+
+  class Scope {
+   public:
+    Scope(PackageWatchdog* watchdog, uint32_t package);
+    ~Scope();
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    // The package has been stopped; its callback must not run.
+    bool stopped() const { return stopped_; }
+
+   private:
+    PackageWatchdog* watchdog_;
+    uint32_t package_;
+    bool outermost_;
+    bool stopped_;
+    Clock::time_point start_;
+  };
+
+  // Times a microtask checkpoint, see above. Does nothing inside a Scope, whose deadline already applies.
+  class MicrotaskScope {
+   public:
+    explicit MicrotaskScope(PackageWatchdog* watchdog);
+    ~MicrotaskScope();
+
+    MicrotaskScope(const MicrotaskScope&) = delete;
+    MicrotaskScope& operator=(const MicrotaskScope&) = delete;
+
+   private:
+    PackageWatchdog* watchdog_;
+    bool armed_;
+    Clock::time_point start_;
+  };
+
+  explicit PackageWatchdog(Environment* env);
+  ~PackageWatchdog();
+
+  PackageWatchdog(const PackageWatchdog&) = delete;
+  PackageWatchdog& operator=(const PackageWatchdog&) = delete;
+
+  uint32_t RegisterPackage(const std::string& name);
+  // The package whose code is running, kNoPackage outside of any scope.
+  uint32_t current_package() const { return current_; }
+  bool IsStopped(uint32_t package);
+
+  // 0 disables a budget.
+  void Configure(std::chrono::microseconds callback_budget, std::chrono::microseconds frame_budget);
+  std::chrono::microseconds callback_budget() const { return callback_budget_; }
+  std::chrono::microseconds frame_budget() const { return frame_budget_; }
+
+  void FrameStarted();
+  // Cancels the timers and widgets of packages stopped since the last call. Called where no timer or widget
+  // callback is running.
+  void CancelStoppedPackages();
+
+  const std::vector<PackageStats>& packages() const { return packages_; }
+  void ResetStats();
+
+ private:
+  PackageStats* Get(uint32_t package);
+  // With attribute, execution is terminated from an interrupt that first records the running continuation's
+  // package, see MicrotaskScope.
+  void Arm(Clock::time_point deadline, bool attribute = false);
+  // True when the watchdog terminated execution since Arm.
+  bool Disarm();
+  // Undoes a termination once the terminated code has unwound and stops package, if any.
+  void Terminated(uint32_t package, uint64_t elapsed_ns);
+  void Stop(uint32_t package, uint64_t elapsed_ns);
+  void ThreadMain();
+  static void OnDeadlineInterrupt(v8::Isolate* isolate, void* data);
+
+  Environment* env_;
+  v8::Isolate* isolate_;
+  std::chrono::microseconds callback_budget_ = kDefaultCallbackBudget;
+  std::chrono::microseconds frame_budget_{0};
+  std::vector<PackageStats> packages_;  // index is id - 1
+  std::vector<uint32_t> newly_stopped_;
+  uint32_t current_ = kNoPackage;
+
+  std::thread thread_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  // Guarded by mutex_
+  bool armed_ = false;
+  bool attribute_ = false;
+  bool interrupt_requested_ = false;
+  bool fired_ = false;
+  uint32_t culprit_ = kNoPackage;
+  bool exiting_ = false;
+  Clock::time_point deadline_;
+};
+
+}  // namespace nyx
@@ -4,6 +4,7 @@
 
 #include "nyx/env.h"
 #include "nyx/errors.h"
+#include "nyx/external_references.h"
 #include "nyx/util.h"
 
 namespace nyx {
@@ -95,7 +96,15 @@ static void CreatePerIsolateProperties(IsolateData* isolate_data, Local<ObjectTe
 
 static void CreatePerContextProperties(Local<Object> target, Local<Context> context) {}
 
+static void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(Cwd);
+  registry->Register(Chdir);
+  registry->Register(ScriptsRoot);
+  registry->Register(SetScriptsRoot);
+}
+
 NYX_BINDING_PER_ISOLATE_INIT(process, CreatePerIsolateProperties)
 NYX_BINDING_CONTEXT_AWARE(process, CreatePerContextProperties)
+NYX_BINDING_EXTERNAL_REFERENCE(process, RegisterExternalReferences)
 
 }  // namespace nyx
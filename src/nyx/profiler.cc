@@ -0,0 +1,423 @@
+#include "nyx/profiler.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "nyx/env.h"
+#include "nyx/errors.h"
+#include "nyx/external_references.h"
+#include "nyx/nyx_binding.h"
+
+namespace nyx {
+
+using v8::Array;
+using v8::Context;
+using v8::CpuProfile;
+using v8::CpuProfileNode;
+using v8::CpuProfiler;
+using v8::CpuProfilingOptions;
+using v8::CpuProfilingResult;
+using v8::CpuProfilingStatus;
+using v8::FunctionCallbackInfo;
+using v8::Integer;
+using v8::Isolate;
+using v8::Local;
+using v8::Number;
+using v8::Object;
+using v8::ObjectTemplate;
+using v8::OutputStream;
+using v8::ProfilerId;
+using v8::String;
+using v8::Value;
+
+namespace {
+
+// Profiles are sampled at multiples of this.
+constexpr int kBaseSamplingIntervalUs = 100;
+
+class StringOutputStream : public OutputStream {
+ public:
+  explicit StringOutputStream(std::string* out) : out_(out) {}
+
+  void EndOfStream() override {}
+  int GetChunkSize() override { return 64 * 1024; }
+  WriteResult WriteAsciiChunk(char* data, int size) override {
+    out_->append(data, static_cast<size_t>(size));
+    return kContinue;
+  }
+
+ private:
+  std::string* out_;
+};
+
+Local<String> Utf8String(Isolate* isolate, const std::string& str) {
+  return String::NewFromUtf8(isolate, str.data(), v8::NewStringType::kNormal, static_cast<int>(str.size()))
+      .ToLocalChecked();
+}
+
+}  // namespace
+
+Profiler::Profiler(Environment* env) : env_(env), isolate_(env->isolate()) {
+  frames_.push_back(Frame{"(root)", "", 0});
+
+  uv_timer_init(env_->event_loop(), &window_timer_);
+  uv_unref(reinterpret_cast<uv_handle_t*>(&window_timer_));
+  window_timer_.data = this;
+
+  // Marks the isolate idle while the loop waits for I/O, so those samples are tagged (idle) rather than
+  // (program).
+  uv_prepare_init(env_->event_loop(), &idle_prepare_);
+  uv_unref(reinterpret_cast<uv_handle_t*>(&idle_prepare_));
+  idle_prepare_.data = this;
+  uv_check_init(env_->event_loop(), &idle_check_);
+  uv_unref(reinterpret_cast<uv_handle_t*>(&idle_check_));
+  idle_check_.data = this;
+}
+
+Profiler::~Profiler() {
+  if (profiler_ == nullptr) {
+    return;
+  }
+  for (ProfilerId id : recording_) {
+    if (CpuProfile* profile = profiler_->Stop(id)) {
+      profile->Delete();
+    }
+  }
+  if (window_profile_ != 0) {
+    if (CpuProfile* profile = profiler_->Stop(window_profile_)) {
+      profile->Delete();
+    }
+  }
+  isolate_->SetIdle(false);
+  profiler_->Dispose();
+}
+
+CpuProfiler* Profiler::GetOrCreateProfiler() {
+  if (profiler_ == nullptr) {
+    profiler_ = CpuProfiler::New(isolate_);
+    profiler_->SetSamplingInterval(kBaseSamplingIntervalUs);
+    // Precise sampling busy-waits on Windows to keep the period exact, which costs a core. Being a little late
+    // is fine for a statistical profile.
+    profiler_->SetUsePreciseSampling(false);
+  }
+  return profiler_;
+}
+
+void Profiler::UpdateIdleNotifier() {
+  bool active = window_profile_ != 0 || !recording_.empty();
+  if (active == idle_notifier_) {
+    return;
+  }
+  idle_notifier_ = active;
+  if (active) {
+    uv_prepare_start(&idle_prepare_, [](uv_prepare_t* handle) {
+      static_cast<Profiler*>(handle->data)->isolate_->SetIdle(true);
+    });
+    uv_check_start(&idle_check_, [](uv_check_t* handle) {
+      static_cast<Profiler*>(handle->data)->isolate_->SetIdle(false);
+    });
+  } else {
+    uv_prepare_stop(&idle_prepare_);
+    uv_check_stop(&idle_check_);
+    isolate_->SetIdle(false);
+  }
+}
+
+ProfilerId Profiler::Start(std::chrono::microseconds sampling_interval) {
+  CpuProfilingResult result = GetOrCreateProfiler()->Start(CpuProfilingOptions(
+      v8::kLeafNodeLineNumbers, CpuProfilingOptions::kNoSampleLimit, static_cast<int>(sampling_interval.count())));
+  if (result.status != CpuProfilingStatus::kStarted) {
+    return 0;
+  }
+  recording_.push_back(result.id);
+  UpdateIdleNotifier();
+  return result.id;
+}
+
+bool Profiler::Stop(ProfilerId id, std::string* json) {
+  auto it = std::find(recording_.begin(), recording_.end(), id);
+  if (it == recording_.end()) {
+    return false;
+  }
+  recording_.erase(it);
+  UpdateIdleNotifier();
+
+  CpuProfile* profile = profiler_->Stop(id);
+  if (profile == nullptr) {
+    return false;
+  }
+  StringOutputStream stream(json);
+  profile->Serialize(&stream, CpuProfile::kJSON);
+  profile->Delete();
+  return true;
+}
+
+void Profiler::SetWindow(uint32_t seconds, std::chrono::microseconds sampling_interval) {
+  seconds = std::min(seconds, kMaxWindowSeconds);
+  if (sampling_interval != window_interval_) {
+    // Counts sampled at different rates do not add up.
+    chunks_.clear();
+    window_interval_ = sampling_interval;
+  }
+  window_seconds_ = seconds;
+  while (chunks_.size() > window_seconds_) {
+    chunks_.pop_front();
+  }
+  tree_dirty_ = true;
+
+  if (window_seconds_ == 0) {
+    if (window_profile_ != 0) {
+      uv_timer_stop(&window_timer_);
+      if (CpuProfile* profile = profiler_->Stop(window_profile_)) {
+        profile->Delete();
+      }
+      window_profile_ = 0;
+    }
+  } else {
+    if (window_profile_ != 0) {
+      // Restart so the new interval takes effect.
+      if (CpuProfile* profile = profiler_->Stop(window_profile_)) {
+        profile->Delete();
+      }
+    }
+    window_profile_ = StartWindowProfile();
+    if (window_profile_ != 0) {
+      uv_timer_start(&window_timer_, OnWindowTimer, 1000, 1000);
+    }
+  }
+  UpdateIdleNotifier();
+}
+
+ProfilerId Profiler::StartWindowProfile() {
+  // No samples are kept; the call tree's hit counts are all the window needs.
+  CpuProfilingResult result = GetOrCreateProfiler()->Start(
+      CpuProfilingOptions(v8::kLeafNodeLineNumbers, 0, static_cast<int>(window_interval_.count())));
+  return result.status == CpuProfilingStatus::kStarted ? result.id : 0;
+}
+
+void Profiler::OnWindowTimer(uv_timer_t* handle) {
+  static_cast<Profiler*>(handle->data)->RotateWindow();
+}
+
+void Profiler::RotateWindow() {
+  // The next profile starts before this one stops so no sample falls between them.
+  ProfilerId next = StartWindowProfile();
+  CpuProfile* profile = profiler_->Stop(window_profile_);
+  window_profile_ = next;
+  if (window_profile_ == 0) {
+    uv_timer_stop(&window_timer_);
+    UpdateIdleNotifier();
+  }
+  if (profile == nullptr) {
+    return;
+  }
+
+  Chunk chunk;
+  chunk.push_back(ChunkNode{0, 0, 0});
+  Fold(profile->GetTopDownRoot(), 0, &chunk);
+  profile->Delete();
+
+  chunks_.push_back(std::move(chunk));
+  while (chunks_.size() > window_seconds_) {
+    chunks_.pop_front();
+  }
+  tree_dirty_ = true;
+}
+
+void Profiler::Fold(const CpuProfileNode* node, uint32_t parent, Chunk* chunk) {
+  int count = node->GetChildrenCount();
+  for (int i = 0; i < count; i++) {
+    const CpuProfileNode* child = node->GetChild(i);
+    if (parent == 0 && strcmp(child->GetFunctionNameStr(), "(idle)") == 0) {
+      continue;
+    }
+    uint32_t index = static_cast<uint32_t>(chunk->size());
+    chunk->push_back(ChunkNode{InternFrame(child), parent, child->GetHitCount()});
+    Fold(child, index, chunk);
+  }
+}
+
+uint32_t Profiler::InternFrame(const CpuProfileNode* node) {
+  const char* function = node->GetFunctionNameStr();
+  const char* url = node->GetScriptResourceNameStr();
+  int line = node->GetLineNumber();
+
+  std::string key = std::string(function) + '\n' + url + '\n' + std::to_string(line);
+  auto [it, inserted] = frame_ids_.try_emplace(std::move(key), static_cast<uint32_t>(frames_.size()));
+  if (inserted) {
+    frames_.push_back(Frame{function, url, line});
+  }
+  return it->second;
+}
+
+const Profiler::FlameTree& Profiler::flame_tree() {
+  if (!tree_dirty_) {
+    return tree_;
+  }
+  tree_dirty_ = false;
+
+  tree_.nodes.clear();
+  tree_.nodes.push_back(FlameNode{0, 0, 0, 0});
+  tree_.sampling_interval = window_interval_;
+  tree_.seconds = static_cast<uint32_t>(chunks_.size());
+
+  // (parent, frame) -> node
+  std::unordered_map<uint64_t, uint32_t> merged;
+  std::vector<uint32_t> remap;
+  for (const Chunk& chunk : chunks_) {
+    remap.assign(chunk.size(), 0);
+    for (size_t i = 1; i < chunk.size(); i++) {
+      uint32_t parent = remap[chunk[i].parent];
+      uint64_t key = (static_cast<uint64_t>(parent) << 32) | chunk[i].frame;
+      auto [it, inserted] = merged.try_emplace(key, static_cast<uint32_t>(tree_.nodes.size()));
+      if (inserted) {
+        tree_.nodes.push_back(FlameNode{chunk[i].frame, parent, 0, 0});
+      }
+      tree_.nodes[it->second].self += chunk[i].self;
+      remap[i] = it->second;
+    }
+  }
+
+  // Children come after their parents, so one backwards pass adds every subtree into its parent.
+  for (size_t i = tree_.nodes.size(); i-- > 0;) {
+    FlameNode& node = tree_.nodes[i];
+    node.total += node.self;
+    if (i != 0) {
+      tree_.nodes[node.parent].total += node.total;
+    }
+  }
+  return tree_;
+}
+
+static Profiler& GetProfiler(const FunctionCallbackInfo<Value>& args) {
+  return Environment::GetCurrent(args)->profiler();
+}
+
+static bool GetIntervalArg(const FunctionCallbackInfo<Value>& args,
+                           int index,
+                           std::chrono::microseconds default_interval,
+                           std::chrono::microseconds* interval) {
+  if (args[index]->IsUndefined()) {
+    *interval = default_interval;
+    return true;
+  }
+  if (!args[index]->IsUint32() || args[index].As<v8::Uint32>()->Value() < kBaseSamplingIntervalUs) {
+    THROW_ERR_OUT_OF_RANGE(args.GetIsolate(),
+                           "sampling interval must be an integer of at least " +
+                               std::to_string(kBaseSamplingIntervalUs) + " microseconds");
+    return false;
+  }
+  *interval = std::chrono::microseconds(args[index].As<v8::Uint32>()->Value());
+  return true;
+}
+
+// start(intervalMicroseconds?: number) -> number
+static void Start(const FunctionCallbackInfo<Value>& args) {
+  std::chrono::microseconds interval;
+  if (!GetIntervalArg(args, 0, Profiler::kDefaultSamplingInterval, &interval)) {
+    return;
+  }
+  ProfilerId id = GetProfiler(args).Start(interval);
+  if (id == 0) {
+    THROW_ERR_OPERATION_FAILED(args.GetIsolate(), "could not start the CPU profiler");
+    return;
+  }
+  args.GetReturnValue().Set(id);
+}
+
+// stop(id: number) -> string
+// The profile as .cpuprofile JSON.
+static void Stop(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  if (!args[0]->IsUint32()) {
+    THROW_ERR_INVALID_ARG_TYPE(isolate, "id must be a number");
+    return;
+  }
+  std::string json;
+  if (!GetProfiler(args).Stop(args[0].As<v8::Uint32>()->Value(), &json)) {
+    THROW_ERR_INVALID_STATE(isolate, "no profile with this id is recording");
+    return;
+  }
+  args.GetReturnValue().Set(Utf8String(isolate, json));
+}
+
+// setWindow(seconds: number, intervalMicroseconds?: number) -> void
+// 0 seconds turns the rolling window off.
+static void SetWindow(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  if (!args[0]->IsUint32()) {
+    THROW_ERR_INVALID_ARG_TYPE(isolate, "seconds must be a non-negative integer");
+    return;
+  }
+  uint32_t seconds = args[0].As<v8::Uint32>()->Value();
+  if (seconds > Profiler::kMaxWindowSeconds) {
+    THROW_ERR_OUT_OF_RANGE(isolate, "window is limited to " + std::to_string(Profiler::kMaxWindowSeconds) + " seconds");
+    return;
+  }
+  std::chrono::microseconds interval;
+  if (!GetIntervalArg(args, 1, Profiler::kDefaultWindowSamplingInterval, &interval)) {
+    return;
+  }
+  GetProfiler(args).SetWindow(seconds, interval);
+}
+
+// getWindow() -> object
+// The call tree over the window, parents before children. Times in microseconds.
+static void GetWindow(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Local<Context> context = isolate->GetCurrentContext();
+  Profiler& profiler = GetProfiler(args);
+  const Profiler::FlameTree& tree = profiler.flame_tree();
+  double interval = static_cast<double>(tree.sampling_interval.count());
+
+  Local<Array> nodes = Array::New(isolate, static_cast<int>(tree.nodes.size()));
+  for (uint32_t i = 0; i < tree.nodes.size(); i++) {
+    const Profiler::FlameNode& node = tree.nodes[i];
+    const Profiler::Frame& frame = profiler.frame(node.frame);
+    Local<Object> entry = Object::New(isolate);
+    auto set = [&](const char* name, Local<Value> value) {
+      entry->Set(context, OneByteString(isolate, name), value).Check();
+    };
+    set("name", Utf8String(isolate, frame.function));
+    set("url", Utf8String(isolate, frame.url));
+    set("line", Integer::New(isolate, frame.line));
+    set("parent", Integer::NewFromUnsigned(isolate, node.parent));
+    set("self", Number::New(isolate, static_cast<double>(node.self) * interval));
+    set("total", Number::New(isolate, static_cast<double>(node.total) * interval));
+    nodes->Set(context, i, entry).Check();
+  }
+
+  Local<Object> result = Object::New(isolate);
+  auto set = [&](const char* name, Local<Value> value) {
+    result->Set(context, OneByteString(isolate, name), value).Check();
+  };
+  set("window", Integer::NewFromUnsigned(isolate, profiler.window()));
+  set("seconds", Integer::NewFromUnsigned(isolate, tree.seconds));
+  set("interval", Number::New(isolate, interval));
+  set("nodes", nodes);
+  args.GetReturnValue().Set(result);
+}
+
+static void CreatePerIsolateProperties(IsolateData* isolate_data, Local<ObjectTemplate> target) {
+  Isolate* isolate = isolate_data->isolate();
+
+  SetMethod(isolate, target, "start", Start);
+  SetMethod(isolate, target, "stop", Stop);
+  SetMethod(isolate, target, "setWindow", SetWindow);
+  SetMethod(isolate, target, "getWindow", GetWindow);
+}
+
+static void CreatePerContextProperties(Local<Object> target, Local<Context> context) {}
+
+static void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(Start);
+  registry->Register(Stop);
+  registry->Register(SetWindow);
+  registry->Register(GetWindow);
+}
+
+NYX_BINDING_PER_ISOLATE_INIT(profiler, CreatePerIsolateProperties)
+NYX_BINDING_CONTEXT_AWARE(profiler, CreatePerContextProperties)
+NYX_BINDING_EXTERNAL_REFERENCE(profiler, RegisterExternalReferences)
+
+}  // namespace nyx
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <uv.h>
+#include <v8-profiler.h>
+#include <v8.h>
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nyx {
+
+class Environment;
+
+// Sampling CPU profiler for the environment's isolate, built on v8::CpuProfiler.
+//
+// Scripts record profiles explicitly with Start/Stop and get them back as .cpuprofile JSON. Independently of
+// those, a rolling window keeps the call tree of the last few seconds for the FlameGraph widget: a profile is
+// recorded per second, folded into a chunk of counts when it ends and dropped, so only the merged counts of the
+// window are kept. Window profiles record no individual samples and sample every 10 ms by default, which is
+// cheap enough to leave on. V8 samples at the finest interval any running profile asks for.
+//
+// Time the loop spends waiting in uv's poll is reported to V8 as idle and left out of the window.
+class Profiler {
+ public:
+  static constexpr std::chrono::microseconds kDefaultSamplingInterval{1000};
+  static constexpr std::chrono::microseconds kDefaultWindowSamplingInterval{10000};
+  static constexpr uint32_t kMaxWindowSeconds = 300;
+
+  // A function as the profiler names it. Id 0 is the root of every tree.
+  struct Frame {
+    std::string function;
+    std::string url;
+    int line;
+  };
+
+  // Nodes are ordered so that parents come before their children; node 0 is the root.
+  struct FlameNode {
+    uint32_t frame;
+    uint32_t parent;
+    uint64_t self;   // samples
+    uint64_t total;  // samples including children
+  };
+
+  struct FlameTree {
+    std::vector<FlameNode> nodes;
+    std::chrono::microseconds sampling_interval{0};
+    uint32_t seconds = 0;  // covered so far, up to the window
+  };
+
+  explicit Profiler(Environment* env);
+  ~Profiler();
+
+  Profiler(const Profiler&) = delete;
+  Profiler& operator=(const Profiler&) = delete;
+
+  // Returns 0 when V8 refuses to start another profile.
+  v8::ProfilerId Start(std::chrono::microseconds sampling_interval);
+  // The profile as .cpuprofile JSON; false if id is not recording.
+  bool Stop(v8::ProfilerId id, std::string* json);
+  size_t recording() const { return recording_.size(); }
+
+  // 0 seconds turns the window off and drops what it holds.
+  void SetWindow(uint32_t seconds, std::chrono::microseconds sampling_interval = kDefaultWindowSamplingInterval);
+  uint32_t window() const { return window_seconds_; }
+
+  // Merged over the window; rebuilt after each second.
+  const FlameTree& flame_tree();
+  const Frame& frame(uint32_t id) const { return frames_[id]; }
+
+ private:
+  struct ChunkNode {
+    uint32_t frame;
+    uint32_t parent;
+    uint32_t self;
+  };
+  using Chunk = std::vector<ChunkNode>;
+
+  v8::CpuProfiler* GetOrCreateProfiler();
+  void UpdateIdleNotifier();
+  v8::ProfilerId StartWindowProfile();
+  void RotateWindow();
+  void Fold(const v8::CpuProfileNode* node, uint32_t parent, Chunk* chunk);
+  uint32_t InternFrame(const v8::CpuProfileNode* node);
+
+  static void OnWindowTimer(uv_timer_t* handle);
+
+  Environment* env_;
+  v8::Isolate* isolate_;
+  v8::CpuProfiler* profiler_ = nullptr;
+  std::vector<v8::ProfilerId> recording_;
+
+  uint32_t window_seconds_ = 0;
+  std::chrono::microseconds window_interval_ = kDefaultWindowSamplingInterval;
+  v8::ProfilerId window_profile_ = 0;
+  std::deque<Chunk> chunks_;
+  FlameTree tree_;
+  bool tree_dirty_ = false;
+
+  std::vector<Frame> frames_;
+  std::unordered_map<std::string, uint32_t> frame_ids_;
+
+  // Closed by CloseEventLoop with the rest of the loop's handles.
+  uv_timer_t window_timer_;
+  uv_prepare_t idle_prepare_;
+  uv_check_t idle_check_;
+  bool idle_notifier_ = false;
+};
+
+}  // namespace nyx
@@ -2,12 +2,15 @@
 
 #include "nyx/env.h"
 #include "nyx/errors.h"
+#include "nyx/external_references.h"
 #include "nyx/nyx.h"
+#include "nyx/snapshot.h"
 
 namespace nyx {
 
 using v8::Context;
 using v8::EscapableHandleScope;
+using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::HandleScope;
 using v8::Isolate;
@@ -15,6 +18,7 @@ using v8::Local;
 using v8::MaybeLocal;
 using v8::ObjectTemplate;
 using v8::Script;
+using v8::SnapshotCreator;
 using v8::String;
 using v8::Value;
 
@@ -65,6 +69,16 @@ MaybeLocal<Value> Realm::ExecuteBootstrapper(const char* id) {
 MaybeLocal<Value> Realm::RunBootstrapping() {
   EscapableHandleScope scope(isolate());
   Local<Value> result;
+  if (deserialized_) {
+    // The bootstrappers ran when the snapshot was built; only builtins registered since then are missing.
+    Local<Context> ctx = context();
+    Local<Value> ids;
+    if (!ToV8Value(ctx, env()->builtin_loader()->GetBuiltinIds()).ToLocal(&ids) ||
+        add_builtin_ids()->Call(ctx, Undefined(isolate()), 1, &ids).IsEmpty()) {
+      return MaybeLocal<Value>();
+    }
+    return scope.Escape(True(isolate()));
+  }
   if (!ExecuteBootstrapper("internal/bootstrap/realm").ToLocal(&result) || BootstrapRealm().ToLocal(&result)) {
     return MaybeLocal<Value>();
   }
@@ -75,6 +89,20 @@ Environment* Realm::env() const {
   return env_;
 }
 
+void Realm::Serialize(SnapshotCreator* creator) {
+  HandleScope handle_scope(isolate());
+  Local<Context> ctx = context();
+  // AddData rejects empty handles, so values the bootstrappers never set are stored as undefined.
+#define V(PropertyName, TypeName)                                                                                      \
+  if (PropertyName##_.IsEmpty()) {                                                                                     \
+    creator->AddData(ctx, Undefined(isolate()).As<Value>());                                                           \
+  } else {                                                                                                             \
+    creator->AddData(ctx, PropertyName##_.Get(isolate()));                                                             \
+  }
+  PER_REALM_STRONG_PERSISTENT_VALUES(V)
+#undef V
+}
+
 IsolateData* Realm::isolate_data() const {
   return env_->isolate_data();
 }
@@ -94,6 +122,10 @@ static void DebugLogCallback(const FunctionCallbackInfo<Value>& args) {
   fflush(out);
 }
 
+void Realm::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(DebugLogCallback);
+}
+
 PrincipalRealm::PrincipalRealm(Environment* env) : Realm(env) {
   CreateProperties();
   InitializeContext();
@@ -125,6 +157,10 @@ void PrincipalRealm::InitializeContext() {
   Isolate::Scope isolate_scope(isolate_);
   HandleScope handle_scope(isolate_);
 
+  if (isolate_data()->from_snapshot() && DeserializeContext()) {
+    return;
+  }
+
   // Create global template with builtins
   Local<ObjectTemplate> global_tmpl = ObjectTemplate::New(isolate_);
   SetMethod(isolate_, global_tmpl, "debugLog", DebugLogCallback);
@@ -135,4 +171,25 @@ void PrincipalRealm::InitializeContext() {
   SetContext(context);
 }
 
+bool PrincipalRealm::DeserializeContext() {
+  Local<Context> context;
+  if (!Context::FromSnapshot(isolate_, SnapshotBuilder::kNyxContextIndex).ToLocal(&context)) {
+    return false;
+  }
+  context->SetAlignedPointerInEmbedderData(0, env());
+  SetContext(context);
+
+  size_t index = 0;
+  Local<Value> value;
+#define V(PropertyName, TypeName)                                                                                      \
+  if (context->GetDataFromSnapshotOnce<Value>(index++).ToLocal(&value) && !value->IsUndefined()) {                     \
+    PropertyName##_.Reset(isolate_, value.As<TypeName>());                                                             \
+  }
+  PER_REALM_STRONG_PERSISTENT_VALUES(V)
+#undef V
+
+  deserialized_ = true;
+  return true;
+}
+
 }  // namespace nyx
@@ -3,11 +3,14 @@
 #include "nyx/isolate_data.h"
 #include "nyx/util.h"
 
+#include <v8-snapshot.h>
+
 #include <set>
 
 namespace nyx {
 
 class Environment;
+class ExternalReferenceRegistry;
 class IsolateData;
 
 class Realm {
@@ -27,6 +30,11 @@ class Realm {
   v8::MaybeLocal<v8::Value> ExecuteBootstrapper(const char* id);
   v8::MaybeLocal<v8::Value> RunBootstrapping();
 
+  // Adds the per-realm values to the snapshot as context data, in PER_REALM_STRONG_PERSISTENT_VALUES order.
+  void Serialize(v8::SnapshotCreator* creator);
+
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
+
   Environment* env() const;
   IsolateData* isolate_data() const;
   v8::Isolate* isolate() const;
@@ -52,6 +60,8 @@ class Realm {
   Environment* env_;
   v8::Isolate* isolate_;
   v8::Global<v8::Context> context_;
+  // The context came out of the startup snapshot and has already run the bootstrappers.
+  bool deserialized_ = false;
 
 #define V(PropertyName, TypeName) v8::Global<TypeName> PropertyName##_;
   PER_REALM_STRONG_PERSISTENT_VALUES(V)
@@ -74,6 +84,7 @@ class PrincipalRealm : public Realm {
 
  private:
   void InitializeContext();
+  bool DeserializeContext();
 };
 
 }  // namespace nyx
@@ -0,0 +1,138 @@
+#include "nyx/snapshot.h"
+
+#include "nyx/env.h"
+#include "nyx/external_references.h"
+#include "nyx/isolate_data.h"
+#include "nyx/nyx.h"
+#include "nyx/nyx_binding.h"
+#include "nyx/realm.h"
+
+#include <uv.h>
+
+#include <cstdio>
+#include <memory>
+
+namespace nyx {
+
+using v8::ArrayBuffer;
+using v8::Context;
+using v8::HandleScope;
+using v8::Isolate;
+using v8::Local;
+using v8::Object;
+using v8::SnapshotCreator;
+using v8::StartupData;
+using v8::TryCatch;
+
+namespace {
+
+bool WriteSnapshotSource(const std::string& out_path, const StartupData& blob) {
+  FILE* out = fopen(out_path.c_str(), "wb");
+  if (!out) {
+    fprintf(stderr, "Cannot open %s for writing\n", out_path.c_str());
+    return false;
+  }
+
+  fprintf(out, "// Generated by nyx_mksnapshot, do not edit.\n\n");
+  fprintf(out, "#include \"nyx/snapshot.h\"\n\n");
+  fprintf(out, "namespace nyx {\n\n");
+  fprintf(out, "static const unsigned char snapshot_blob_data[] = {");
+  for (int i = 0; i < blob.raw_size; i++) {
+    fprintf(out, "%s%u,", i % 32 == 0 ? "\n  " : "", static_cast<unsigned char>(blob.data[i]));
+  }
+  fprintf(out, "\n};\n\n");
+  fprintf(out, "const v8::StartupData* SnapshotBuilder::GetEmbeddedSnapshotData() {\n");
+  fprintf(out,
+          "  static const v8::StartupData blob{reinterpret_cast<const char*>(snapshot_blob_data), %d};\n",
+          blob.raw_size);
+  fprintf(out, "  return &blob;\n");
+  fprintf(out, "}\n\n");
+  fprintf(out, "}  // namespace nyx\n");
+
+  bool ok = ferror(out) == 0;
+  ok = fclose(out) == 0 && ok;
+  if (!ok) {
+    fprintf(stderr, "Failed to write %s\n", out_path.c_str());
+  }
+  return ok;
+}
+
+}  // namespace
+
+int SnapshotBuilder::Generate(const std::string& out_path) {
+  uv_loop_t event_loop;
+  int uv_err = uv_loop_init(&event_loop);
+  if (uv_err != 0) {
+    fprintf(stderr, "Failed to initialize event loop: %s\n", uv_strerror(uv_err));
+    return 1;
+  }
+
+  RegisterBuiltinBindings();
+
+  std::unique_ptr<ArrayBuffer::Allocator> allocator(ArrayBuffer::Allocator::NewDefaultAllocator());
+  Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = allocator.get();
+  create_params.external_references = ExternalReferenceRegistry::Get().external_references();
+
+  StartupData blob{nullptr, 0};
+  {
+    SnapshotCreator creator(create_params);
+    Isolate* isolate = creator.GetIsolate();
+    {
+      std::unique_ptr<IsolateData> isolate_data = std::make_unique<IsolateData>(isolate, &event_loop);
+      Isolate::Scope isolate_scope(isolate);
+      HandleScope handle_scope(isolate);
+      creator.SetDefaultContext(Context::New(isolate));
+
+      Local<Context> context;
+      {
+        TryCatch try_catch(isolate);
+        // Without a renderer or game lock the bootstrappers only set up the module loader, console and timers.
+        Environment env(isolate_data.get(), isolate, "", nullptr, nullptr);
+        Realm* realm = env.principal_realm();
+        if (try_catch.HasCaught() || realm->add_builtin_ids().IsEmpty()) {
+          fprintf(stderr, "Bootstrapping failed, cannot build the snapshot\n");
+          return 1;
+        }
+        context = env.context();
+        realm->Serialize(&creator);
+        env.Stop();
+        CloseEventLoop(&event_loop);
+      }
+
+      // The environment is gone, so everything left in the heap is reachable from the context or isolate data.
+      creator.AddContext(context,
+                         {SerializeInternalFields, nullptr},
+                         {SerializeContextData, nullptr});
+      isolate_data->Serialize(&creator);
+    }
+    blob = creator.CreateBlob(SnapshotCreator::FunctionCodeHandling::kKeep);
+  }
+  uv_loop_close(&event_loop);
+
+  if (blob.data == nullptr) {
+    fprintf(stderr, "Failed to create the snapshot blob\n");
+    return 1;
+  }
+  bool written = WriteSnapshotSource(out_path, blob);
+  delete[] blob.data;
+  return written ? 0 : 1;
+}
+
+const StartupData* SnapshotBuilder::GetUsableSnapshotData() {
+  static const StartupData* usable = [] {
+    const StartupData* blob = GetEmbeddedSnapshotData();
+    return blob && blob->IsValid() ? blob : nullptr;
+  }();
+  return usable;
+}
+
+StartupData SnapshotBuilder::SerializeInternalFields(Local<Object> holder, int index, void* data) {
+  return {nullptr, 0};
+}
+
+StartupData SnapshotBuilder::SerializeContextData(Local<Context> holder, int index, void* data) {
+  return {nullptr, 0};
+}
+
+}  // namespace nyx
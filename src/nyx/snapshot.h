@@ -0,0 +1,35 @@
+#pragma once
+
+#include <v8-snapshot.h>
+
+#include <string>
+
+namespace nyx {
+
+// Builds the startup snapshot: an isolate whose principal realm has already run internal/bootstrap/realm and
+// internal/bootstrap/nyx, together with the IsolateData properties and binding templates it was built from.
+// Start() deserializes every isolate from the embedded blob instead of compiling and running the bootstrappers.
+//
+// The blob is generated at build time by nyx_mksnapshot (NYX_USE_SNAPSHOT). Without it, or when the blob does not
+// match the linked V8, GetUsableSnapshotData returns nullptr and isolates bootstrap from source as before.
+class SnapshotBuilder {
+ public:
+  static constexpr size_t kNyxContextIndex = 0;
+
+  // Bootstraps a realm and writes it to out_path as a C++ source defining GetEmbeddedSnapshotData.
+  // Requires Initialize(). Returns a process exit code.
+  static int Generate(const std::string& out_path);
+
+  // Defined by the generated source, or by snapshot_stub.cc which returns nullptr.
+  static const v8::StartupData* GetEmbeddedSnapshotData();
+
+  // The embedded blob if there is one and it was produced by this V8 version, otherwise nullptr.
+  static const v8::StartupData* GetUsableSnapshotData();
+
+ private:
+  // Embedder pointers refer to the builder's Environment and Realm; they are reset after deserialization.
+  static v8::StartupData SerializeInternalFields(v8::Local<v8::Object> holder, int index, void* data);
+  static v8::StartupData SerializeContextData(v8::Local<v8::Context> holder, int index, void* data);
+};
+
+}  // namespace nyx
@@ -0,0 +1,124 @@
+#include "nyx/snapshot_arena.h"
+
+#include "nyx/util.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace nyx {
+
+uint32_t SnapshotArena::AddRegion(uint64_t address, uint32_t size, std::vector<int64_t> chain) {
+  std::lock_guard<std::mutex> lock(regions_mutex_);
+  uint32_t id = next_id_++;
+  regions_.push_back({id, address, size, std::move(chain)});
+  return id;
+}
+
+bool SnapshotArena::RemoveRegion(uint32_t id) {
+  std::lock_guard<std::mutex> lock(regions_mutex_);
+  auto it = std::lower_bound(
+      regions_.begin(), regions_.end(), id, [](const Region& region, uint32_t value) { return region.id < value; });
+  if (it == regions_.end() || it->id != id) return false;
+  regions_.erase(it);
+  return true;
+}
+
+void SnapshotArena::Clear() {
+  std::lock_guard<std::mutex> lock(regions_mutex_);
+  regions_.clear();
+}
+
+bool SnapshotArena::ResolveRegion(const Region& region, uint64_t* address) {
+  uint64_t current = region.address;
+  for (int64_t offset : region.chain) {
+    uint64_t pointer;
+    if (!SafeMemcpy(&pointer, reinterpret_cast<const void*>(current), sizeof(pointer)) || pointer == 0) {
+      return false;
+    }
+    current = pointer + offset;
+  }
+  *address = current;
+  return true;
+}
+
+void SnapshotArena::Capture() {
+  auto start = std::chrono::steady_clock::now();
+
+  int back = published_.load() == 0 ? 1 : 0;
+  if (pinned_.load() == back) {
+    skipped_++;
+    return;
+  }
+
+  Buffer& buffer = buffers_[back];
+  {
+    std::lock_guard<std::mutex> lock(regions_mutex_);
+
+    size_t total = 0;
+    buffer.entries.resize(regions_.size());
+    for (size_t i = 0; i < regions_.size(); i++) {
+      buffer.entries[i] = {regions_[i].id, static_cast<uint32_t>(total), regions_[i].size, false};
+      total += regions_[i].size;
+    }
+    // Grow only, so steady-state captures do not allocate.
+    if (buffer.data.size() < total) buffer.data.resize(total);
+
+    for (size_t i = 0; i < regions_.size(); i++) {
+      Entry& entry = buffer.entries[i];
+      uint64_t address;
+      entry.valid = ResolveRegion(regions_[i], &address) &&
+                    SafeMemcpy(buffer.data.data() + entry.offset, reinterpret_cast<const void*>(address), entry.size);
+    }
+  }
+
+  buffer.sequence = ++sequence_;
+  published_.store(back);
+  published_sequence_.store(buffer.sequence);
+  captures_++;
+  last_capture_ns_ = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+                         .count();
+}
+
+uint64_t SnapshotArena::Pin() {
+  // Re-check after pinning: the game thread may have published (and started refilling the old buffer)
+  // between the load and the store.
+  int index;
+  do {
+    index = published_.load();
+    pinned_.store(index);
+  } while (published_.load() != index);
+  return index < 0 ? 0 : buffers_[index].sequence;
+}
+
+void SnapshotArena::Unpin() {
+  pinned_.store(-1);
+}
+
+bool SnapshotArena::Read(uint32_t id, uint8_t* dest, size_t size) const {
+  int index = pinned_.load();
+  if (index < 0) return false;
+
+  const Buffer& buffer = buffers_[index];
+  auto it = std::lower_bound(buffer.entries.begin(), buffer.entries.end(), id, [](const Entry& entry, uint32_t value) {
+    return entry.id < value;
+  });
+  if (it == buffer.entries.end() || it->id != id || !it->valid) return false;
+
+  std::memcpy(dest, buffer.data.data() + it->offset, std::min<size_t>(size, it->size));
+  return true;
+}
+
+SnapshotArena::Stats SnapshotArena::stats() const {
+  std::lock_guard<std::mutex> lock(regions_mutex_);
+  size_t bytes = 0;
+  for (const Region& region : regions_) bytes += region.size;
+  return {published_sequence_.load(),
+          captures_.load(),
+          skipped_.load(),
+          last_capture_ns_.load(),
+          regions_.size(),
+          bytes};
+}
+
+}  // namespace nyx
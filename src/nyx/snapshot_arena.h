@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace nyx {
+
+// Memory regions copied by the game thread at the start of every GameLock window, so scripts can read a
+// consistent frame without holding the lock.
+//
+// Two buffers alternate: the game thread fills the one that is not published and then publishes it.
+// A reader pins the published buffer while it reads; if the game thread's next target is still pinned
+// the capture for that window is skipped rather than overwriting data under the reader.
+class SnapshotArena {
+ public:
+  struct Stats {
+    uint64_t sequence;
+    uint64_t captures;
+    uint64_t skipped;
+    uint64_t last_capture_ns;
+    size_t regions;
+    size_t bytes;
+  };
+
+  SnapshotArena() = default;
+  SnapshotArena(const SnapshotArena&) = delete;
+  SnapshotArena& operator=(const SnapshotArena&) = delete;
+
+  // Registers size bytes at address. With a chain, address is dereferenced once per entry and the entry
+  // added afterwards ([[address] + c0] + c1 ...), re-resolved on every capture. Returns the region id.
+  uint32_t AddRegion(uint64_t address, uint32_t size, std::vector<int64_t> chain);
+  bool RemoveRegion(uint32_t id);
+  void Clear();
+
+  // Game thread (or the script thread when there is no game lock). Must not run concurrently with itself.
+  void Capture();
+
+  // Pins the newest published buffer and returns its sequence number, 0 if nothing has been captured yet.
+  uint64_t Pin();
+  void Unpin();
+  bool pinned() const { return pinned_.load() >= 0; }
+
+  // Copies region id from the pinned buffer into dest. Returns false if the region was not part of that
+  // snapshot, its pointer chain broke or its memory was unreadable. Requires a pin.
+  bool Read(uint32_t id, uint8_t* dest, size_t size) const;
+
+  Stats stats() const;
+
+ private:
+  struct Region {
+    uint32_t id;
+    uint64_t address;
+    uint32_t size;
+    std::vector<int64_t> chain;
+  };
+
+  struct Entry {
+    uint32_t id;
+    uint32_t offset;
+    uint32_t size;
+    bool valid;
+  };
+
+  struct Buffer {
+    std::vector<uint8_t> data;
+    std::vector<Entry> entries;  // sorted by id
+    uint64_t sequence = 0;
+  };
+
+  static bool ResolveRegion(const Region& region, uint64_t* address);
+
+  mutable std::mutex regions_mutex_;
+  std::vector<Region> regions_;  // sorted by id
+  uint32_t next_id_ = 1;
+
+  Buffer buffers_[2];
+  std::atomic<int> published_{-1};
+  std::atomic<int> pinned_{-1};
+
+  uint64_t sequence_ = 0;
+  std::atomic<uint64_t> published_sequence_{0};
+  std::atomic<uint64_t> captures_{0};
+  std::atomic<uint64_t> skipped_{0};
+  std::atomic<uint64_t> last_capture_ns_{0};
+};
+
+}  // namespace nyx
@@ -0,0 +1,9 @@
+#include "nyx/snapshot.h"
+
+namespace nyx {
+
+const v8::StartupData* SnapshotBuilder::GetEmbeddedSnapshotData() {
+  return nullptr;
+}
+
+}  // namespace nyx
@@ -1,8 +1,10 @@
 #include "nyx/timers.h"
 
 #include "nyx/env.h"
+#include "nyx/external_references.h"
 #include "nyx/isolate_data.h"
 #include "nyx/nyx_binding.h"
+#include "nyx/package_watchdog.h"
 #include "nyx/realm.h"
 #include "nyx/util.h"
 
@@ -19,10 +21,13 @@ using v8::Object;
 using v8::ObjectTemplate;
 using v8::Value;
 
-uint64_t TimerWrap::next_id_ = 1;
+std::atomic<uint64_t> TimerWrap::next_id_{1};
 
 TimerWrap::TimerWrap(Realm* realm, Local<Object> obj, Local<Function> callback)
-    : BaseObject(realm, obj), id_(next_id_++), repeat_(0) {
+    : BaseObject(realm, obj),
+      id_(next_id_++),
+      repeat_(0),
+      package_(realm->env()->package_watchdog().current_package()) {
   callback_.Reset(isolate(), callback);
   uv_timer_init(env()->event_loop(), &handle_);
   handle_.data = this;
@@ -66,9 +71,12 @@ void TimerWrap::OnTimeout(uv_timer_t* handle) {
   Context::Scope context_scope(context);
 
   if (!wrap->callback_.IsEmpty()) {
-    Local<Function> callback = wrap->callback_.Get(isolate);
-    TryCatchScope try_catch(isolate);
-    callback->Call(context, context->Global(), 0, nullptr);
+    PackageWatchdog::Scope package_scope(&env->package_watchdog(), wrap->package_);
+    if (!package_scope.stopped()) {
+      Local<Function> callback = wrap->callback_.Get(isolate);
+      TryCatchScope try_catch(isolate);
+      callback->Call(context, context->Global(), 0, nullptr);
+    }
   }
 
   if (is_one_shot) {
@@ -82,10 +90,10 @@ void TimerWrap::OnUvClose(uv_handle_t* handle) {
   wrap->MakeWeak();
 }
 
-uint64_t ImmediateWrap::next_id_ = 1;
+std::atomic<uint64_t> ImmediateWrap::next_id_{1};
 
 ImmediateWrap::ImmediateWrap(Realm* realm, Local<Object> obj, Local<Function> callback)
-    : BaseObject(realm, obj), id_(next_id_++) {
+    : BaseObject(realm, obj), id_(next_id_++), package_(realm->env()->package_watchdog().current_package()) {
   callback_.Reset(isolate(), callback);
   uv_check_init(env()->event_loop(), &handle_);
   handle_.data = this;
@@ -128,9 +136,12 @@ void ImmediateWrap::OnCheck(uv_check_t* handle) {
   Context::Scope context_scope(context);
 
   if (!wrap->callback_.IsEmpty()) {
-    Local<Function> callback = wrap->callback_.Get(isolate);
-    TryCatchScope try_catch(isolate);
-    callback->Call(context, context->Global(), 0, nullptr);
+    PackageWatchdog::Scope package_scope(&env->package_watchdog(), wrap->package_);
+    if (!package_scope.stopped()) {
+      Local<Function> callback = wrap->callback_.Get(isolate);
+      TryCatchScope try_catch(isolate);
+      callback->Call(context, context->Global(), 0, nullptr);
+    }
   }
 
   env->timer_registry().UnregisterImmediate(id);
@@ -201,6 +212,25 @@ void TimerRegistry::CancelImmediate(uint64_t id) {
   wrap->Close();
 }
 
+void TimerRegistry::CancelPackage(uint32_t package) {
+  for (auto it = timers_.begin(); it != timers_.end();) {
+    if (it->second->package() == package) {
+      it->second->Close();
+      it = timers_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  for (auto it = immediates_.begin(); it != immediates_.end();) {
+    if (it->second->package() == package) {
+      it->second->Close();
+      it = immediates_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 void TimerRegistry::UnregisterTimer(uint64_t id) {
   timers_.erase(id);
 }
@@ -314,7 +344,16 @@ static void CreatePerIsolateProperties(IsolateData* isolate_data, Local<ObjectTe
 
 static void CreatePerContextProperties(Local<Object> target, Local<Context> context) {}
 
+static void RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(SetTimeoutCallback);
+  registry->Register(SetIntervalCallback);
+  registry->Register(ClearTimeoutCallback);
+  registry->Register(SetImmediateCallback);
+  registry->Register(ClearImmediateCallback);
+}
+
 NYX_BINDING_PER_ISOLATE_INIT(timers, CreatePerIsolateProperties)
 NYX_BINDING_CONTEXT_AWARE(timers, CreatePerContextProperties)
+NYX_BINDING_EXTERNAL_REFERENCE(timers, RegisterExternalReferences)
 
 }  // namespace nyx
@@ -4,6 +4,7 @@
 
 #include <uv.h>
 
+#include <atomic>
 #include <unordered_map>
 
 namespace nyx {
@@ -20,6 +21,7 @@ class TimerWrap : public BaseObject {
   void CloseImmediate();
 
   uint64_t id() const { return id_; }
+  uint32_t package() const { return package_; }
 
   void OnGCCollect() override;
 
@@ -35,8 +37,10 @@ class TimerWrap : public BaseObject {
   v8::Global<v8::Function> callback_;
   uint64_t id_;
   uint64_t repeat_;
+  uint32_t package_;
 
-  static uint64_t next_id_;
+  // Shared by the environments of every thread.
+  static std::atomic<uint64_t> next_id_;
 };
 
 class ImmediateWrap : public BaseObject {
@@ -46,6 +50,7 @@ class ImmediateWrap : public BaseObject {
   void CloseImmediate();
 
   uint64_t id() const { return id_; }
+  uint32_t package() const { return package_; }
 
   void OnGCCollect() override;
 
@@ -60,8 +65,10 @@ class ImmediateWrap : public BaseObject {
   uv_check_t handle_;
   v8::Global<v8::Function> callback_;
   uint64_t id_;
+  uint32_t package_;
 
-  static uint64_t next_id_;
+  // Shared by the environments of every thread.
+  static std::atomic<uint64_t> next_id_;
 };
 
 class TimerRegistry {
@@ -75,6 +82,8 @@ class TimerRegistry {
 
   void CancelTimer(uint64_t id);
   void CancelImmediate(uint64_t id);
+  // Cancels every timer and immediate created by the package, see PackageWatchdog.
+  void CancelPackage(uint32_t package);
 
   void UnregisterTimer(uint64_t id);
   void UnregisterImmediate(uint64_t id);
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace nyx {
+
+// Fixed-size ring of the last N records, written by one thread and read by any. Push never blocks or
+// allocates. Read copies records out. If the writer laps the reader mid-copy, the records it may have
+// overwritten are dropped instead of returned torn.
+//
+// Records are stored as relaxed atomic words. The writer claims a slot before writing it, and readers check
+// the claims after copying, in the manner of a seqlock.
+template <typename T, size_t N>
+class TraceRing {
+  static_assert(std::is_trivially_copyable_v<T> && sizeof(T) % sizeof(uint64_t) == 0,
+                "records must be trivially copyable and a whole number of words");
+  static constexpr size_t kWords = sizeof(T) / sizeof(uint64_t);
+
+ public:
+  static constexpr size_t kCapacity = N;
+
+  TraceRing() = default;
+  TraceRing(const TraceRing&) = delete;
+  TraceRing& operator=(const TraceRing&) = delete;
+
+  // Writer thread only.
+  void Push(const T& record) {
+    uint64_t index = claimed_.load(std::memory_order_relaxed);
+    claimed_.store(index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    uint64_t words[kWords];
+    std::memcpy(words, &record, sizeof(T));
+    Slot& slot = slots_[index % N];
+    for (size_t i = 0; i < kWords; i++) {
+      slot[i].store(words[i], std::memory_order_relaxed);
+    }
+    committed_.store(index + 1, std::memory_order_release);
+  }
+
+  // Appends up to max of the newest records to out, oldest first. Returns how many were appended.
+  size_t Read(std::vector<T>* out, size_t max = N) const {
+    uint64_t end = committed_.load(std::memory_order_acquire);
+    uint64_t count = std::min<uint64_t>({end, N, max});
+    uint64_t begin = end - count;
+
+    size_t base = out->size();
+    out->resize(base + count);
+    for (uint64_t index = begin; index < end; index++) {
+      uint64_t words[kWords];
+      const Slot& slot = slots_[index % N];
+      for (size_t i = 0; i < kWords; i++) {
+        words[i] = slot[i].load(std::memory_order_relaxed);
+      }
+      std::memcpy(&(*out)[base + (index - begin)], words, sizeof(T));
+    }
+
+    // Claiming index i overwrites record i - N, so records below claimed - N may be torn.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t claimed = claimed_.load(std::memory_order_relaxed);
+    uint64_t torn = claimed > begin + N ? std::min<uint64_t>(claimed - N - begin, count) : 0;
+    out->erase(out->begin() + base, out->begin() + base + torn);
+    return count - torn;
+  }
+
+  // Records pushed since construction, including those overwritten since.
+  uint64_t total() const { return committed_.load(std::memory_order_acquire); }
+
+ private:
+  using Slot = std::array<std::atomic<uint64_t>, kWords>;
+
+  std::array<Slot, N> slots_{};
+  std::atomic<uint64_t> claimed_{0};
+  std::atomic<uint64_t> committed_{0};
+};
+
+}  // namespace nyx
@@ -1,7 +1,12 @@
 #include "util.h"
 
+#include "nyx/latency_histogram.h"
+
+#include <Windows.h>
 #include <simdutf.h>
 
+#include <cstring>
+
 namespace nyx {
 
 using v8::ArrayBufferView;
@@ -21,6 +26,34 @@ void Assert(const AssertionInfo& info) {
   ABORT();
 }
 
+bool SafeMemcpy(void* dest, const void* src, size_t size) {
+  __try {
+    std::memcpy(dest, src, size);
+    return true;
+  } __except (EXCEPTION_EXECUTE_HANDLER) {
+    return false;
+  }
+}
+
+Local<v8::Object> LatencySummaryObject(Local<v8::Context> context, const LatencyHistogram& histogram, double scale) {
+  Isolate* isolate = context->GetIsolate();
+  LatencyHistogram::Summary summary = histogram.Summarize();
+
+  Local<v8::Object> result = v8::Object::New(isolate);
+  auto set = [&](const char* name, double value) {
+    result->Set(context, OneByteString(isolate, name), v8::Number::New(isolate, value)).Check();
+  };
+  set("count", static_cast<double>(summary.count));
+  set("min", static_cast<double>(summary.min) * scale);
+  set("max", static_cast<double>(summary.max) * scale);
+  set("mean", summary.mean * scale);
+  set("p50", static_cast<double>(summary.p50) * scale);
+  set("p90", static_cast<double>(summary.p90) * scale);
+  set("p99", static_cast<double>(summary.p99) * scale);
+  set("p999", static_cast<double>(summary.p999) * scale);
+  return result;
+}
+
 template <typename T>
 static void MakeUtf8String(Isolate* isolate, Local<Value> value, MaybeStackBuffer<T>* target) {
   Local<String> string;
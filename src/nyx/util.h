@@ -73,6 +73,16 @@ void Assert(const AssertionInfo& info);
 
 FILE* GetStderr();
 
+// memcpy that reports an access violation on either side by returning false instead of crashing.
+bool SafeMemcpy(void* dest, const void* src, size_t size);
+
+class LatencyHistogram;
+
+// {count, min, max, mean, p50, p90, p99, p999} of histogram, every value multiplied by scale.
+v8::Local<v8::Object> LatencySummaryObject(v8::Local<v8::Context> context,
+                                           const LatencyHistogram& histogram,
+                                           double scale);
+
 static inline void ReportException(v8::Isolate* isolate, v8::TryCatch* try_catch) {
   v8::Local<v8::Value> exception = try_catch->Exception();
   v8::String::Utf8Value exception_str(isolate, exception);
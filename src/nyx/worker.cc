@@ -0,0 +1,545 @@
+#include "nyx/worker.h"
+
+#include <libplatform/libplatform.h>
+
+#include <atomic>
+#include <cstring>
+
+#include "nyx/env.h"
+#include "nyx/errors.h"
+#include "nyx/external_references.h"
+#include "nyx/heap.h"
+#include "nyx/nyx.h"
+#include "nyx/nyx_binding.h"
+#include "nyx/realm.h"
+#include "nyx/snapshot.h"
+
+namespace nyx {
+
+using v8::Array;
+using v8::ArrayBuffer;
+using v8::BackingStore;
+using v8::Boolean;
+using v8::Context;
+using v8::Exception;
+using v8::Function;
+using v8::FunctionCallbackInfo;
+using v8::FunctionTemplate;
+using v8::HandleScope;
+using v8::Integer;
+using v8::Isolate;
+using v8::Just;
+using v8::Local;
+using v8::Maybe;
+using v8::MaybeLocal;
+using v8::Nothing;
+using v8::Object;
+using v8::ObjectTemplate;
+using v8::SharedArrayBuffer;
+using v8::String;
+using v8::Value;
+using v8::ValueDeserializer;
+using v8::ValueSerializer;
+
+namespace {
+
+// V8's own limit sits below 1 MiB on 64-bit targets, well inside this.
+constexpr size_t kStackSize = 4 * 1024 * 1024;
+
+std::atomic<uint32_t> next_thread_id{1};
+
+class SerializerDelegate : public ValueSerializer::Delegate {
+ public:
+  SerializerDelegate(Isolate* isolate, std::vector<std::shared_ptr<BackingStore>>* shared_array_buffers)
+      : isolate_(isolate), shared_array_buffers_(shared_array_buffers) {}
+
+  void ThrowDataCloneError(Local<String> message) override { isolate_->ThrowException(Exception::Error(message)); }
+
+  Maybe<uint32_t> GetSharedArrayBufferId(Isolate* isolate, Local<SharedArrayBuffer> buffer) override {
+    for (uint32_t i = 0; i < seen_.size(); i++) {
+      if (seen_[i] == buffer) {
+        return Just(i);
+      }
+    }
+    seen_.push_back(buffer);
+    shared_array_buffers_->push_back(buffer->GetBackingStore());
+    return Just(static_cast<uint32_t>(seen_.size() - 1));
+  }
+
+ private:
+  Isolate* isolate_;
+  std::vector<std::shared_ptr<BackingStore>>* shared_array_buffers_;
+  std::vector<Local<SharedArrayBuffer>> seen_;
+};
+
+class DeserializerDelegate : public ValueDeserializer::Delegate {
+ public:
+  explicit DeserializerDelegate(const std::vector<std::shared_ptr<BackingStore>>& shared_array_buffers)
+      : shared_array_buffers_(shared_array_buffers) {}
+
+  MaybeLocal<SharedArrayBuffer> GetSharedArrayBufferFromId(Isolate* isolate, uint32_t clone_id) override {
+    if (clone_id >= shared_array_buffers_.size()) {
+      THROW_ERR_INVALID_STATE(isolate, "unknown SharedArrayBuffer in message");
+      return MaybeLocal<SharedArrayBuffer>();
+    }
+    return SharedArrayBuffer::New(isolate, shared_array_buffers_[clone_id]);
+  }
+
+ private:
+  const std::vector<std::shared_ptr<BackingStore>>& shared_array_buffers_;
+};
+
+}  // namespace
+
+bool WorkerMessage::Serialize(Local<Context> context, Local<Value> value, Local<Value> transfer_list) {
+  Isolate* isolate = context->GetIsolate();
+
+  std::vector<Local<ArrayBuffer>> transfers;
+  if (!transfer_list->IsNullOrUndefined()) {
+    if (!transfer_list->IsArray()) {
+      THROW_ERR_INVALID_ARG_TYPE(isolate, "transfer list must be an array");
+      return false;
+    }
+    Local<Array> list = transfer_list.As<Array>();
+    for (uint32_t i = 0; i < list->Length(); i++) {
+      Local<Value> entry;
+      if (!list->Get(context, i).ToLocal(&entry)) {
+        return false;
+      }
+      if (!entry->IsArrayBuffer()) {
+        THROW_ERR_INVALID_ARG_TYPE(isolate, "transfer list entries must be ArrayBuffers");
+        return false;
+      }
+      Local<ArrayBuffer> buffer = entry.As<ArrayBuffer>();
+      if (!buffer->IsDetachable() || buffer->WasDetached()) {
+        THROW_ERR_INVALID_ARG_VALUE(isolate, "ArrayBuffer cannot be transferred");
+        return false;
+      }
+      for (const Local<ArrayBuffer>& seen : transfers) {
+        if (seen == buffer) {
+          THROW_ERR_INVALID_ARG_VALUE(isolate, "ArrayBuffer appears in the transfer list more than once");
+          return false;
+        }
+      }
+      transfers.push_back(buffer);
+    }
+  }
+
+  SerializerDelegate delegate(isolate, &shared_array_buffers_);
+  ValueSerializer serializer(isolate, &delegate);
+  serializer.WriteHeader();
+  for (uint32_t i = 0; i < transfers.size(); i++) {
+    serializer.TransferArrayBuffer(i, transfers[i]);
+  }
+  if (serializer.WriteValue(context, value).IsNothing()) {
+    return false;
+  }
+
+  // The receiving isolate takes over the memory; the sender is left with empty buffers.
+  for (const Local<ArrayBuffer>& buffer : transfers) {
+    array_buffers_.push_back(buffer->GetBackingStore());
+    if (buffer->Detach(Local<Value>()).IsNothing()) {
+      return false;
+    }
+  }
+
+  std::pair<uint8_t*, size_t> data = serializer.Release();
+  data_.assign(data.first, data.first + data.second);
+  delegate.FreeBufferMemory(data.first);
+  return true;
+}
+
+MaybeLocal<Value> WorkerMessage::Deserialize(Local<Context> context) {
+  Isolate* isolate = context->GetIsolate();
+
+  DeserializerDelegate delegate(shared_array_buffers_);
+  ValueDeserializer deserializer(isolate, data_.data(), data_.size(), &delegate);
+  for (uint32_t i = 0; i < array_buffers_.size(); i++) {
+    deserializer.TransferArrayBuffer(i, ArrayBuffer::New(isolate, array_buffers_[i]));
+  }
+  if (deserializer.ReadHeader(context).IsNothing()) {
+    return MaybeLocal<Value>();
+  }
+  return deserializer.ReadValue(context);
+}
+
+void Worker::CreatePerIsolateProperties(IsolateData* isolate_data, Local<ObjectTemplate> target) {
+  Isolate* isolate = isolate_data->isolate();
+
+  Local<FunctionTemplate> tmpl = FunctionTemplate::New(isolate, New);
+  tmpl->InstanceTemplate()->SetInternalFieldCount(kInternalFieldCount);
+  tmpl->SetClassName(OneByteString(isolate, "Worker"));
+
+  SetProtoMethod(isolate, tmpl, "start", Start);
+  SetProtoMethod(isolate, tmpl, "postMessage", PostMessage);
+  SetProtoMethod(isolate, tmpl, "terminate", Terminate);
+
+  target->Set(OneByteString(isolate, "Worker"), tmpl);
+
+  SetMethod(isolate, target, "postMessageToParent", PostMessageToParent);
+  SetMethod(isolate, target, "setMessageHandler", SetMessageHandler);
+  SetMethod(isolate, target, "close", Close);
+}
+
+void Worker::CreatePerContextProperties(Local<Object> target, Local<Context> context) {
+  Isolate* isolate = context->GetIsolate();
+  Worker* worker = Environment::GetCurrent(context)->worker();
+
+  target->Set(context, FixedOneByteString(isolate, "isMainThread"), Boolean::New(isolate, worker == nullptr))
+      .Check();
+  target
+      ->Set(context,
+            FixedOneByteString(isolate, "threadId"),
+            Integer::NewFromUnsigned(isolate, worker ? worker->thread_id() : 0))
+      .Check();
+  if (worker) {
+    target->Set(context, FixedOneByteString(isolate, "filename"), OneByteString(isolate, worker->filename())).Check();
+  }
+}
+
+void Worker::RegisterExternalReferences(ExternalReferenceRegistry* registry) {
+  registry->Register(New);
+  registry->Register(Start);
+  registry->Register(PostMessage);
+  registry->Register(Terminate);
+  registry->Register(PostMessageToParent);
+  registry->Register(SetMessageHandler);
+  registry->Register(Close);
+}
+
+bool Worker::IsBindingAllowed(const char* name) {
+  static constexpr const char* kAllowed[] = {
+      "builtins",
+      "console",
+      "fs",
+      "heap",
+      "memory",
+      "module_wrap",
+      "process",
+      "profiler",
+      "timers",
+      "watchdog",
+      "worker",
+  };
+  for (const char* allowed : kAllowed) {
+    if (strcmp(name, allowed) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+Worker::Worker(Realm* realm, Local<Object> object, std::string filename)
+    : BaseObject(realm, object),
+      filename_(std::move(filename)),
+      scripts_root_(realm->env()->scripts_root()),
+      thread_id_(next_thread_id.fetch_add(1, std::memory_order_relaxed)),
+      parent_immediates_(realm->env()->threadsafe_immediates()) {
+  // Kept alive by the parent environment while its thread runs.
+  MakeWeak();
+}
+
+Worker::~Worker() {
+  TerminateAndJoin();
+}
+
+void Worker::New(const FunctionCallbackInfo<Value>& args) {
+  Realm* realm = Realm::GetCurrent(args);
+  Isolate* isolate = realm->isolate();
+
+  if (!args.IsConstructCall()) {
+    THROW_ERR_CONSTRUCT_CALL_REQUIRED(isolate, "Worker");
+    return;
+  }
+  if (!args[0]->IsString()) {
+    THROW_ERR_INVALID_ARG_TYPE(isolate, "filename must be a string");
+    return;
+  }
+
+  Utf8Value filename(isolate, args[0]);
+  new Worker(realm, args.This(), filename.ToString());
+}
+
+void Worker::Start(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  Worker* worker;
+  ASSIGN_OR_RETURN_UNWRAP(&worker, args.This());
+
+  if (worker->thread_started_) {
+    THROW_ERR_INVALID_STATE(isolate, "worker already started");
+    return;
+  }
+
+  uv_thread_options_t options;
+  options.flags = UV_THREAD_HAS_STACK_SIZE;
+  options.stack_size = kStackSize;
+  int err = uv_thread_create_ex(&worker->thread_, &options, ThreadMain, worker);
+  if (err != 0) {
+    THROW_ERR_OPERATION_FAILED(isolate, uv_strerror(err));
+    return;
+  }
+  worker->thread_started_ = true;
+  worker->ClearWeak();
+  env->AddWorker(worker);
+}
+
+void Worker::PostMessage(const FunctionCallbackInfo<Value>& args) {
+  Isolate* isolate = args.GetIsolate();
+  Worker* worker;
+  ASSIGN_OR_RETURN_UNWRAP(&worker, args.This());
+
+  auto message = std::make_shared<WorkerMessage>();
+  if (!message->Serialize(isolate->GetCurrentContext(), args[0], args[1])) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(worker->mutex_);
+  if (worker->stop_requested_) {
+    return;
+  }
+  if (worker->worker_immediates_) {
+    worker->PostToWorker(std::move(message));
+  } else {
+    worker->pending_.push_back(std::move(message));
+  }
+}
+
+void Worker::Terminate(const FunctionCallbackInfo<Value>& args) {
+  Worker* worker;
+  ASSIGN_OR_RETURN_UNWRAP(&worker, args.This());
+  worker->RequestStop();
+}
+
+void Worker::PostMessageToParent(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  Worker* worker = env->worker();
+  if (worker == nullptr) {
+    THROW_ERR_INVALID_STATE(isolate, "not running in a worker");
+    return;
+  }
+
+  auto message = std::make_shared<WorkerMessage>();
+  if (!message->Serialize(env->context(), args[0], args[1])) {
+    return;
+  }
+  // Runs before OnExit, which is posted after this thread's last message.
+  worker->parent_immediates_->Post([worker, message](Environment*) { worker->DeliverToParent(message.get()); });
+}
+
+void Worker::SetMessageHandler(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  Worker* worker = env->worker();
+  if (worker == nullptr) {
+    THROW_ERR_INVALID_STATE(isolate, "not running in a worker");
+    return;
+  }
+
+  if (args[0]->IsFunction()) {
+    worker->message_handler_.Reset(isolate, args[0].As<Function>());
+  } else {
+    worker->message_handler_.Reset();
+  }
+}
+
+void Worker::Close(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Worker* worker = env->worker();
+  if (worker == nullptr) {
+    THROW_ERR_INVALID_STATE(env->isolate(), "not running in a worker");
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(worker->mutex_);
+    worker->stop_requested_ = true;
+    worker->pending_.clear();
+  }
+  env->Stop();
+  CloseAllHandles(env->event_loop());
+}
+
+void Worker::ThreadMain(void* arg) {
+  static_cast<Worker*>(arg)->Run();
+}
+
+void Worker::Run() {
+  uv_loop_t event_loop;
+  int uv_err = uv_loop_init(&event_loop);
+  if (uv_err != 0) {
+    fprintf(GetStderr(), "Failed to initialize worker event loop: %s\n", uv_strerror(uv_err));
+    parent_immediates_->Post([this](Environment*) { OnExit(); });
+    return;
+  }
+
+  Isolate::CreateParams create_params;
+  // Shared so that backing stores transferred to another isolate outlive this one.
+  create_params.array_buffer_allocator_shared =
+      std::shared_ptr<ArrayBuffer::Allocator>(ArrayBuffer::Allocator::NewDefaultAllocator());
+  const v8::StartupData* snapshot = SnapshotBuilder::GetUsableSnapshotData();
+  if (snapshot) {
+    create_params.snapshot_blob = snapshot;
+    create_params.external_references = ExternalReferenceRegistry::Get().external_references();
+  }
+  if (GetHeapLimit() > 0) {
+    create_params.constraints.ConfigureDefaultsFromHeapSize(0, GetHeapLimit());
+  }
+  Isolate* isolate = Isolate::New(create_params);
+  auto heap_limit_handler = std::make_unique<NearHeapLimitHandler>(isolate, [this]() { RequestStop(); });
+  IsolateData* isolate_data = new IsolateData(isolate, &event_loop, snapshot != nullptr);
+
+  {
+    Isolate::Scope isolate_scope(isolate);
+    HandleScope handle_scope(isolate);
+
+    Environment env(isolate_data, isolate, scripts_root_, nullptr, nullptr, this);
+
+    bool stop;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      worker_isolate_ = isolate;
+      worker_immediates_ = env.threadsafe_immediates();
+      for (auto& message : pending_) {
+        PostToWorker(std::move(message));
+      }
+      pending_.clear();
+      stop = stop_requested_;
+    }
+
+    if (!stop) {
+      env.principal_realm()->ExecuteBootstrapper("internal/main/worker_thread");
+      SpinEventLoop(&env);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_requested_ = true;
+      worker_isolate_ = nullptr;
+      worker_immediates_.reset();
+      pending_.clear();
+    }
+
+    message_handler_.Reset();
+    {
+      Context::Scope context_scope(env.context());
+      isolate->PerformMicrotaskCheckpoint();
+    }
+    env.Stop();
+    CloseEventLoop(&event_loop);
+  }
+
+  heap_limit_handler.reset();
+  delete isolate_data;
+  isolate->Dispose();
+  uv_loop_close(&event_loop);
+
+  parent_immediates_->Post([this](Environment*) { OnExit(); });
+}
+
+void Worker::SpinEventLoop(Environment* env) {
+  Isolate* isolate = env->isolate();
+  HandleScope scope(isolate);
+  Context::Scope context_scope(env->context());
+
+  // No frames to build here: just callbacks and the platform tasks V8 posts for this isolate.
+  bool more = true;
+  while (more) {
+    isolate->PerformMicrotaskCheckpoint();
+    more = uv_run(env->event_loop(), UV_RUN_ONCE) != 0;
+    while (v8::platform::PumpMessageLoop(GetPlatform(), isolate)) {
+    }
+  }
+}
+
+void Worker::RequestStop() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (stop_requested_) {
+    return;
+  }
+  stop_requested_ = true;
+  pending_.clear();
+  if (worker_isolate_) {
+    worker_isolate_->TerminateExecution();
+  }
+  if (worker_immediates_) {
+    worker_immediates_->Post([](Environment* env) {
+      env->Stop();
+      CloseAllHandles(env->event_loop());
+    });
+  }
+}
+
+void Worker::TerminateAndJoin() {
+  RequestStop();
+  if (thread_started_ && !thread_joined_) {
+    uv_thread_join(&thread_);
+    thread_joined_ = true;
+  }
+}
+
+void Worker::PostToWorker(std::shared_ptr<WorkerMessage> message) {
+  worker_immediates_->Post(
+      [this, message = std::move(message)](Environment* env) { DeliverToWorker(env, message.get()); });
+}
+
+void Worker::DeliverToWorker(Environment* env, WorkerMessage* message) {
+  if (message_handler_.IsEmpty()) {
+    return;
+  }
+
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+  TryCatchScope try_catch(isolate);
+  Local<Value> value;
+  if (!message->Deserialize(context).ToLocal(&value)) {
+    return;
+  }
+  Local<Value> argv[] = {value};
+  message_handler_.Get(isolate)->Call(context, context->Global(), 1, argv);
+}
+
+void Worker::DeliverToParent(WorkerMessage* message) {
+  Isolate* isolate = this->isolate();
+  Local<Context> context = env()->context();
+  Local<Object> obj = object();
+  TryCatchScope try_catch(isolate);
+
+  Local<Value> onmessage;
+  if (!obj->Get(context, env()->onmessage_string()).ToLocal(&onmessage) || !onmessage->IsFunction()) {
+    return;
+  }
+  Local<Value> value;
+  if (!message->Deserialize(context).ToLocal(&value)) {
+    return;
+  }
+  Local<Value> argv[] = {value};
+  onmessage.As<Function>()->Call(context, obj, 1, argv);
+}
+
+void Worker::OnExit() {
+  if (thread_started_ && !thread_joined_) {
+    uv_thread_join(&thread_);
+    thread_joined_ = true;
+  }
+  env()->RemoveWorker(this);
+
+  Isolate* isolate = this->isolate();
+  Local<Context> context = env()->context();
+  Local<Object> obj = object();
+  {
+    TryCatchScope try_catch(isolate);
+    Local<Value> onexit;
+    if (obj->Get(context, env()->onexit_string()).ToLocal(&onexit) && onexit->IsFunction()) {
+      onexit.As<Function>()->Call(context, obj, 0, nullptr);
+    }
+  }
+  MakeWeak();
+}
+
+NYX_BINDING_PER_ISOLATE_INIT(worker, Worker::CreatePerIsolateProperties)
+NYX_BINDING_CONTEXT_AWARE(worker, Worker::CreatePerContextProperties)
+NYX_BINDING_EXTERNAL_REFERENCE(worker, Worker::RegisterExternalReferences)
+
+}  // namespace nyx
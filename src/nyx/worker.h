@@ -0,0 +1,107 @@
+#pragma once
+
+#include "nyx/base_object.h"
+
+#include <uv.h>
+#include <v8.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace nyx {
+
+class Environment;
+class ExternalReferenceRegistry;
+class IsolateData;
+class ThreadsafeImmediateQueue;
+
+// A structured clone of a value for another isolate. ArrayBuffers in the transfer list hand their backing store
+// over and are detached on the sending side; SharedArrayBuffers share theirs.
+class WorkerMessage {
+ public:
+  // Returns false with an exception pending when value cannot be cloned or transferred.
+  bool Serialize(v8::Local<v8::Context> context, v8::Local<v8::Value> value, v8::Local<v8::Value> transfer_list);
+  v8::MaybeLocal<v8::Value> Deserialize(v8::Local<v8::Context> context);
+
+ private:
+  std::vector<uint8_t> data_;
+  std::vector<std::shared_ptr<v8::BackingStore>> array_buffers_;
+  std::vector<std::shared_ptr<v8::BackingStore>> shared_array_buffers_;
+};
+
+// A module running on its own thread with its own isolate, uv loop and Environment, created from JS with
+// `new Worker(filename)`. The Worker object belongs to the parent environment. The worker's environment reaches
+// it through Environment::worker() and only gets the bindings IsBindingAllowed lets through.
+//
+// Like the main environment, a worker runs until it is stopped: by close() from inside or terminate() from the
+// parent, which interrupts running JS with TerminateExecution. Messages to the worker go to its environment's
+// threadsafe immediates, held back until that environment exists; messages from it go to the parent's. The worker
+// reports its exit through the parent's immediates; a parent environment that goes away first terminates and
+// joins its workers itself.
+class Worker : public BaseObject {
+ public:
+  static void CreatePerIsolateProperties(IsolateData* isolate_data, v8::Local<v8::ObjectTemplate> target);
+  static void CreatePerContextProperties(v8::Local<v8::Object> target, v8::Local<v8::Context> context);
+  static void RegisterExternalReferences(ExternalReferenceRegistry* registry);
+
+  // Bindings a worker environment may load: no gui, game lock owner or extensions.
+  static bool IsBindingAllowed(const char* name);
+
+  ~Worker() override;
+
+  const std::string& filename() const { return filename_; }
+  uint32_t thread_id() const { return thread_id_; }
+
+  // Called by the parent environment on teardown.
+  void TerminateAndJoin();
+
+ private:
+  Worker(Realm* realm, v8::Local<v8::Object> object, std::string filename);
+
+  // new Worker(filename)
+  static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Start(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void PostMessage(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Terminate(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  // Inside the worker
+  static void PostMessageToParent(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetMessageHandler(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Close(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+  static void ThreadMain(void* arg);
+  void Run();
+  void SpinEventLoop(Environment* env);
+  void RequestStop();
+  // Requires mutex_ and worker_immediates_.
+  void PostToWorker(std::shared_ptr<WorkerMessage> message);
+
+  // Worker thread
+  void DeliverToWorker(Environment* env, WorkerMessage* message);
+  // Parent thread
+  void DeliverToParent(WorkerMessage* message);
+  void OnExit();
+
+  std::string filename_;
+  std::string scripts_root_;
+  uint32_t thread_id_;
+  uv_thread_t thread_;
+  bool thread_started_ = false;
+  bool thread_joined_ = false;
+  std::shared_ptr<ThreadsafeImmediateQueue> parent_immediates_;
+
+  std::mutex mutex_;
+  // Guarded by mutex_
+  bool stop_requested_ = false;
+  v8::Isolate* worker_isolate_ = nullptr;
+  std::shared_ptr<ThreadsafeImmediateQueue> worker_immediates_;
+  std::vector<std::shared_ptr<WorkerMessage>> pending_;
+
+  // Worker thread only
+  v8::Global<v8::Function> message_handler_;
+};
+
+}  // namespace nyx
@@ -0,0 +1,16 @@
+#include <cstdio>
+
+#include "nyx/code_cache_builder.h"
+#include "nyx/nyx.h"
+
+int main(int argc, char* argv[]) {
+  if (argc != 2) {
+    fprintf(stderr, "Usage: %s <output.cc>\n", argv[0]);
+    return 1;
+  }
+
+  nyx::Initialize();
+  int exit_code = nyx::CodeCacheBuilder::Generate(argv[1]);
+  nyx::Teardown();
+  return exit_code;
+}
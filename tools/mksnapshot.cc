@@ -0,0 +1,16 @@
+#include <cstdio>
+
+#include "nyx/nyx.h"
+#include "nyx/snapshot.h"
+
+int main(int argc, char* argv[]) {
+  if (argc != 2) {
+    fprintf(stderr, "Usage: %s <output.cc>\n", argv[0]);
+    return 1;
+  }
+
+  nyx::Initialize();
+  int exit_code = nyx::SnapshotBuilder::Generate(argv[1]);
+  nyx::Teardown();
+  return exit_code;
+}
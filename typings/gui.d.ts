@@ -670,6 +670,14 @@ declare module 'gui' {
     label: string;
   };
 
+  /**
+   * Flame graph of the profiler's rolling window, turned on for 10 seconds if it is off. Click a function to zoom
+   * in, right-click to zoom out.
+   */
+  export const FlameGraph: new (label?: string, width?: number, height?: number) => Widget & {
+    label: string;
+  };
+
   export const Indent: new (width?: number) => Widget;
   export const Unindent: new (width?: number) => Widget;
   export const Dummy: new (width?: number, height?: number) => Widget;
@@ -689,6 +697,90 @@ declare module 'gui' {
   };
 
   export const fontSize: number;
+
+  /**
+   * Set how often UI frames are built. Event loop iterations between frames run without updating or
+   * rendering widgets.
+   * @param rate Frames per second, 1..1000 (default: 60)
+   * @param rendererPaced Build the next frame only once the renderer has presented the previous one,
+   *   at most rate times per second (default: true)
+   */
+  export function setFrameRate(rate: number, rendererPaced?: boolean): void;
+
+  export interface FrameTimeSummary {
+    count: number;
+    min: number;
+    max: number;
+    mean: number;
+    p50: number;
+    p90: number;
+    p99: number;
+    p999: number;
+  }
+  export interface DrawDataStats {
+    /** Frames handed to the renderer */
+    submitted: number;
+    /** Submitted frames identical to the previous one, neither copied nor uploaded again */
+    unchanged: number;
+    /** unchanged / submitted */
+    skipRatio: number;
+    /** Frames the renderer drew */
+    acquired: number;
+    /** Frames the renderer drew with the same content as its previous one */
+    reacquired: number;
+  }
+  export interface GcStats {
+    enabled: boolean;
+    heapGrowthThreshold: number;
+    collections: number;
+    /** Collections that started while a frame was being built */
+    frameCollections: number;
+    /** Gaps between frames long enough to hand to V8 */
+    idlePeriods: number;
+    /** Microseconds of idle time V8 used */
+    idleTime: number;
+    pressureNotifications: number;
+    /** Microseconds per collection */
+    pause: FrameTimeSummary;
+    /** Microseconds of collection per frame */
+    framePause: FrameTimeSummary;
+  }
+  export interface FrameStats {
+    rate: number;
+    rendererPaced: boolean;
+    frames: number;
+    /** Event loop iterations that ran callbacks without building a frame */
+    idleIterations: number;
+    /** Frames started because the renderer presented the previous one */
+    rendererFrames: number;
+    /** Frames started early because input arrived */
+    inputFrames: number;
+    /** Mouse move, wheel and display size events merged into the previous one before a frame took them */
+    inputCoalesced?: number;
+    /** Input events lost because the queue was full */
+    inputDropped?: number;
+    foreground?: DrawDataStats;
+    background?: DrawDataStats;
+    /** Microseconds spent updating and rendering widgets per frame */
+    build: FrameTimeSummary;
+    /** Microseconds between frame starts */
+    interval: FrameTimeSummary;
+    gc: GcStats;
+  }
+  /**
+   * Frame scheduler statistics since startup or the last reset.
+   * @param reset Clear the statistics after reading them
+   */
+  export function getFrameStats(reset?: boolean): FrameStats;
+
+  /**
+   * Control garbage collection between UI frames. While enabled, the time left before the next frame or
+   * timer is handed to V8 for pending GC work, and a heap that grew by more than heapGrowthThreshold
+   * bytes since the last full collection starts incremental marking there instead of during a frame.
+   * @param enabled (default: true)
+   * @param heapGrowthThreshold Bytes; 0 never signals memory pressure (default: 32 MiB)
+   */
+  export function setIdleGc(enabled?: boolean, heapGrowthThreshold?: number): void;
 }
 
 declare module 'nyx:gui' {
@@ -0,0 +1,41 @@
+declare module 'heap' {
+  /** Sizes in bytes */
+  export interface HeapStatistics {
+    totalHeapSize: number;
+    totalHeapSizeExecutable: number;
+    totalPhysicalSize: number;
+    totalAvailableSize: number;
+    usedHeapSize: number;
+    /** The limit past which the isolate is restarted; see nyx::SetHeapLimit */
+    heapSizeLimit: number;
+    mallocedMemory: number;
+    peakMallocedMemory: number;
+    /** ArrayBuffer backing stores and other memory held outside the heap */
+    externalMemory: number;
+    totalGlobalHandlesSize: number;
+    usedGlobalHandlesSize: number;
+    numberOfNativeContexts: number;
+    /** Contexts that are gone but not yet collected; growing numbers point at a leak across restarts */
+    numberOfDetachedContexts: number;
+  }
+
+  /** Sizes in bytes */
+  export interface HeapSpaceStatistics {
+    spaceName: string;
+    spaceSize: number;
+    spaceUsedSize: number;
+    spaceAvailableSize: number;
+    physicalSpaceSize: number;
+  }
+
+  export function getHeapStatistics(): HeapStatistics;
+
+  export function getHeapSpaceStatistics(): HeapSpaceStatistics[];
+
+  /**
+   * Take a heap snapshot and stream it to a .heapsnapshot file. Blocks until written.
+   * @param path File to write, by default heap-<timestamp>.heapsnapshot
+   * @returns The path written
+   */
+  export function writeHeapSnapshot(path?: string): string;
+}
@@ -1,6 +1,25 @@
 // Ambient declarations for internalBinding() function
 // Provides type-safe access to nyx C++ bindings
 
+type LatencySummary = {
+  count: number;
+  min: number;
+  max: number;
+  mean: number;
+  p50: number;
+  p90: number;
+  p99: number;
+  p999: number;
+};
+
+type DrawDataStats = {
+  submitted: number;
+  unchanged: number;
+  skipRatio: number;
+  acquired: number;
+  reacquired: number;
+};
+
 /**
  * Access nyx memory internal C++ bindings
  */
@@ -9,7 +28,57 @@ declare function internalBinding(module: 'memory'): {
   readMemoryFast(address: bigint, size: number): Uint8Array;
   readMemoryInto(address: bigint, buffer: Uint8Array): void;
   readMemoryIntoIfChanged(address: bigint, buffer: Uint8Array): boolean;
+  readMemoryBatch(
+    addresses: BigUint64Array,
+    layout: Uint32Array,
+    dest: Uint8Array,
+    status?: Uint8Array,
+    unchanged?: Uint8Array
+  ): Uint8Array;
+  readMemoryDiff(address: bigint, buffer: Uint8Array, granularity?: number): Uint32Array;
+  resolvePointerChain(base: bigint, offsets: BigInt64Array): BigUint64Array;
+  walkList(head: bigint, nextOffset: number, maxCount: number, prevOffset?: number): BigUint64Array;
+  walkHashBuckets(
+    buckets: bigint,
+    bucketCount: number,
+    nextOffset: number,
+    maxCount: number,
+    bucketStride?: number
+  ): BigUint64Array;
+  decodeColumns(
+    source: BigUint64Array | bigint,
+    count: number,
+    objectSize: number,
+    layout: Uint32Array,
+    columns: ArrayBufferView[]
+  ): Uint8Array;
+  scan(spec: {
+    type: number;
+    compare: number;
+    value?: number | bigint;
+    epsilon?: number;
+    pattern?: Uint8Array;
+    mask?: Uint8Array;
+    alignment?: number;
+    start?: bigint;
+    end?: bigint;
+    writableOnly?: boolean;
+    maxResults?: number;
+    previous?: BigUint64Array;
+    previousValues?: Uint8Array;
+  }): Promise<{ hits: BigUint64Array; values: Uint8Array; truncated: boolean }>;
   writeMemory(address: bigint, data: Uint8Array): void;
+  clearChecksumCache(): void;
+  configureChecksumCache(capacity: number, maxAge: number): void;
+  getChecksumCacheStats(reset?: boolean): {
+    hits: number;
+    misses: number;
+    evictions: number;
+    size: number;
+    capacity: number;
+    maxAge: number;
+    frame: number;
+  };
   allocateTestMemory(size: number): bigint;
   freeTestMemory(address: bigint): void;
   freeAllTestMemory(): void;
@@ -18,6 +87,38 @@ declare function internalBinding(module: 'memory'): {
   releaseGameLock(): void;
   isGameLockHeld(): boolean;
   isGameLockOpen(): boolean;
+  requestGameLock(callback: (acquired: boolean) => void): number;
+  cancelGameLockRequest(id: number): boolean;
+  setGameLockFrameBudget(microseconds: number): void;
+  getGameLockStats(reset?: boolean):
+    | {
+        windows: number;
+        skippedWindows: number;
+        closedWithWaiters: number;
+        timeouts: number;
+        window: number;
+        frameBudget: number;
+        wait: LatencySummary;
+        timeout: LatencySummary;
+        hold: LatencySummary;
+        utilisation: LatencySummary;
+      }
+    | undefined;
+  registerSnapshotRegion(address: bigint, size: number, chain?: BigInt64Array): number;
+  unregisterSnapshotRegion(id: number): boolean;
+  clearSnapshotRegions(): void;
+  captureSnapshot(): void;
+  pinSnapshot(): number;
+  unpinSnapshot(): void;
+  readSnapshotRegion(id: number, dest: Uint8Array): boolean;
+  getSnapshotStats(): {
+    sequence: number;
+    captures: number;
+    skipped: number;
+    lastCaptureNs: number;
+    regions: number;
+    bytes: number;
+  };
 };
 
 declare function internalBinding(module: 'console'): {
@@ -83,6 +184,76 @@ declare function internalBinding(module: 'timers'): {
 
 declare function internalBinding(module: 'events'): any;
 
+declare function internalBinding(module: 'heap'): {
+  getHeapStatistics(): { [name: string]: number };
+  getHeapSpaceStatistics(): {
+    spaceName: string;
+    spaceSize: number;
+    spaceUsedSize: number;
+    spaceAvailableSize: number;
+    physicalSpaceSize: number;
+  }[];
+  writeHeapSnapshot(path: string): void;
+};
+
+declare function internalBinding(module: 'profiler'): {
+  start(intervalMicroseconds?: number): number;
+  stop(id: number): string;
+  setWindow(seconds: number, intervalMicroseconds?: number): void;
+  getWindow(): {
+    window: number;
+    seconds: number;
+    interval: number;
+    nodes: { name: string; url: string; line: number; parent: number; self: number; total: number }[];
+  };
+};
+
+declare function internalBinding(module: 'trace'): {
+  getFrames(count?: number): {
+    index: number;
+    start: number;
+    duration: number;
+    phases: { [phase: string]: number };
+  }[];
+  writeTrace(path: string): void;
+};
+
+declare function internalBinding(module: 'watchdog'): {
+  registerPackage(name: string): number;
+  runInPackage<T>(id: number, fn: () => T): T;
+  setBudgets(callbackMicroseconds: number, frameMicroseconds: number): void;
+  getPackageStats(reset?: boolean): {
+    callbackBudget: number;
+    frameBudget: number;
+    packages: {
+      name: string;
+      callbacks: number;
+      total: number;
+      frame: number;
+      maxCallback: number;
+      stopped: boolean;
+    }[];
+  };
+};
+
+declare function internalBinding(module: 'worker'): {
+  Worker: {
+    new (filename: string): {
+      start(): void;
+      postMessage(value: any, transferList?: ArrayBuffer[]): void;
+      terminate(): void;
+      onmessage?: (value: any) => void;
+      onexit?: () => void;
+    };
+  };
+  isMainThread: boolean;
+  threadId: number;
+  filename?: string;
+  postMessageToParent(value: any, transferList?: ArrayBuffer[]): void;
+  setMessageHandler(handler: ((value: any) => void) | undefined): void;
+  close(): void;
+};
+
 declare function internalBinding(module: 'gui'): {
   Panel: any;
   Text: any;
@@ -138,6 +309,33 @@ declare function internalBinding(module: 'gui'): {
   Unindent: any;
   Dummy: any;
 
+  setFrameRate(rate: number, rendererPaced: boolean): void;
+  getFrameStats(reset?: boolean): {
+    rate: number;
+    rendererPaced: boolean;
+    frames: number;
+    idleIterations: number;
+    rendererFrames: number;
+    inputFrames: number;
+    inputCoalesced?: number;
+    inputDropped?: number;
+    foreground?: DrawDataStats;
+    background?: DrawDataStats;
+    build: LatencySummary;
+    interval: LatencySummary;
+    gc: {
+      enabled: boolean;
+      heapGrowthThreshold: number;
+      collections: number;
+      frameCollections: number;
+      idlePeriods: number;
+      idleTime: number;
+      pressureNotifications: number;
+      pause: LatencySummary;
+      framePause: LatencySummary;
+    };
+  };
+  setIdleGc(enabled: boolean, heapGrowthThreshold: number): void;
   io: {
     displaySize: { x: number; y: number };
     displayFramebufferScale: { x: number; y: number };
@@ -174,4 +372,9 @@ declare function internalBinding(module: 'gui'): {
 };
 
 declare function internalBinding(module: 'module_wrap'): any;
-declare function internalBinding(module: 'builtins'): any;
+declare function internalBinding(module: 'builtins'): {
+  builtinIds: string[];
+  compileFunction(id: string): Function;
+  setInternalLoaders(internalBinding: Function, requireBuiltin: Function, addBuiltinIds: (ids: string[]) => void): void;
+  getCodeCacheStats(): { hits: number; rejected: number; missing: number };
+};
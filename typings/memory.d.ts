@@ -49,6 +49,17 @@ declare module 'memory' {
     $load?(address: bigint | number, count: number): void;
   }
 
+  // Result of decodeColumns: one typed array per requested field
+  export type ColumnSet = {
+    [fieldName: string]: Int8Array | Uint8Array | Int16Array | Uint16Array | Int32Array | Uint32Array |
+      Float32Array | Float64Array | BigInt64Array | BigUint64Array | number;
+  } & {
+    /** Number of decoded objects */
+    $count: number;
+    /** Bit i is clear if object i could not be read (its columns hold zero) */
+    $status: Uint8Array;
+  };
+
   // MemoryModel options
   export interface MemoryModelOptions {
     packed?: boolean;
@@ -85,7 +96,12 @@ declare module 'memory' {
      * Create a reusable cursor with preallocated buffer
      */
     createCursor<T = any>(maxCount: number): Cursor<T> & {
-      $load(address: bigint | number, count: number): void;
+      /** Reload the buffer; returns true if any element changed since the previous load */
+      $load(address: bigint | number, count: number): boolean | undefined;
+      /** Whether element index changed in the last $load */
+      $isChanged(index: number): boolean;
+      /** Indices of the elements that changed in the last $load */
+      $changedIndices(): number[];
     };
 
     /**
@@ -93,6 +109,33 @@ declare module 'memory' {
      */
     readArray<T = any>(address: bigint | number, count: number): Cursor<T>[];
 
+    /**
+     * Read objects at arbitrary addresses with one batched read (null where the read faulted)
+     */
+    readNodes<T = any>(addresses: BigUint64Array | Array<bigint | number>): Array<Cursor<T> | null>;
+
+    /**
+     * Walk a linked list of this model natively and read every node
+     * @param head Address of the first node
+     * @param options next/prev link fields (name or byte offset) and node limit (default 4096)
+     */
+    readList<T = any>(
+      head: bigint | number,
+      options: { next: string | number; prev?: string | number; max?: number }
+    ): Array<Cursor<T> | null>;
+
+    /**
+     * Decode scalar fields of many objects into one typed array per field.
+     * @param source Address list, or { address, count } for a contiguous array
+     * @param fieldNames Scalar fields to decode
+     * @param out Previous result whose columns are reused when large enough
+     */
+    decodeColumns(
+      source: BigUint64Array | Array<bigint | number> | { address: bigint | number; count: number },
+      fieldNames: string[],
+      out?: ColumnSet
+    ): ColumnSet;
+
     /**
      * Initialize snapshot object with zero values
      */
@@ -134,8 +177,161 @@ declare module 'memory' {
   export function readMemoryFast(address: bigint | number, size: number): Uint8Array;
   export function readMemoryInto(address: bigint | number, buffer: Uint8Array): void;
   export function readMemoryIntoIfChanged(address: bigint | number, buffer: Uint8Array): boolean;
+
+  /**
+   * Read many regions in one native call.
+   * @param addresses Source address of each entry
+   * @param layout One (size, destOffset) pair per entry
+   * @param dest Destination buffer every entry is copied into
+   * @param status Optional bitmap to reuse (at least ceil(n / 8) bytes)
+   * @param unchanged Optional bitmap (at least ceil(n / 8) bytes). When given, entries are checked against the
+   *   checksum cache like readMemoryIfChanged and bit i is set if entry i matched its last read
+   * @returns Bitmap where bit i is set if entry i was read; failed entries are zero-filled
+   */
+  export function readMemoryBatch(
+    addresses: BigUint64Array,
+    layout: Uint32Array,
+    dest: Uint8Array,
+    status?: Uint8Array,
+    unchanged?: Uint8Array
+  ): Uint8Array;
+  /**
+   * Re-read a region into buffer, which holds the previous copy, comparing it in fixed-size chunks.
+   * Only changed chunks are copied in.
+   * @param granularity Chunk size in bytes, power of two between 16 and 65536 (default 64)
+   * @returns Merged [start, end) byte ranges that changed; empty when nothing moved
+   */
+  export function readMemoryDiff(address: bigint | number, buffer: Uint8Array, granularity?: number): Uint32Array;
   export function writeMemory(address: bigint | number, data: Uint8Array): void;
 
+  // Native pointer walkers
+  /**
+   * Follow [base + o0], [[base + o0] + o1], ... and return the pointer read at every hop.
+   * The result is shorter than offsets if a hop faults, is implausible or revisits an address.
+   */
+  export function resolvePointerChain(
+    base: bigint | number,
+    offsets: Array<number | bigint> | BigInt64Array
+  ): BigUint64Array;
+
+  /**
+   * Walk a singly (or, with prev, doubly) linked list. Stops at null, on cycles,
+   * unreadable nodes and broken back links.
+   */
+  export function walkList(
+    head: bigint | number,
+    options: { next: number; prev?: number; max?: number }
+  ): BigUint64Array;
+
+  /**
+   * Walk every chain of an open-hash bucket array; nodes are reported once.
+   * @param options stride is the distance between bucket heads in bytes (8..4096, default 8)
+   */
+  export function walkHashBuckets(
+    buckets: bigint | number,
+    bucketCount: number,
+    options: { next: number; max?: number; stride?: number }
+  ): BigUint64Array;
+
+  /**
+   * Decode scalar fields of many objects of a model into per-field typed arrays
+   */
+  export function decodeColumns(
+    model: MemoryModel,
+    addresses: BigUint64Array | Array<bigint | number> | { address: bigint | number; count: number },
+    fieldNames: string[]
+  ): ColumnSet;
+
+  // Checksum cache behind readMemoryIfChanged / readMemoryIntoIfChanged (one per environment)
+  export interface ChecksumCacheStats {
+    /** Lookups that found a live entry */
+    hits: number;
+    /** Lookups that found no entry or one older than maxAge */
+    misses: number;
+    /** Entries dropped for age or replaced because their probe window was full */
+    evictions: number;
+    size: number;
+    capacity: number;
+    maxAge: number;
+    frame: number;
+  }
+  export function clearChecksumCache(): void;
+  /**
+   * Resize the cache and drop every entry.
+   * @param options.capacity Slot count, rounded up to a power of two (default 32768)
+   * @param options.maxAge Frames an entry may go untouched before it is dropped (default 300)
+   */
+  export function configureChecksumCache(options?: { capacity?: number; maxAge?: number }): void;
+  /**
+   * @param reset Zero the hit/miss/eviction counters after reading them
+   */
+  export function getChecksumCacheStats(reset?: boolean): ChecksumCacheStats;
+
+  // Value / pattern scanner
+  export interface ScanSpec {
+    type: 'int32' | 'float' | 'pointer' | 'pattern';
+    /** Value for int32, float and pointer scans (required unless narrowing with a compare) */
+    value?: number | bigint;
+    /** 'AA ?? BB' or bytes with null wildcards */
+    pattern?: string | Array<number | null>;
+    /** Next-scan filter against spec.previous (default 'equal') */
+    compare?: 'equal' | 'changed' | 'unchanged' | 'increased' | 'decreased';
+    /** Tolerance for float compares (default 0.0001) */
+    epsilon?: number;
+    /** Hit alignment in bytes (default: value size, 1 for patterns) */
+    alignment?: number;
+    start?: bigint | number;
+    end?: bigint | number;
+    /** Skip read-only and code pages */
+    writableOnly?: boolean;
+    maxResults?: number;
+    /** Result of an earlier scan() to narrow */
+    previous?: BigUint64Array;
+  }
+  /**
+   * Search committed, readable memory on the libuv threadpool.
+   * @returns Hit addresses in ascending order
+   */
+  export function scan(spec: ScanSpec): Promise<BigUint64Array>;
+  /**
+   * @param hits Array returned by scan()
+   * @returns Bytes matched at each hit and whether maxResults cut the result short
+   */
+  export function getScanInfo(hits: BigUint64Array): { values: Uint8Array; truncated: boolean } | undefined;
+
+  // Game-thread snapshots
+  /** Region the game thread copies at the start of every game lock window; reads never take the lock */
+  export class SnapshotRegion {
+    readonly id: number;
+    readonly size: number;
+    /** Default destination for read() */
+    readonly buffer: Uint8Array;
+    /** Copy the captured bytes into dest; null if the region was not captured */
+    read(dest?: Uint8Array): Uint8Array | null;
+    dispose(): void;
+  }
+  /**
+   * @param options.chain Re-resolve the address on every capture as [[address] + chain[0]] + chain[1] ...
+   */
+  export function registerSnapshotRegion(
+    address: bigint | number,
+    size: number,
+    options?: { chain?: Array<number | bigint> }
+  ): SnapshotRegion;
+  /** Run fn with the newest snapshot pinned so all reads inside see the same frame */
+  export function withSnapshot<T>(fn: (sequence: number) => T): T;
+  export function clearSnapshotRegions(): void;
+  /** Capture on the script thread; only valid when there is no game lock */
+  export function captureSnapshot(): void;
+  export function getSnapshotStats(): {
+    sequence: number;
+    captures: number;
+    skipped: number;
+    lastCaptureNs: number;
+    regions: number;
+    bytes: number;
+  };
+
   // Test memory allocation functions
   export function allocateTestMemory(size: number): bigint;
   export function freeTestMemory(address: bigint): void;
@@ -167,6 +363,50 @@ declare module 'memory' {
    */
   export function isGameLockOpen(): boolean;
 
+  /**
+   * Cap how long one game lock window may stay open. Windows follow recent demand up to this budget
+   * and are skipped on frames where nobody waits for the lock.
+   * @param microseconds Budget per game frame (default: 2000)
+   */
+  export function setGameLockFrameBudget(microseconds: number): void;
+
+  export interface LatencySummary {
+    count: number;
+    min: number;
+    max: number;
+    mean: number;
+    p50: number;
+    p90: number;
+    p99: number;
+    p999: number;
+  }
+  export interface GameLockStats {
+    /** Windows opened for at least one waiter */
+    windows: number;
+    /** Frames where nobody waited, so no window was opened */
+    skippedWindows: number;
+    /** Windows that reached their deadline with an acquire still pending */
+    closedWithWaiters: number;
+    timeouts: number;
+    /** Current adaptive window length in microseconds */
+    window: number;
+    frameBudget: number;
+    /** Microseconds spent in acquireGameLock by calls that got the lock */
+    wait: LatencySummary;
+    /** Microseconds spent in acquireGameLock by calls that timed out */
+    timeout: LatencySummary;
+    /** Microseconds between acquire and release */
+    hold: LatencySummary;
+    /** Fraction (0..1) of each opened window spent with the lock held */
+    utilisation: LatencySummary;
+  }
+  /**
+   * Game lock contention metrics since startup or the last reset.
+   * @param reset Clear the metrics after reading them
+   * @returns undefined when running without a game lock
+   */
+  export function getGameLockStats(reset?: boolean): GameLockStats | undefined;
+
   /**
    * Execute a function while holding the game lock.
    * Ensures the lock is released even if an error occurs.
@@ -185,6 +425,28 @@ declare module 'memory' {
    * @returns Return value of fn, or undefined if lock not acquired
    */
   export function tryWithGameLock<T>(fn: () => T, timeout?: number): T | undefined;
+
+  /**
+   * Acquire the game lock without blocking the event loop. Release with releaseGameLock().
+   * @param timeout Give up after this many milliseconds (default: 100)
+   * @returns True once the lock is held by this thread, false on timeout
+   */
+  export function gameLock(timeout?: number): Promise<boolean>;
+
+  /**
+   * Execute an async function while holding the game lock, acquired without blocking the event loop.
+   * The lock is released after budget milliseconds even if fn is still running; check lease.held
+   * before touching game memory after an await.
+   * @param fn Async function receiving the lease
+   * @param timeout Timeout in milliseconds to acquire lock (default: 100)
+   * @param budget Longest time the lock is held, in milliseconds (default: 5)
+   * @throws Error if lock cannot be acquired, or if fn throws
+   */
+  export function withGameLockAsync<T>(
+    fn: (lease: { readonly held: boolean }) => T | Promise<T>,
+    timeout?: number,
+    budget?: number
+  ): Promise<T>;
 }
 
 // Support nyx: prefix
@@ -0,0 +1,59 @@
+declare module 'profiler' {
+  /** A CPU profile being recorded. Several can record at once, each at its own interval. */
+  export class Profile {
+    /** Stop recording and return the profile as .cpuprofile JSON */
+    stop(): string;
+
+    /**
+     * Stop recording and write the profile to a .cpuprofile file
+     * @param path File to write
+     */
+    save(path: string): Promise<void>;
+  }
+
+  export interface ProfileOptions {
+    /** Sampling interval in microseconds, a multiple of 100. Default 1000. */
+    interval?: number;
+  }
+
+  /**
+   * Start recording a CPU profile
+   * @param options Sampling options
+   */
+  export function start(options?: ProfileOptions): Profile;
+
+  export interface WindowOptions {
+    /** Sampling interval in microseconds, a multiple of 100. Default 10000. */
+    interval?: number;
+  }
+
+  /**
+   * Keep the call tree of the last seconds for getWindow() and the FlameGraph widget. Cheap enough to leave on.
+   * @param seconds Length of the window, at most 300; 0 turns it off
+   * @param options Sampling options
+   */
+  export function setWindow(seconds: number, options?: WindowOptions): void;
+
+  export interface WindowNode {
+    name: string;
+    url: string;
+    line: number;
+    /** Index of the parent node; parents come before their children and node 0 is the root */
+    parent: number;
+    /** Microseconds sampled in this function itself */
+    self: number;
+    /** Microseconds sampled in this function and its callees */
+    total: number;
+  }
+
+  /** The call tree merged over the window. Time spent idle in the event loop is left out. */
+  export function getWindow(): {
+    /** Configured length in seconds */
+    window: number;
+    /** Seconds covered so far */
+    seconds: number;
+    /** Sampling interval in microseconds */
+    interval: number;
+    nodes: WindowNode[];
+  };
+}
@@ -0,0 +1,40 @@
+declare module 'trace' {
+  /**
+   * Microseconds spent in each phase of the event loop since the previous frame was built. poll is the part of
+   * uvRun spent waiting for I/O; endFrame is ImGui::Render and submit hands the draw lists to the renderer.
+   */
+  export interface FramePhases {
+    microtasks: number;
+    uvRun: number;
+    poll: number;
+    update: number;
+    render: number;
+    endFrame: number;
+    submit: number;
+    beginFrame: number;
+    idleTasks: number;
+  }
+
+  export interface Frame {
+    index: number;
+    /** Steady clock time the frame build started, in microseconds */
+    start: number;
+    /** Microseconds from the start of the build until the frame was built */
+    duration: number;
+    phases: FramePhases;
+  }
+
+  /**
+   * Get the last frames built, oldest first
+   * @param count How many; by default every frame kept (1024)
+   */
+  export function getFrames(count?: number): Frame[];
+
+  /**
+   * Write the recorded loop phases, frames and game lock windows as Chrome Trace Event JSON, for
+   * chrome://tracing or ui.perfetto.dev
+   * @param path File to write, by default trace-<timestamp>.json
+   * @returns The path written
+   */
+  export function writeTrace(path?: string): string;
+}
@@ -0,0 +1,52 @@
+declare module 'worker' {
+  /**
+   * A module running on its own thread and isolate. Workers only get the memory, timers, console, fs, heap, process and
+   * profiler builtins; gui and the game lock stay on the main thread.
+   */
+  export class Worker {
+    /**
+     * Start a worker
+     * @param filename Module to run, relative to the scripts root or a package specifier
+     */
+    constructor(filename: string);
+
+    /**
+     * Send a structured clone of value to the worker
+     * @param value Value to clone
+     * @param transferList ArrayBuffers to move instead of copy; they are detached here
+     */
+    postMessage(value: any, transferList?: ArrayBuffer[]): void;
+
+    /** Stop the worker, interrupting any script it is running. 'exit' follows. */
+    terminate(): void;
+
+    on(event: 'message', handler: (value: any) => void): this;
+    on(event: 'exit', handler: () => void): this;
+    off(event: 'message' | 'exit', handler?: (...args: any[]) => void): this;
+  }
+
+  /** The worker's side of the channel to its parent. */
+  export interface ParentPort {
+    /**
+     * Send a structured clone of value to the parent
+     * @param value Value to clone
+     * @param transferList ArrayBuffers to move instead of copy; they are detached here
+     */
+    postMessage(value: any, transferList?: ArrayBuffer[]): void;
+
+    /** Stop this worker once the current callback returns. */
+    close(): void;
+
+    on(event: 'message', handler: (value: any) => void): this;
+    off(event: 'message', handler?: (value: any) => void): this;
+  }
+
+  /** True outside of workers */
+  export const isMainThread: boolean;
+
+  /** 0 on the main thread */
+  export const threadId: number;
+
+  /** Null on the main thread */
+  export const parentPort: ParentPort | null;
+}